@@ -9,8 +9,10 @@
 #define CCC_ALGORITHM_H_
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 
+#include <ccc/memory.h>
 #include <ccc/type_traits.h>
 #include <ccc/iterator.h>
 
@@ -60,6 +62,78 @@ OutputIt move(InputIt First, InputIt Last, OutputIt DestFirst,
     return std::copy(First, Last, DestFirst);
 }
 
+/**
+ * Returns the first position in the sorted range [First, First + Count) whose element is not less
+ * than Key. Unlike std::lower_bound, the loop body compiles to a conditional move instead of a
+ * branch. Less is called as Less(Element, Key).
+ */
+template<class RandomIt, class SizeType, class KeyType, class Compare>
+RandomIt branchless_lower_bound(RandomIt First, SizeType Count, const KeyType& Key, Compare Less)
+{
+    if (0 == Count)
+    {
+        return First;
+    }
+    while (Count > 1)
+    {
+        const SizeType Half = Count / 2;
+        First = Less(First[Half], Key) ? (First + Half) : First;
+        Count = Count - Half;
+    }
+    return First + (Less(*First, Key) ? 1 : 0);
+}
+
+/**
+ * Merges the sorted range [First, Last) into the sorted elements [Dest, Dest + Count), which must be
+ * followed by room for std::distance(First, Last) further elements. The merge runs backwards in a
+ * single pass. Elements of [First, Last) equivalent to an element already in Dest are dropped; of
+ * equivalent elements of [First, Last) the first one is kept, as by inserting them one by one.
+ * Returns the number of elements in Dest afterwards.
+ */
+template<class RandomIt, class SizeType, class BidirectionalIt, class Compare>
+SizeType merge_unique_backward(RandomIt Dest, SizeType Count, BidirectionalIt First, BidirectionalIt Last, Compare Less)
+{
+    const SizeType Total = static_cast<SizeType>(Count + std::distance(First, Last));
+    SizeType Write = Total;
+    bool WrittenFromRange = false; // Dest[Write] came from [First, Last)
+    while ((First != Last) or (0 < Count))
+    {
+        typename std::iterator_traits<RandomIt>::value_type Candidate;
+        bool FromRange = false;
+        if ((First == Last) or ((0 < Count) and Less(*ccc::prev(Last), Dest[Count - 1])))
+        {
+            Count = Count - 1;
+            Candidate = Dest[Count];
+        }
+        else if ((0 == Count) or Less(Dest[Count - 1], *ccc::prev(Last)))
+        {
+            --Last;
+            Candidate = *Last;
+            FromRange = true;
+        }
+        else
+        {
+            // equivalent elements: keep the one already contained
+            Count = Count - 1;
+            --Last;
+            Candidate = Dest[Count];
+        }
+        if ((Total == Write) or Less(Candidate, Dest[Write]))
+        {
+            Write = Write - 1;
+            Dest[Write] = Candidate;
+            WrittenFromRange = FromRange;
+        }
+        else if (FromRange and WrittenFromRange)
+        {
+            // running backwards, a preceding equivalent element of the range replaces the written one
+            Dest[Write] = Candidate;
+        }
+    }
+    std::copy(Dest + Write, Dest + Total, Dest);
+    return Total - Write;
+}
+
 }
 
 #endif /* CCC_ALGORITHM_H_ */
@@ -0,0 +1,133 @@
+/**
+ *
+ * @file This file contains the minimal atomic operations used by the concurrent wrappers of the containers.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_ATOMIC_H_
+#define CCC_ATOMIC_H_
+
+#include <ciso646>
+#include <sched.h>
+#include <stdint.h>
+
+#include <ccc/compat.h>
+
+/*
+ * The functions work on plain integers, so that the containers using them keep a consistent layout
+ * and can be placed in shared memory. All read-modify-write operations and fences are sequentially
+ * consistent.
+ */
+
+#if !defined(__GNUG__)
+#error "ccc/atomic.h requires the __sync builtins of GCC or Clang"
+#endif
+
+namespace ccc
+{
+
+inline void atomic_thread_fence()
+{
+    __sync_synchronize();
+}
+
+/**
+ * Prevents the compiler from moving memory accesses across the call.
+ */
+inline void atomic_signal_fence()
+{
+    __asm__ __volatile__("" ::: "memory");
+}
+
+template <class T>
+T atomic_load(const volatile T& Value)
+{
+    T Result = Value;
+    __sync_synchronize();
+    return Result;
+}
+
+template <class T>
+void atomic_store(volatile T& Value, T Desired)
+{
+    __sync_synchronize();
+    Value = Desired;
+    __sync_synchronize();
+}
+
+template <class T>
+T atomic_fetch_add(volatile T& Value, T Increment)
+{
+    return __sync_fetch_and_add(&Value, Increment);
+}
+
+template <class T>
+T atomic_fetch_sub(volatile T& Value, T Decrement)
+{
+    return __sync_fetch_and_sub(&Value, Decrement);
+}
+
+template <class T>
+bool atomic_compare_exchange(volatile T& Value, T Expected, T Desired)
+{
+    return __sync_bool_compare_and_swap(&Value, Expected, Desired);
+}
+
+/**
+ * Hint for busy-waiting loops.
+ */
+inline void cpu_relax()
+{
+#if (defined CCC_X86) || (defined CCC_X64)
+    __builtin_ia32_pause();
+#else
+    atomic_signal_fence();
+#endif
+}
+
+/**
+ * Busy-waits a few iterations and yields the processor afterwards; Iteration counts the calls of the
+ * current wait. Avoids burning whole time slices when the awaited thread is not running.
+ */
+inline void spin_wait(unsigned int Iteration)
+{
+    if (Iteration < 64)
+    {
+        cpu_relax();
+    }
+    else
+    {
+        sched_yield();
+    }
+}
+
+/**
+ * Acquires a spinlock, which is a plain integer (0 if unlocked), with acquire semantics. Spins on
+ * loads, so waiting threads do not steal the cache line from the owner.
+ */
+inline void spin_lock(volatile uint32_t& Lock)
+{
+    for (unsigned int Iteration = 0; 0 != __sync_lock_test_and_set(&Lock, uint32_t(1)); ++Iteration)
+    {
+        while (0 != Lock)
+        {
+            spin_wait(Iteration++);
+        }
+    }
+}
+
+/**
+ * Releases a spinlock with release semantics, which is cheaper than atomic_store.
+ */
+inline void spin_unlock(volatile uint32_t& Lock)
+{
+    __sync_lock_release(&Lock);
+}
+
+}
+
+#endif /* CCC_ATOMIC_H_ */
@@ -23,6 +23,19 @@
 #define CCC_ALIGNED_AVAILABLE 0
 #define CCC_ALIGNAS_AVAILABLE 0
 #define CCC_ALIGNOF_AVAILABLE 0
+#define CCC_EXTERN_TEMPLATE_AVAILABLE 0
+#define CCC_PREFETCH(Address)
+#define CCC_DETAIL_UNUSED
+
+/*
+ * CCC_STATIC_ASSERT(Condition, Message) fails to compile if the integral constant expression
+ * Condition is false. Message is a string literal, which only compilers supporting static_assert
+ * report. Conditions containing commas have to be parenthesized.
+ */
+#define CCC_DETAIL_JOIN_IMPL(A, B) A##B
+#define CCC_DETAIL_JOIN(A, B) CCC_DETAIL_JOIN_IMPL(A, B)
+#define CCC_STATIC_ASSERT(Condition, Message) \
+    typedef char CCC_DETAIL_JOIN(ccc_static_assert_line_, __LINE__)[(Condition) ? 1 : -1] CCC_DETAIL_UNUSED
 
 /*
  * Compiler-specific definitions:
@@ -33,12 +46,16 @@
 #if defined(__GNUG__) // equivalent to (__GNUC__ && __cplusplus)
 
 #define CCC_ALIGNED(T, Alignment) T __attribute__((aligned(Alignment)))
+#undef CCC_PREFETCH
+#define CCC_PREFETCH(Address) __builtin_prefetch(Address)
+#undef CCC_DETAIL_UNUSED
+#define CCC_DETAIL_UNUSED __attribute__((unused))
 #undef CCC_ALIGNED_AVAILABLE
 #define CCC_ALIGNED_AVAILABLE 1
 #undef CCC_ALIGNOF_AVAILABLE
 #define CCC_ALIGNOF_AVAILABLE 1
 
-#if (__GNUC__ >= 4) && (__GNUC_MINOR__ >= 7) && (__cplusplus >= 201103L)
+#if ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 7))) && (__cplusplus >= 201103L)
 
 #undef CCC_NOEXCEPT
 #define CCC_NOEXCEPT noexcept
@@ -46,6 +63,10 @@
 #define CCC_CONSTEXPR constexpr
 #undef CCC_DEFAULT
 #define CCC_DEFAULT = default;
+#undef CCC_EXTERN_TEMPLATE_AVAILABLE
+#define CCC_EXTERN_TEMPLATE_AVAILABLE 1
+#undef CCC_STATIC_ASSERT
+#define CCC_STATIC_ASSERT(Condition, Message) static_assert(Condition, Message)
 #define CCC_ALIGNOF(type) alignof(type)
 
 #else
@@ -81,8 +102,12 @@
 #define CCC_CONSTEXPR constexpr
 #undef CCC_DEFAULT
 #define CCC_DEFAULT = default;
+#undef CCC_EXTERN_TEMPLATE_AVAILABLE
+#define CCC_EXTERN_TEMPLATE_AVAILABLE 1
 #undef CCC_ALIGNAS_AVAILABLE
 #define CCC_ALIGNAS_AVAILABLE 1
+#undef CCC_STATIC_ASSERT
+#define CCC_STATIC_ASSERT(Condition, Message) static_assert(Condition, Message)
 #define CCC_ALIGNOF(expression) alignof(expression)
 
 #else
@@ -99,4 +124,10 @@
 #define CCC_X64
 #endif
 
+#if ((defined __BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)) || (defined CCC_X86) || (defined CCC_X64)
+#define CCC_LITTLE_ENDIAN 1
+#else
+#define CCC_LITTLE_ENDIAN 0 // unknown or big endian, use the portable code paths
+#endif
+
 #endif /* CCC_COMPAT_H_ */
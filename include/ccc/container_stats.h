@@ -0,0 +1,179 @@
+/**
+ *
+ * @file This file contains the opt-in operation counters and occupancy histograms of the containers with fixed capacity.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_CONTAINER_STATS_H_
+#define CCC_CONTAINER_STATS_H_
+
+/**
+ * Set CCC_CONTAINER_STATS to 1 for the whole program to let PodVector, PodDeque, PodList, PodFlatMap
+ * and PodHashMap (and all containers built on them) record their statistics. With the default 0 the
+ * hooks expand to nothing and this file includes nothing else, so the containers do not depend on
+ * ccc/atomic.h or the streams. Mixing both settings in one program violates the one definition rule.
+ */
+#ifndef CCC_CONTAINER_STATS
+#define CCC_CONTAINER_STATS 0
+#endif
+
+#if CCC_CONTAINER_STATS
+
+#include <ciso646>
+#include <cstddef>
+#include <ostream>
+#include <typeinfo>
+#include <stdint.h>
+
+#include <ccc/atomic.h>
+
+#define CCC_CONTAINER_STATS_RECORD(Operation) ccc::stats::record_container_operation(*this, ccc::stats::Operation)
+#define CCC_CONTAINER_STATS_OVERFLOW() ccc::stats::record_container_overflow(*this)
+
+namespace ccc
+{
+
+namespace stats
+{
+
+enum ContainerOperation
+{
+    ContainerInsert, // push_back, push_front, emplace and insert
+    ContainerErase, // pop_back, pop_front and erase
+    ContainerClear,
+    ContainerAssign,
+    ContainerOperationCount
+};
+
+/**
+ * Occupancy after an operation in tenths of the capacity; the last bucket counts full containers.
+ */
+static const unsigned int OccupancyBucketCount = 11;
+
+/**
+ * @brief Statistics of all objects of one container type.
+ *
+ * Objects of the same type share their statistics, since the question they answer is whether the
+ * Capacity template argument of the type fits. Containers with a capacity chosen at run time share
+ * them as well; m_Capacity is then the largest capacity seen.
+ *
+ * The statistics consist of plain data with static storage duration, so they are zero before any
+ * dynamic initialization. Operations implemented by other operations count those as well (e.g.
+ * PodList::clear() counts an erase per element, assign() a clear), and containers that are built on a
+ * PodVector (PodFlatMap, PodList) also show up with the type of that vector.
+ */
+struct ContainerStats
+{
+    const char* m_Name; // std::type_info::name() of the container (mangled by some compilers)
+    volatile uint64_t m_Capacity;
+    volatile uint64_t m_HighWaterMark; // largest size after an operation
+    volatile uint64_t m_OverflowAttempts; // operations that threw std::bad_alloc
+    volatile uint64_t m_Operations[ContainerOperationCount];
+    volatile uint64_t m_Occupancy[OccupancyBucketCount];
+    ContainerStats* volatile m_Next;
+    volatile uint32_t m_Registered;
+};
+
+/**
+ * Head of the list of all container types that recorded an operation.
+ */
+inline ContainerStats* volatile& container_stats_registry()
+{
+    static ContainerStats* volatile Head = 0;
+    return Head;
+}
+
+template <class Container>
+struct ContainerStatsOf
+{
+    static ContainerStats s_Stats;
+};
+
+template <class Container>
+ContainerStats ContainerStatsOf<Container>::s_Stats;
+
+template <class Container>
+ContainerStats& container_stats()
+{
+    ContainerStats& Stats = ContainerStatsOf<Container>::s_Stats;
+    if ((0 == Stats.m_Registered) and atomic_compare_exchange(Stats.m_Registered, uint32_t(0), uint32_t(1)))
+    {
+        Stats.m_Name = typeid(Container).name();
+        ContainerStats* volatile& Head = container_stats_registry();
+        do
+        {
+            Stats.m_Next = Head;
+        } while (not atomic_compare_exchange(Head, Stats.m_Next, &Stats));
+    }
+    return Stats;
+}
+
+inline void _private_atomic_max(volatile uint64_t& Value, uint64_t Candidate)
+{
+    uint64_t Current = Value;
+    while ((Candidate > Current) and not atomic_compare_exchange(Value, Current, Candidate))
+    {
+        Current = Value;
+    }
+}
+
+template <class Container>
+void record_container_operation(const Container& c, ContainerOperation Operation)
+{
+    ContainerStats& Stats = container_stats<Container>();
+    const uint64_t Size = c.size();
+    const uint64_t Capacity = c.max_size();
+    atomic_fetch_add(Stats.m_Operations[Operation], uint64_t(1));
+    _private_atomic_max(Stats.m_HighWaterMark, Size);
+    _private_atomic_max(Stats.m_Capacity, Capacity);
+    const uint64_t Bucket = (0 == Capacity) ? 0 : (Size * (OccupancyBucketCount - 1)) / Capacity;
+    atomic_fetch_add(Stats.m_Occupancy[(Bucket < OccupancyBucketCount) ? Bucket : OccupancyBucketCount - 1], uint64_t(1));
+}
+
+template <class Container>
+void record_container_overflow(const Container& c)
+{
+    ContainerStats& Stats = container_stats<Container>();
+    atomic_fetch_add(Stats.m_OverflowAttempts, uint64_t(1));
+    _private_atomic_max(Stats.m_Capacity, uint64_t(c.max_size()));
+}
+
+/**
+ * Writes one line per container type that recorded an operation:
+ *
+ * name capacity=C high_water_mark=H overflows=O inserts=I erases=E clears=L assigns=A occupancy=B0,...,B10
+ *
+ * The counters are read without locking, so a dump during concurrent operations is approximate.
+ */
+inline void dump_container_stats(std::ostream& Out)
+{
+    for (const ContainerStats* Stats = container_stats_registry(); 0 != Stats; Stats = Stats->m_Next)
+    {
+        Out << Stats->m_Name << " capacity=" << Stats->m_Capacity << " high_water_mark=" << Stats->m_HighWaterMark
+                << " overflows=" << Stats->m_OverflowAttempts << " inserts=" << Stats->m_Operations[ContainerInsert]
+                << " erases=" << Stats->m_Operations[ContainerErase] << " clears=" << Stats->m_Operations[ContainerClear]
+                << " assigns=" << Stats->m_Operations[ContainerAssign] << " occupancy=";
+        for (unsigned int i = 0; i < OccupancyBucketCount; ++i)
+        {
+            Out << ((0 == i) ? "" : ",") << Stats->m_Occupancy[i];
+        }
+        Out << '\n';
+    }
+}
+
+}
+
+}
+
+#else
+
+#define CCC_CONTAINER_STATS_RECORD(Operation) ((void)0)
+#define CCC_CONTAINER_STATS_OVERFLOW() ((void)0)
+
+#endif
+
+#endif /* CCC_CONTAINER_STATS_H_ */
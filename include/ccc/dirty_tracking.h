@@ -0,0 +1,448 @@
+/**
+ *
+ * @file This file contains the DirtyTracked wrapper, which records modified blocks of a container for incremental replication.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_DIRTY_TRACKING_H_
+#define CCC_DIRTY_TRACKING_H_
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <stdint.h>
+
+#include <ccc/compat.h>
+#include <ccc/serialization.h>
+#include <ccc/fixed_vector.h>
+#include <ccc/layout_traits.h>
+#include <ccc/pod_vector.h>
+#include <ccc/pod_array.h>
+
+/*
+ * A patch consists of a DirtyPatchHeader followed by m_RunCount runs, each a DirtyPatchRun followed by
+ * m_Count elements. Like serialize() (see serialization.h) it uses the native layout of the elements,
+ * so T has to be trivially copyable and the peer has to be built from the same binary.
+ */
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Precedes the runs of a patch.
+ */
+struct DirtyPatchHeader
+{
+    uint64_t m_Size; // size of the container after applying the patch
+    uint64_t m_ValueSize; // sizeof(T) of the writer
+    uint64_t m_RunCount;
+};
+
+/**
+ * @brief Precedes the elements of a run of a patch.
+ */
+struct DirtyPatchRun
+{
+    uint64_t m_First; // index of the first element
+    uint64_t m_Count;
+};
+
+#pragma pack(pop)
+
+/**
+ * @brief Dirty bits of DirtyTracked, Words 64-bit words in place.
+ */
+template <std::size_t Words>
+struct _private_dirty_bitmap
+{
+    uint64_t m_Words[Words];
+
+    explicit _private_dirty_bitmap(std::size_t)
+    {
+        clear();
+    }
+
+    uint64_t& operator[](std::size_t Index)
+    {
+        return m_Words[Index];
+    }
+
+    const uint64_t& operator[](std::size_t Index) const
+    {
+        return m_Words[Index];
+    }
+
+    void clear()
+    {
+        std::memset(m_Words, 0, sizeof(m_Words));
+    }
+};
+
+/**
+ * @brief Dirty bits of DirtyTracked for containers with runtime capacity, allocated at construction.
+ */
+template <>
+struct _private_dirty_bitmap<0>
+{
+    FixedVector<uint64_t, std::size_t> m_Words;
+
+    explicit _private_dirty_bitmap(std::size_t Words)
+            : m_Words(Words)
+    {
+        clear();
+    }
+
+    uint64_t& operator[](std::size_t Index)
+    {
+        return m_Words[Index];
+    }
+
+    const uint64_t& operator[](std::size_t Index) const
+    {
+        return m_Words[Index];
+    }
+
+    void clear()
+    {
+        m_Words.assign(m_Words.max_size(), 0);
+    }
+};
+
+/**
+ * @brief Wraps an index-based container (the PodVector family or PODArray) and records, which blocks
+ * of BlockElements elements were modified since the last patch.
+ *
+ * Writes through the non-const operator[] and set() mark the block of the element. Writes through
+ * pointers or references obtained earlier (e.g. by modify()) have to be reported by mark_dirty().
+ * Modifiers shifting elements (insert, erase) mark all blocks from the position to the end. Shrinking
+ * is transmitted by the size in the patch header.
+ *
+ * make_patch() writes the dirty elements, coalescing adjacent dirty blocks into runs, and clears the
+ * marks; apply_patch() replays such a patch on a copy of the container.
+ *
+ * The dirty bits are stored in place for containers with static storage (see layout_traits) and
+ * allocated for containers with runtime capacity.
+ */
+template <class Container, std::size_t BlockElements = 64>
+class DirtyTracked
+{
+public:
+    typedef Container container_type;
+    typedef typename Container::value_type value_type;
+    typedef typename Container::size_type size_type;
+    typedef typename Container::reference reference;
+    typedef typename Container::const_reference const_reference;
+    typedef typename Container::const_iterator const_iterator;
+
+    static const std::size_t block_elements = BlockElements;
+
+    DirtyTracked()
+            : m_Container(), m_Dirty(Blocks(m_Container.max_size()))
+    {
+    }
+
+    /**
+     * For containers with runtime capacity (e.g. FixedVector).
+     */
+    explicit DirtyTracked(size_type Capacity)
+            : m_Container(Capacity), m_Dirty(Blocks(Capacity))
+    {
+    }
+
+    // Element access:
+
+    const container_type& container() const
+    {
+        return m_Container;
+    }
+
+    /**
+     * Grants unrestricted access; modifications have to be reported by mark_dirty().
+     */
+    container_type& modify()
+    {
+        return m_Container;
+    }
+
+    reference operator[](size_type Index)
+    {
+        mark_dirty(Index);
+        return m_Container[Index];
+    }
+
+    const_reference operator[](size_type Index) const
+    {
+        return m_Container[Index];
+    }
+
+    void set(size_type Index, const value_type& Value)
+    {
+        mark_dirty(Index);
+        m_Container[Index] = Value;
+    }
+
+    const_iterator begin() const
+    {
+        return m_Container.begin();
+    }
+
+    const_iterator end() const
+    {
+        return m_Container.end();
+    }
+
+    // Capacity:
+
+    size_type size() const
+    {
+        return m_Container.size();
+    }
+
+    size_type max_size() const
+    {
+        return m_Container.max_size();
+    }
+
+    bool empty() const
+    {
+        return m_Container.empty();
+    }
+
+    // Modifiers:
+
+    void push_back(const value_type& Value)
+    {
+        m_Container.push_back(Value);
+        mark_dirty(size() - 1);
+    }
+
+    void pop_back()
+    {
+        m_Container.pop_back();
+    }
+
+    void insert(size_type Index, const value_type& Value)
+    {
+        m_Container.insert(m_Container.begin() + Index, Value);
+        mark_dirty(Index, size());
+    }
+
+    void erase(size_type First, size_type Last)
+    {
+        mark_dirty(First, size());
+        m_Container.erase(m_Container.begin() + First, m_Container.begin() + Last);
+    }
+
+    void erase(size_type Index)
+    {
+        erase(Index, Index + 1);
+    }
+
+    void resize(size_type Count)
+    {
+        const size_type OldSize = size();
+        m_Container.resize(Count);
+        if (Count > OldSize)
+        {
+            mark_dirty(OldSize, Count);
+        }
+    }
+
+    void clear()
+    {
+        m_Container.clear();
+    }
+
+    // Dirty tracking:
+
+    void mark_dirty(size_type Index)
+    {
+        const std::size_t Block = Index / BlockElements;
+        m_Dirty[Block / 64] |= uint64_t(1) << (Block % 64);
+    }
+
+    /**
+     * Marks the elements [First, Last).
+     */
+    void mark_dirty(size_type First, size_type Last)
+    {
+        if (First < Last)
+        {
+            for (std::size_t Block = First / BlockElements; Block <= (Last - 1) / BlockElements; ++Block)
+            {
+                m_Dirty[Block / 64] |= uint64_t(1) << (Block % 64);
+            }
+        }
+    }
+
+    bool is_dirty(size_type Index) const
+    {
+        const std::size_t Block = Index / BlockElements;
+        return 0 != (m_Dirty[Block / 64] & (uint64_t(1) << (Block % 64)));
+    }
+
+    void clear_dirty()
+    {
+        m_Dirty.clear();
+    }
+
+    /**
+     * Returns the number of bytes make_patch() will write.
+     */
+    std::size_t patch_size() const
+    {
+        std::size_t Size = sizeof(DirtyPatchHeader);
+        for (std::size_t First = NextRun(0), Last; First < size(); First = NextRun(Last))
+        {
+            Last = RunEnd(First);
+            Size += sizeof(DirtyPatchRun) + (Last - First) * sizeof(value_type);
+        }
+        return Size;
+    }
+
+    /**
+     * Writes the patch to Out, which has to provide patch_size() bytes, clears the marks and returns
+     * the end of the written data.
+     */
+    char* make_patch(char* Out)
+    {
+        char* HeaderPosition = Out;
+        DirtyPatchHeader Header = { size(), sizeof(value_type), 0 };
+        Out += sizeof(Header);
+        for (std::size_t First = NextRun(0), Last; First < size(); First = NextRun(Last))
+        {
+            Last = RunEnd(First);
+            DirtyPatchRun Run = { First, Last - First };
+            Out = _private_serialize_bytes(Out, &Run, sizeof(Run));
+            Out = _private_serialize_bytes(Out, ccc::addressof(m_Container[static_cast<size_type>(First)]),
+                    (Last - First) * sizeof(value_type));
+            ++Header.m_RunCount;
+        }
+        std::memcpy(HeaderPosition, &Header, sizeof(Header));
+        clear_dirty();
+        return Out;
+    }
+
+private:
+    // words of the bitmap of a container with static storage, 0 for runtime capacity
+    static const std::size_t StaticWords = layout_traits<Container>::static_storage
+            ? ((layout_traits<Container>::capacity + BlockElements - 1) / BlockElements + 63) / 64 : 0;
+
+    static std::size_t Blocks(std::size_t Capacity)
+    {
+        return ((Capacity + BlockElements - 1) / BlockElements + 63) / 64;
+    }
+
+    bool IsDirtyBlock(std::size_t Block) const
+    {
+        return 0 != (m_Dirty[Block / 64] & (uint64_t(1) << (Block % 64)));
+    }
+
+    // Returns the first element of the first dirty block starting at or after Index, or size().
+    std::size_t NextRun(std::size_t Index) const
+    {
+        for (std::size_t Block = (Index + BlockElements - 1) / BlockElements; Block * BlockElements < size(); ++Block)
+        {
+            if (0 == m_Dirty[Block / 64] >> (Block % 64))
+            {
+                Block |= 63; // skip the clean rest of the word
+            }
+            else if (IsDirtyBlock(Block))
+            {
+                return Block * BlockElements;
+            }
+        }
+        return size();
+    }
+
+    // Returns the end of the run of dirty blocks starting at First, clipped to size().
+    std::size_t RunEnd(std::size_t First) const
+    {
+        std::size_t Block = First / BlockElements;
+        while (((Block + 1) * BlockElements < size()) and IsDirtyBlock(Block + 1))
+        {
+            ++Block;
+        }
+        const std::size_t Last = (Block + 1) * BlockElements;
+        return (Last < size()) ? Last : size();
+    }
+
+    container_type m_Container;
+    _private_dirty_bitmap<StaticWords> m_Dirty; // one bit per block
+};
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+void _private_resize_for_patch(PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Vector, uint64_t Size)
+{
+    if (Size > Vector.max_size())
+    {
+        throw std::bad_alloc();
+    }
+    Vector.resize(static_cast<SizeType>(Size));
+}
+
+template <class T, class SizeType, SizeType Capacity, std::size_t Alignment, bool UseRawMemOps, bool StaticStorage>
+void _private_resize_for_patch(PODArray<T, SizeType, Capacity, Alignment, UseRawMemOps, StaticStorage>& Array, uint64_t Size)
+{
+    if (Size != Array.size())
+    {
+        throw std::runtime_error("ccc::apply_patch: array size mismatch");
+    }
+}
+
+/**
+ * Applies the patch in [In, End) written by DirtyTracked::make_patch() to Container, which has to hold
+ * the state of the tracked container at the previous patch, and returns the end of the consumed data.
+ * Throws std::runtime_error on truncated or invalid patches and std::bad_alloc if the container would
+ * exceed its capacity. Container may be modified even if an exception is thrown.
+ */
+template <class Container>
+const char* apply_patch(Container& Target, const char* In, const char* End)
+{
+    typedef typename Container::value_type value_type;
+    DirtyPatchHeader Header;
+    if (static_cast<std::size_t>(End - In) < sizeof(Header))
+    {
+        throw std::runtime_error("ccc::apply_patch: truncated header");
+    }
+    std::memcpy(&Header, In, sizeof(Header));
+    In += sizeof(Header);
+    if (Header.m_ValueSize != sizeof(value_type))
+    {
+        throw std::runtime_error("ccc::apply_patch: value size mismatch");
+    }
+    _private_resize_for_patch(Target, Header.m_Size);
+    for (uint64_t i = 0; i < Header.m_RunCount; ++i)
+    {
+        DirtyPatchRun Run;
+        if (static_cast<std::size_t>(End - In) < sizeof(Run))
+        {
+            throw std::runtime_error("ccc::apply_patch: truncated run");
+        }
+        std::memcpy(&Run, In, sizeof(Run));
+        In += sizeof(Run);
+        if ((Run.m_First > Header.m_Size) or (Run.m_Count > Header.m_Size - Run.m_First)
+                or (static_cast<std::size_t>(End - In) / sizeof(value_type) < Run.m_Count))
+        {
+            throw std::runtime_error("ccc::apply_patch: invalid run");
+        }
+        if (Run.m_Count > 0)
+        {
+            std::memcpy(ccc::addressof(Target[static_cast<typename Container::size_type>(Run.m_First)]), In,
+                    static_cast<std::size_t>(Run.m_Count) * sizeof(value_type));
+        }
+        In += Run.m_Count * sizeof(value_type);
+    }
+    return In;
+}
+
+}
+
+#endif /* CCC_DIRTY_TRACKING_H_ */
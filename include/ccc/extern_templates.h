@@ -0,0 +1,125 @@
+/**
+ *
+ * @file This file contains macros for explicit instantiations of the containers with a capacity set at construction, and
+ * explicit instantiations of common configurations.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_EXTERN_TEMPLATES_H_
+#define CCC_EXTERN_TEMPLATES_H_
+
+#include <stdint.h>
+
+#include <ccc/compat.h>
+#include <ccc/fixed_deque.h>
+#include <ccc/fixed_flat_map.h>
+#include <ccc/fixed_hash_map.h>
+#include <ccc/fixed_list.h>
+#include <ccc/fixed_vector.h>
+
+/*
+ * A Fixed container has one type per element type (and size type), independent of its capacity, so
+ * a program usually needs few of them, and each translation unit instantiates them again. With
+ * CCC_DECLARE_FIXED_VECTOR(T, SizeType) (and the other CCC_DECLARE_ macros) a translation unit
+ * declares the instantiation of the container and its bases extern, and a single translation unit
+ * provides it with CCC_DEFINE_FIXED_VECTOR(T, SizeType). Both have to appear at namespace scope
+ * before the first use of the container. Arguments containing commas need a typedef.
+ *
+ * The declarations save the instantiation of members that are not inlined, which is most of them
+ * in unoptimized builds; optimizing compilers still instantiate the members they inline. Without
+ * extern templates (before C++11) the CCC_DECLARE_ macros declare nothing but a typedef, which keeps
+ * the semicolon following them valid at namespace scope.
+ *
+ * An explicit instantiation definition instantiates all members, so the element type has to
+ * support every operation of the container (e.g. operator== for the comparison operators).
+ */
+
+#define CCC_DETAIL_FIXED_VECTOR_TEMPLATES(Template, T, SizeType) \
+    Template struct ccc::PodVector<T, SizeType, 0, 8, false, false, true>; \
+    Template struct ccc::ConsistentVector<T, SizeType, 0, 8, false, false, true>; \
+    Template class ccc::FixedVector<T, SizeType, 8, false>
+
+#define CCC_DETAIL_FIXED_DEQUE_TEMPLATES(Template, T, SizeType) \
+    Template struct ccc::PodDeque<T, SizeType, 0, 8, false, false, true>; \
+    Template struct ccc::ConsistentDeque<T, SizeType, 0, 8, false, false, true>; \
+    Template class ccc::FixedDeque<T, SizeType, 8, false>
+
+#define CCC_DETAIL_FIXED_LIST_TEMPLATES(Template, T, SizeType) \
+    Template struct ccc::PodList<T, SizeType, 0, 8, false, true>; \
+    Template class ccc::ConsistentList<T, SizeType, 0, 8, false, true>; \
+    Template class ccc::FixedList<T, SizeType, 8>
+
+#define CCC_DETAIL_FIXED_FLAT_MAP_TEMPLATES(Template, Key, T, SizeType) \
+    Template struct ccc::PodFlatMap<Key, T, SizeType, 0, std::less<Key>, 8, false, true>; \
+    Template class ccc::FixedFlatMap<Key, T, SizeType, std::less<Key>, 8, false>
+
+#define CCC_DETAIL_FIXED_HASH_MAP_TEMPLATES(Template, Key, T, SizeType) \
+    Template struct ccc::PodHashMap<Key, T, SizeType, 0, ccc::pod_hash<Key>, std::equal_to<Key>, 8, true>; \
+    Template class ccc::FixedHashMap<Key, T, SizeType, ccc::pod_hash<Key>, std::equal_to<Key>, 8>
+
+#if CCC_EXTERN_TEMPLATE_AVAILABLE
+#define CCC_DECLARE_FIXED_VECTOR(T, SizeType) CCC_DETAIL_FIXED_VECTOR_TEMPLATES(extern template, T, SizeType)
+#define CCC_DECLARE_FIXED_DEQUE(T, SizeType) CCC_DETAIL_FIXED_DEQUE_TEMPLATES(extern template, T, SizeType)
+#define CCC_DECLARE_FIXED_LIST(T, SizeType) CCC_DETAIL_FIXED_LIST_TEMPLATES(extern template, T, SizeType)
+#define CCC_DECLARE_FIXED_FLAT_MAP(Key, T, SizeType) CCC_DETAIL_FIXED_FLAT_MAP_TEMPLATES(extern template, Key, T, SizeType)
+#define CCC_DECLARE_FIXED_HASH_MAP(Key, T, SizeType) CCC_DETAIL_FIXED_HASH_MAP_TEMPLATES(extern template, Key, T, SizeType)
+#else
+#define CCC_DECLARE_FIXED_VECTOR(T, SizeType) typedef void ccc_detail_no_extern_template
+#define CCC_DECLARE_FIXED_DEQUE(T, SizeType) typedef void ccc_detail_no_extern_template
+#define CCC_DECLARE_FIXED_LIST(T, SizeType) typedef void ccc_detail_no_extern_template
+#define CCC_DECLARE_FIXED_FLAT_MAP(Key, T, SizeType) typedef void ccc_detail_no_extern_template
+#define CCC_DECLARE_FIXED_HASH_MAP(Key, T, SizeType) typedef void ccc_detail_no_extern_template
+#endif
+
+#define CCC_DEFINE_FIXED_VECTOR(T, SizeType) CCC_DETAIL_FIXED_VECTOR_TEMPLATES(template, T, SizeType)
+#define CCC_DEFINE_FIXED_DEQUE(T, SizeType) CCC_DETAIL_FIXED_DEQUE_TEMPLATES(template, T, SizeType)
+#define CCC_DEFINE_FIXED_LIST(T, SizeType) CCC_DETAIL_FIXED_LIST_TEMPLATES(template, T, SizeType)
+#define CCC_DEFINE_FIXED_FLAT_MAP(Key, T, SizeType) CCC_DETAIL_FIXED_FLAT_MAP_TEMPLATES(template, Key, T, SizeType)
+#define CCC_DEFINE_FIXED_HASH_MAP(Key, T, SizeType) CCC_DETAIL_FIXED_HASH_MAP_TEMPLATES(template, Key, T, SizeType)
+
+/*
+ * Common configurations: the sequence containers of int32_t, uint32_t, int64_t, uint64_t and double
+ * and the maps from uint32_t to uint32_t and from uint64_t to uint64_t, all with the default size
+ * type unsigned int. Define CCC_EXTERN_COMMON_TEMPLATES for all translation units of a program and
+ * CCC_INSTANTIATE_COMMON_TEMPLATES additionally for one of them, which then has to include this
+ * file.
+ */
+
+#if defined(CCC_INSTANTIATE_COMMON_TEMPLATES) || defined(CCC_EXTERN_COMMON_TEMPLATES)
+
+#if defined(CCC_INSTANTIATE_COMMON_TEMPLATES)
+#define CCC_DETAIL_COMMON_SEQUENCES(T) \
+    CCC_DEFINE_FIXED_VECTOR(T, unsigned int); \
+    CCC_DEFINE_FIXED_DEQUE(T, unsigned int); \
+    CCC_DEFINE_FIXED_LIST(T, unsigned int)
+#define CCC_DETAIL_COMMON_MAPS(Key, T) \
+    CCC_DEFINE_FIXED_FLAT_MAP(Key, T, unsigned int); \
+    CCC_DEFINE_FIXED_HASH_MAP(Key, T, unsigned int)
+#else
+#define CCC_DETAIL_COMMON_SEQUENCES(T) \
+    CCC_DECLARE_FIXED_VECTOR(T, unsigned int); \
+    CCC_DECLARE_FIXED_DEQUE(T, unsigned int); \
+    CCC_DECLARE_FIXED_LIST(T, unsigned int)
+#define CCC_DETAIL_COMMON_MAPS(Key, T) \
+    CCC_DECLARE_FIXED_FLAT_MAP(Key, T, unsigned int); \
+    CCC_DECLARE_FIXED_HASH_MAP(Key, T, unsigned int)
+#endif
+
+CCC_DETAIL_COMMON_SEQUENCES(int32_t);
+CCC_DETAIL_COMMON_SEQUENCES(uint32_t);
+CCC_DETAIL_COMMON_SEQUENCES(int64_t);
+CCC_DETAIL_COMMON_SEQUENCES(uint64_t);
+CCC_DETAIL_COMMON_SEQUENCES(double);
+CCC_DETAIL_COMMON_MAPS(uint32_t, uint32_t);
+CCC_DETAIL_COMMON_MAPS(uint64_t, uint64_t);
+
+#undef CCC_DETAIL_COMMON_SEQUENCES
+#undef CCC_DETAIL_COMMON_MAPS
+
+#endif
+
+#endif /* CCC_EXTERN_TEMPLATES_H_ */
@@ -0,0 +1,145 @@
+/**
+ *
+ * @file This file contains the PodEytzingerLayout search index.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_EYTZINGER_LAYOUT_H_
+#define CCC_EYTZINGER_LAYOUT_H_
+
+#include <ciso646>
+#include <cstddef>
+
+#include <ccc/compat.h>
+#include <ccc/memory.h>
+#include <ccc/alignment.h>
+#include <ccc/storage.h>
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Copy of sorted keys in Eytzinger (breadth-first) order.
+ *
+ * The node k has its children at 2k and 2k + 1 (the root is at index 1), so the nodes a search
+ * visits next are close to each other and can be prefetched several levels in advance. Each node
+ * additionally stores the position of its key in the sorted range it was built from.
+ *
+ * The layout is a snapshot: it has to be rebuilt after the sorted range was modified.
+ */
+template <class KeyType, class SizeType, SizeType Capacity, unsigned int Alignment = 8, bool Runtime = false>
+struct PodEytzingerLayout
+{
+    typedef KeyType key_type;
+    typedef SizeType size_type;
+
+    typedef typename Storage<key_type, size_type, Capacity + 1, Alignment, false, Runtime>::type keys_storage_type;
+    typedef typename Storage<size_type, size_type, Capacity + 1, Alignment, false, Runtime>::type indices_storage_type;
+
+#if (CCC_ALIGNAS_AVAILABLE)
+    alignas(Alignment) size_type m_Valid;
+    alignas(Alignment) size_type m_Size;
+#elif CCC_ALIGNED_AVAILABLE
+    typename ccc::Aligned<size_type, Alignment>::type m_Valid;
+    typename ccc::Aligned<size_type, Alignment>::type m_Size;
+#else
+    PaddedValue<size_type, Alignment> m_Valid;
+    PaddedValue<size_type, Alignment> m_Size;
+#endif
+    keys_storage_type m_Keys; // index 0 is unused
+    indices_storage_type m_Indices; // position of m_Keys[k] in the sorted range
+
+    bool valid() const CCC_NOEXCEPT
+    {
+        return 0 != m_Valid;
+    }
+
+    void invalidate() CCC_NOEXCEPT
+    {
+        m_Valid = 0;
+    }
+
+    /**
+     * Builds the layout from the sorted range [Sorted, Sorted + Count), using KeyOf to extract the
+     * key of an element.
+     */
+    template <class RandomIt, class KeyOfValue>
+    void build(RandomIt Sorted, size_type Count, KeyOfValue KeyOf)
+    {
+        m_Size = Count;
+        _private_build(Sorted, 0, 1, KeyOf);
+        m_Valid = 1;
+    }
+
+    /**
+     * Returns the position of the first key not less than Key within the sorted range the layout
+     * was built from, or the size of that range if there is none.
+     */
+    template <class Compare>
+    size_type lower_bound(const key_type& Key, Compare Less) const
+    {
+        const key_type* Keys = ccc::addressof(m_Keys[0]);
+        std::size_t k = 1;
+        while (k <= m_Size)
+        {
+            CCC_PREFETCH(Keys + 16 * k); // the descendants four levels below
+            k = 2 * k + (Less(Keys[k], Key) ? 1 : 0);
+        }
+        // Each bit of k records whether the search went right. The lower bound is the node where it
+        // went left for the last time, so strip the trailing ones and the zero preceding them.
+        k >>= _private_trailing_ones(k) + 1;
+        return (0 == k) ? static_cast<size_type>(m_Size) : m_Indices[k];
+    }
+
+    void swap(PodEytzingerLayout& Other)
+    {
+        using std::swap;
+        this->m_Keys.swap(Other.m_Keys);
+        this->m_Indices.swap(Other.m_Indices);
+        swap(this->m_Valid, Other.m_Valid);
+        swap(this->m_Size, Other.m_Size);
+    }
+
+    // Private methods:
+
+    template <class RandomIt, class KeyOfValue>
+    std::size_t _private_build(RandomIt Sorted, std::size_t i, std::size_t k, KeyOfValue KeyOf)
+    {
+        // in-order traversal of the implicit tree assigns the sorted keys in ascending order
+        if (k <= m_Size)
+        {
+            i = _private_build(Sorted, i, 2 * k, KeyOf);
+            m_Keys[k] = KeyOf(Sorted[i]);
+            m_Indices[k] = static_cast<size_type>(i);
+            ++i;
+            i = _private_build(Sorted, i, 2 * k + 1, KeyOf);
+        }
+        return i;
+    }
+
+    static unsigned int _private_trailing_ones(std::size_t Value)
+    {
+#if defined(__GNUG__)
+        return static_cast<unsigned int>(__builtin_ctzll(~static_cast<unsigned long long>(Value)));
+#else
+        unsigned int Count = 0;
+        for (; Value & 1; Value >>= 1)
+        {
+            ++Count;
+        }
+        return Count;
+#endif
+    }
+};
+
+#pragma pack(pop)
+
+}
+
+#endif /* CCC_EYTZINGER_LAYOUT_H_ */
@@ -45,7 +45,7 @@ struct FixedArray
     value_type* m_Array; // allow to change pointer to swap
     size_type m_Capacity; // allow to change size to swap
 
-    FixedArray(size_type Capacity) : m_Capacity(Capacity), m_Array(0)
+    FixedArray(size_type Capacity) : m_Array(0), m_Capacity(Capacity)
     {
         if (Capacity > 0) // allow zero-size arrays
         {
@@ -0,0 +1,65 @@
+/**
+ *
+ * @file This file contains the FixedFlatMap container.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_FIXED_FLAT_MAP_H_
+#define CCC_FIXED_FLAT_MAP_H_
+
+#include <functional>
+
+#include <ccc/pod_flat_map.h>
+
+namespace ccc
+{
+
+template <typename KeyType, typename T, typename SizeType = unsigned int, class Compare = std::less<KeyType>, unsigned int Alignment = 8,
+        bool EytzingerLayout = false>
+class FixedFlatMap : public PodFlatMap<KeyType, T, SizeType, 0, Compare, Alignment, EytzingerLayout, true>
+{
+public:
+    explicit FixedFlatMap(SizeType Capacity)
+    {
+        Allocate(Capacity);
+    }
+
+    FixedFlatMap(FixedFlatMap const& Other)
+    {
+        Allocate(Other.max_size());
+        this->m_Values.assign(Other.m_Values.begin(), Other.m_Values.end());
+    }
+
+    void operator=(FixedFlatMap const& Other)
+    {
+        if (this->max_size() != Other.max_size())
+        {
+            FixedFlatMap Tmp(Other.max_size());
+            this->swap(Tmp);
+        }
+        this->m_Values.assign(Other.m_Values.begin(), Other.m_Values.end());
+        this->m_Layout.invalidate();
+    }
+
+private:
+    void Allocate(SizeType Capacity)
+    {
+        this->m_Values.m_End = 0;
+        this->m_Values.m_Storage.allocate(Capacity);
+        this->m_Layout.m_Valid = 0;
+        this->m_Layout.m_Size = 0;
+        if (EytzingerLayout)
+        {
+            this->m_Layout.m_Keys.allocate(Capacity + 1);
+            this->m_Layout.m_Indices.allocate(Capacity + 1);
+        }
+    }
+};
+
+}
+
+#endif /* CCC_FIXED_FLAT_MAP_H_ */
@@ -0,0 +1,65 @@
+/**
+ *
+ * @file This file contains the FixedFlatSet container.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_FIXED_FLAT_SET_H_
+#define CCC_FIXED_FLAT_SET_H_
+
+#include <functional>
+
+#include <ccc/pod_flat_set.h>
+
+namespace ccc
+{
+
+template <typename KeyType, typename SizeType = unsigned int, class Compare = std::less<KeyType>, unsigned int Alignment = 8,
+        bool EytzingerLayout = false>
+class FixedFlatSet : public PodFlatSet<KeyType, SizeType, 0, Compare, Alignment, EytzingerLayout, true>
+{
+public:
+    explicit FixedFlatSet(SizeType Capacity)
+    {
+        Allocate(Capacity);
+    }
+
+    FixedFlatSet(FixedFlatSet const& Other)
+    {
+        Allocate(Other.max_size());
+        this->m_Keys.assign(Other.m_Keys.begin(), Other.m_Keys.end());
+    }
+
+    void operator=(FixedFlatSet const& Other)
+    {
+        if (this->max_size() != Other.max_size())
+        {
+            FixedFlatSet Tmp(Other.max_size());
+            this->swap(Tmp);
+        }
+        this->m_Keys.assign(Other.m_Keys.begin(), Other.m_Keys.end());
+        this->m_Layout.invalidate();
+    }
+
+private:
+    void Allocate(SizeType Capacity)
+    {
+        this->m_Keys.m_End = 0;
+        this->m_Keys.m_Storage.allocate(Capacity);
+        this->m_Layout.m_Valid = 0;
+        this->m_Layout.m_Size = 0;
+        if (EytzingerLayout)
+        {
+            this->m_Layout.m_Keys.allocate(Capacity + 1);
+            this->m_Layout.m_Indices.allocate(Capacity + 1);
+        }
+    }
+};
+
+}
+
+#endif /* CCC_FIXED_FLAT_SET_H_ */
@@ -0,0 +1,68 @@
+/**
+ *
+ * @file This file contains the FixedHashMap container.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_FIXED_HASH_MAP_H_
+#define CCC_FIXED_HASH_MAP_H_
+
+#include <algorithm>
+#include <functional>
+
+#include <ccc/pod_hash_map.h>
+
+namespace ccc
+{
+
+template <typename KeyType, typename T, typename SizeType = unsigned int, class Hash = pod_hash<KeyType>,
+        class KeyEqual = std::equal_to<KeyType>, unsigned int Alignment = 8>
+class FixedHashMap : public PodHashMap<KeyType, T, SizeType, 0, Hash, KeyEqual, Alignment, true>
+{
+public:
+    explicit FixedHashMap(SizeType Capacity)
+    {
+        Allocate(Capacity);
+    }
+
+    FixedHashMap(FixedHashMap const& Other)
+    {
+        Allocate(Other.max_size());
+        CopyFrom(Other);
+    }
+
+    void operator=(FixedHashMap const& Other)
+    {
+        if (this->max_size() != Other.max_size())
+        {
+            FixedHashMap Tmp(Other.max_size());
+            this->swap(Tmp);
+        }
+        CopyFrom(Other);
+    }
+
+private:
+    void Allocate(SizeType Capacity)
+    {
+        this->m_Size = 0;
+        this->m_Used.allocate(Capacity);
+        this->m_Buckets.allocate(Capacity);
+        std::fill(&this->m_Used[0], &this->m_Used[0] + Capacity, static_cast<unsigned char>(0));
+    }
+
+    void CopyFrom(FixedHashMap const& Other)
+    {
+        // the capacities are equal, so the elements can stay in their buckets
+        this->m_Size = Other.m_Size;
+        std::copy(&Other.m_Used[0], &Other.m_Used[0] + Other.max_size(), &this->m_Used[0]);
+        std::copy(&Other.m_Buckets[0], &Other.m_Buckets[0] + Other.max_size(), &this->m_Buckets[0]);
+    }
+};
+
+}
+
+#endif /* CCC_FIXED_HASH_MAP_H_ */
@@ -46,7 +46,7 @@ public:
 
     void operator=(FixedList const& Other)
     {
-        if (this->m_Storage.m_Capacity != Other.m_Storage.m_Capacity)
+        if (this->m_Values.m_Capacity != Other.m_Values.m_Capacity)
         {
             FixedList Tmp(Other.m_Values.m_Capacity);
             this->swap(Tmp);
@@ -0,0 +1,48 @@
+/**
+ *
+ * @file This file contains the FixedObjectPool.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_FIXED_OBJECT_POOL_H_
+#define CCC_FIXED_OBJECT_POOL_H_
+
+#include <new>
+
+#include <ccc/pod_object_pool.h>
+
+namespace ccc
+{
+
+template <typename T, typename SizeType = unsigned int, unsigned int Alignment = 8>
+class FixedObjectPool : public PodObjectPool<T, SizeType, 0, Alignment, true>
+{
+public:
+    /**
+     * Throws std::bad_alloc if Capacity is not less than 2^32.
+     */
+    explicit FixedObjectPool(SizeType Capacity)
+    {
+        if (static_cast<uint64_t>(Capacity) >= (static_cast<uint64_t>(1) << 32))
+        {
+            throw std::bad_alloc();
+        }
+        this->m_Free = 0;
+        this->m_Unused = 0;
+        this->m_Next.allocate(Capacity);
+        this->m_Values.allocate(Capacity);
+    }
+
+private:
+    // Objects in use are owned by the user of the pool, so it can't be copied.
+    FixedObjectPool(FixedObjectPool const&);
+    void operator=(FixedObjectPool const&);
+};
+
+}
+
+#endif /* CCC_FIXED_OBJECT_POOL_H_ */
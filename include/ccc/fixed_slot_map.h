@@ -0,0 +1,76 @@
+/**
+ *
+ * @file This file contains the FixedSlotMap container.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_FIXED_SLOT_MAP_H_
+#define CCC_FIXED_SLOT_MAP_H_
+
+#include <algorithm>
+
+#include <ccc/pod_slot_map.h>
+
+namespace ccc
+{
+
+template <typename T, typename SizeType = unsigned int, unsigned int Alignment = 8>
+class FixedSlotMap : public PodSlotMap<T, SizeType, 0, Alignment, false, true>
+{
+public:
+    explicit FixedSlotMap(SizeType Capacity)
+    {
+        Allocate(Capacity);
+    }
+
+    FixedSlotMap(FixedSlotMap const& Other)
+    {
+        Allocate(Other.max_size());
+        CopyFrom(Other);
+    }
+
+    ~FixedSlotMap()
+    {
+        this->clear();
+    }
+
+    void operator=(FixedSlotMap const& Other)
+    {
+        if (this->max_size() != Other.max_size())
+        {
+            FixedSlotMap Tmp(Other.max_size());
+            this->swap(Tmp);
+        }
+        CopyFrom(Other);
+    }
+
+private:
+    void Allocate(SizeType Capacity)
+    {
+        this->m_Values.m_End = 0;
+        this->m_Values.m_Storage.allocate(Capacity);
+        this->m_Owners.m_End = 0;
+        this->m_Owners.m_Storage.allocate(Capacity);
+        this->m_Slots.allocate(Capacity);
+        std::fill(&this->m_Slots[0], &this->m_Slots[0] + Capacity, typename FixedSlotMap::slot_type());
+        this->m_Deallocated.m_End = 0;
+        this->m_Deallocated.m_Storage.allocate(Capacity);
+    }
+
+    void CopyFrom(FixedSlotMap const& Other)
+    {
+        // copy the slots as well, so that handles of Other are valid in this container
+        this->m_Values.assign(Other.m_Values.begin(), Other.m_Values.end());
+        this->m_Owners.assign(Other.m_Owners.begin(), Other.m_Owners.end());
+        this->m_Deallocated.assign(Other.m_Deallocated.begin(), Other.m_Deallocated.end());
+        std::copy(&Other.m_Slots[0], &Other.m_Slots[0] + Other.max_size(), &this->m_Slots[0]);
+    }
+};
+
+}
+
+#endif /* CCC_FIXED_SLOT_MAP_H_ */
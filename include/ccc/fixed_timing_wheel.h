@@ -0,0 +1,53 @@
+/**
+ *
+ * @file This file contains the FixedTimingWheel container.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_FIXED_TIMING_WHEEL_H_
+#define CCC_FIXED_TIMING_WHEEL_H_
+
+#include <algorithm>
+
+#include <ccc/pod_timing_wheel.h>
+
+namespace ccc
+{
+
+/**
+ * Timing wheel, whose capacity is set at construction. Copying is not supported, since the handles
+ * of the original would not refer to the copies.
+ */
+template <typename T, typename SizeType = unsigned int, typename TickType = unsigned long, unsigned int SlotBits = 8,
+        unsigned int Levels = 4, unsigned int Alignment = 8>
+class FixedTimingWheel : public PodTimingWheel<T, SizeType, 0, TickType, SlotBits, Levels, Alignment, true>
+{
+    typedef PodTimingWheel<T, SizeType, 0, TickType, SlotBits, Levels, Alignment, true> base_type;
+
+public:
+    explicit FixedTimingWheel(SizeType Capacity, TickType Now = TickType())
+    {
+        this->m_Now = Now;
+        this->m_Size = 0;
+        this->m_Nodes.allocate(Capacity);
+        std::fill(&this->m_Nodes[0], &this->m_Nodes[0] + Capacity, typename base_type::node_type());
+        this->m_Buckets.allocate(base_type::BucketCount);
+        std::fill(&this->m_Buckets[0], &this->m_Buckets[0] + base_type::BucketCount, 0);
+        this->m_LevelSizes.allocate(Levels);
+        std::fill(&this->m_LevelSizes[0], &this->m_LevelSizes[0] + Levels, 0);
+        this->m_Deallocated.m_End = 0;
+        this->m_Deallocated.m_Storage.allocate(Capacity);
+    }
+
+private:
+    FixedTimingWheel(FixedTimingWheel const&);
+    void operator=(FixedTimingWheel const&);
+};
+
+}
+
+#endif /* CCC_FIXED_TIMING_WHEEL_H_ */
@@ -0,0 +1,109 @@
+/**
+ *
+ * @file This file contains the LayoutHeader, which describes a container stored outside the process.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_LAYOUT_HEADER_H_
+#define CCC_LAYOUT_HEADER_H_
+
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <stdint.h>
+
+#include <ccc/compat.h>
+#include <ccc/layout_traits.h>
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Describes the layout of a container placed in shared memory or a file.
+ *
+ * The header is written in front of the container and compared against the layout the reading
+ * process expects before the container is used, so that binaries built with differing compilers,
+ * flags or template arguments do not silently misinterpret each other's data.
+ */
+struct LayoutHeader
+{
+    char m_Magic[8]; // identifies the kind of region
+    uint32_t m_LayoutVersion;
+    uint32_t m_SizeTypeSize;
+    uint64_t m_ContainerSize;
+    uint64_t m_ContainerAlignment;
+    uint64_t m_ValueSize;
+    uint64_t m_ValueAlignment;
+    uint64_t m_Capacity;
+    uint64_t m_PayloadOffset; // offset of the container from the beginning of the header
+    uint64_t m_PayloadSize;
+    uint64_t m_Fingerprint; // layout_traits<Container>::fingerprint
+};
+
+#pragma pack(pop)
+
+/**
+ * Returns the header describing Container. Magic has to consist of at most 8 characters.
+ */
+template <class Container>
+LayoutHeader make_layout_header(const char* Magic, uint64_t Capacity, uint64_t PayloadOffset, uint64_t PayloadSize)
+{
+    LayoutHeader Header;
+    std::memset(&Header, 0, sizeof(Header));
+    std::size_t MagicLength = std::strlen(Magic);
+    std::memcpy(Header.m_Magic, Magic, (MagicLength < sizeof(Header.m_Magic)) ? MagicLength : sizeof(Header.m_Magic));
+    Header.m_LayoutVersion = CCC_LAYOUT_VERSION;
+    Header.m_SizeTypeSize = sizeof(typename Container::size_type);
+    Header.m_ContainerSize = sizeof(Container);
+    Header.m_ContainerAlignment = CCC_ALIGNOF(Container);
+    Header.m_ValueSize = sizeof(typename Container::value_type);
+    Header.m_ValueAlignment = CCC_ALIGNOF(typename Container::value_type);
+    Header.m_Capacity = Capacity;
+    Header.m_PayloadOffset = PayloadOffset;
+    Header.m_PayloadSize = PayloadSize;
+    Header.m_Fingerprint = layout_traits<Container>::fingerprint;
+    return Header;
+}
+
+inline void _private_check_layout_field(const char* Field, uint64_t Found, uint64_t Expected)
+{
+    if (Found != Expected)
+    {
+        std::ostringstream Message;
+        Message << "ccc::LayoutHeader: " << Field << " mismatch (found " << Found << ", expected " << Expected << ")";
+        throw std::runtime_error(Message.str());
+    }
+}
+
+/**
+ * Throws std::runtime_error naming the first field of Found, which differs from the layout of
+ * Container. The capacity and the payload are not checked, since they may vary at runtime.
+ */
+template <class Container>
+void validate_layout_header(const LayoutHeader& Found, const char* Magic)
+{
+    LayoutHeader Expected = make_layout_header<Container>(Magic, 0, 0, 0);
+    if (0 != std::memcmp(Found.m_Magic, Expected.m_Magic, sizeof(Expected.m_Magic)))
+    {
+        throw std::runtime_error("ccc::LayoutHeader: unexpected magic, the region does not contain a " + std::string(Magic));
+    }
+    _private_check_layout_field("layout version", Found.m_LayoutVersion, Expected.m_LayoutVersion);
+    _private_check_layout_field("size_type size", Found.m_SizeTypeSize, Expected.m_SizeTypeSize);
+    _private_check_layout_field("container size", Found.m_ContainerSize, Expected.m_ContainerSize);
+    _private_check_layout_field("container alignment", Found.m_ContainerAlignment, Expected.m_ContainerAlignment);
+    _private_check_layout_field("value size", Found.m_ValueSize, Expected.m_ValueSize);
+    _private_check_layout_field("value alignment", Found.m_ValueAlignment, Expected.m_ValueAlignment);
+    _private_check_layout_field("layout fingerprint", Found.m_Fingerprint, Expected.m_Fingerprint);
+}
+
+}
+
+#endif /* CCC_LAYOUT_HEADER_H_ */
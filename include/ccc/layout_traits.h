@@ -0,0 +1,298 @@
+/**
+ *
+ * @file This file contains the layout_traits, which describe the memory layout of containers at compile time.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_LAYOUT_TRAITS_H_
+#define CCC_LAYOUT_TRAITS_H_
+
+#include <cstddef>
+#include <stdint.h>
+
+#include <ccc/compat.h>
+#include <ccc/pod_array.h>
+#include <ccc/pod_vector.h>
+#include <ccc/pod_deque.h>
+#include <ccc/pod_list.h>
+#include <ccc/consistent_vector.h>
+#include <ccc/consistent_deque.h>
+#include <ccc/consistent_list.h>
+#include <ccc/static_vector.h>
+#include <ccc/static_deque.h>
+#include <ccc/static_list.h>
+#include <ccc/fixed_vector.h>
+#include <ccc/fixed_deque.h>
+#include <ccc/fixed_list.h>
+
+/**
+ * Version of the memory layout of the containers. Has to be incremented whenever a change of the
+ * library alters the layout of an existing container instantiation.
+ */
+#define CCC_LAYOUT_VERSION 2
+
+namespace ccc
+{
+
+/**
+ * @brief Compile-time FNV-1a hash of the 8 bytes of Value (least significant first), continuing Hash.
+ */
+template <uint64_t Hash, uint64_t Value, unsigned int Bytes = 8>
+struct fnv1a_append
+{
+    static const uint64_t value = fnv1a_append<(Hash ^ (Value & 0xFFu)) * 0x100000001B3ull, (Value >> 8), Bytes - 1>::value;
+};
+
+template <uint64_t Hash, uint64_t Value>
+struct fnv1a_append<Hash, Value, 0>
+{
+    static const uint64_t value = Hash;
+};
+
+/**
+ * @brief Describes the memory layout of a container.
+ *
+ * All members are integral constants, so they can be used in static assertions. The fingerprint
+ * hashes the layout version, the sizes and alignments and, for the specialized containers, the
+ * offsets and sizes of all data members. Two binaries can share a container in memory if their
+ * fingerprints are equal.
+ *
+ * static_storage is true if the container keeps all its state inside the object, so that its raw
+ * bytes can be saved to a snapshot or mapped; the primary template assumes it does not.
+ *
+ * The members are only declared, so use them by value (e.g. +layout_traits<C>::fingerprint) when
+ * passing them to functions taking references.
+ *
+ * The primary template describes an arbitrary container by its size and alignment only. It is
+ * specialized (see below) for the vector, deque and list families (Pod, Consistent, Static and
+ * Fixed) and for PODArray. All other containers, including the maps, sets, slot maps, timing
+ * wheels, priority queues, object pools and SmallVector of this library, fall back to the primary
+ * template: their fingerprint does not cover the offsets of their data members, their capacity is
+ * reported as 0 and static_storage is false, so they cannot be snapshotted or mapped (see
+ * snapshot.h) and layout changes that keep their size and alignment go unnoticed.
+ */
+template <class Container>
+struct layout_traits
+{
+    typedef Container container_type;
+
+    static const uint32_t family = 0; // unknown container
+    static const std::size_t size = sizeof(Container);
+    static const std::size_t alignment = CCC_ALIGNOF(Container);
+    static const std::size_t value_size = sizeof(typename Container::value_type);
+    static const std::size_t value_alignment = CCC_ALIGNOF(typename Container::value_type);
+    static const std::size_t size_type_size = sizeof(typename Container::size_type);
+    static const std::size_t capacity = 0; // unknown or chosen at runtime
+    static const bool static_storage = false; // unknown, the container may own memory outside the object
+
+    static const uint64_t basic_fingerprint =
+            fnv1a_append<fnv1a_append<fnv1a_append<fnv1a_append<fnv1a_append<fnv1a_append<fnv1a_append<
+            0xCBF29CE484222325ull, CCC_LAYOUT_VERSION>::value, family>::value, size>::value, alignment>::value,
+            value_size>::value, value_alignment>::value, size_type_size>::value;
+    static const uint64_t fingerprint = basic_fingerprint;
+};
+
+/**
+ * @brief Adds the offset and size of a data member to a fingerprint.
+ */
+template <uint64_t Hash, std::size_t Offset, std::size_t Size>
+struct layout_fingerprint_member
+{
+    static const uint64_t value = fnv1a_append<fnv1a_append<Hash, Offset>::value, Size>::value;
+};
+
+/**
+ * Helper for the specializations: Pod is the POD base of Container, which holds all data members.
+ */
+template <class Container, class Pod, uint32_t Family, std::size_t Capacity>
+struct _private_layout_traits_base
+{
+    typedef Container container_type;
+    typedef Pod pod_type;
+
+    static const uint32_t family = Family;
+    static const std::size_t size = sizeof(Container);
+    static const std::size_t alignment = CCC_ALIGNOF(Container);
+    static const std::size_t value_size = sizeof(typename Container::value_type);
+    static const std::size_t value_alignment = CCC_ALIGNOF(typename Container::value_type);
+    static const std::size_t size_type_size = sizeof(typename Container::size_type);
+    static const std::size_t capacity = Capacity;
+    static const bool static_storage = (0 != Capacity); // a capacity of 0 is chosen at runtime and allocated
+
+    static const uint64_t basic_fingerprint = fnv1a_append<
+            fnv1a_append<fnv1a_append<fnv1a_append<fnv1a_append<fnv1a_append<fnv1a_append<fnv1a_append<
+            0xCBF29CE484222325ull, CCC_LAYOUT_VERSION>::value, family>::value, size>::value, alignment>::value,
+            value_size>::value, value_alignment>::value, size_type_size>::value, capacity>::value;
+};
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+struct _private_vector_layout_traits
+{
+    template <class Container>
+    struct type : _private_layout_traits_base<Container, PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>,
+            1, Capacity>
+    {
+        typedef PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime> pod;
+
+        static const std::size_t end_offset = offsetof(pod, m_End);
+        static const std::size_t storage_offset = offsetof(pod, m_Storage);
+        static const std::size_t storage_size = sizeof(typename pod::storage_type);
+
+        static const uint64_t fingerprint = layout_fingerprint_member<
+                layout_fingerprint_member<type::basic_fingerprint, end_offset, sizeof(SizeType)>::value,
+                storage_offset, storage_size>::value;
+    };
+};
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+struct _private_deque_layout_traits
+{
+    template <class Container>
+    struct type : _private_layout_traits_base<Container, PodDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>,
+            2, Capacity>
+    {
+        typedef PodDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime> pod;
+
+        static const std::size_t begin_offset = offsetof(pod, m_Begin);
+        static const std::size_t end_offset = offsetof(pod, m_End);
+        static const std::size_t storage_offset = offsetof(pod, m_Storage);
+        static const std::size_t storage_size = sizeof(typename pod::storage_type);
+
+        static const uint64_t fingerprint = layout_fingerprint_member<layout_fingerprint_member<
+                layout_fingerprint_member<type::basic_fingerprint, begin_offset, sizeof(SizeType)>::value,
+                end_offset, sizeof(SizeType)>::value, storage_offset, storage_size>::value;
+    };
+};
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool Uninitialized, bool Runtime>
+struct _private_list_layout_traits
+{
+    template <class Container>
+    struct type : _private_layout_traits_base<Container, PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime>,
+            3, Capacity>
+    {
+        typedef PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime> pod;
+
+        static const std::size_t size_offset = offsetof(pod, m_Size);
+        static const std::size_t nodes_offset = offsetof(pod, m_Nodes);
+        static const std::size_t nodes_size = sizeof(typename pod::nodes_storage_type);
+        static const std::size_t node_size = sizeof(typename pod::node_type);
+        static const std::size_t values_offset = offsetof(pod, m_Values);
+        static const std::size_t values_size = sizeof(typename pod::values_storage_type);
+        static const std::size_t deallocated_offset = offsetof(pod, m_Deallocated);
+        static const std::size_t deallocated_size = sizeof(typename pod::deallocated_storage_type);
+
+        static const uint64_t fingerprint = layout_fingerprint_member<layout_fingerprint_member<layout_fingerprint_member<
+                layout_fingerprint_member<layout_fingerprint_member<type::basic_fingerprint, size_offset, sizeof(SizeType)>::value,
+                nodes_offset, nodes_size>::value, values_offset, values_size>::value, deallocated_offset,
+                deallocated_size>::value, 0, node_size>::value;
+    };
+};
+
+template <class T, class SizeType, SizeType Capacity, std::size_t Alignment, bool UseRawMemOps, bool StaticStorage>
+struct layout_traits<PODArray<T, SizeType, Capacity, Alignment, UseRawMemOps, StaticStorage> >
+    : _private_layout_traits_base<PODArray<T, SizeType, Capacity, Alignment, UseRawMemOps, StaticStorage>,
+            PODArray<T, SizeType, Capacity, Alignment, UseRawMemOps, StaticStorage>, 4, Capacity>
+{
+    typedef PODArray<T, SizeType, Capacity, Alignment, UseRawMemOps, StaticStorage> pod;
+
+    static const bool static_storage = StaticStorage;
+    static const std::size_t storage_offset = offsetof(pod, m_Storage);
+    static const std::size_t storage_size = sizeof(typename pod::storage_type);
+
+    static const uint64_t fingerprint = layout_fingerprint_member<layout_traits::basic_fingerprint, storage_offset, storage_size>::value;
+};
+
+// The derived containers add no data members, so they share the layout of their POD base.
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+struct layout_traits<PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime> >
+    : _private_vector_layout_traits<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>::template type<
+            PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime> >
+{
+};
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+struct layout_traits<ConsistentVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime> >
+    : _private_vector_layout_traits<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>::template type<
+            ConsistentVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime> >
+{
+};
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps>
+struct layout_traits<StaticVector<T, SizeType, Capacity, Alignment, UseRawMemOps> >
+    : _private_vector_layout_traits<T, SizeType, Capacity, Alignment, UseRawMemOps, false, false>::template type<
+            StaticVector<T, SizeType, Capacity, Alignment, UseRawMemOps> >
+{
+};
+
+template <class T, class SizeType, unsigned int Alignment, bool UseRawMemOps>
+struct layout_traits<FixedVector<T, SizeType, Alignment, UseRawMemOps> >
+    : _private_vector_layout_traits<T, SizeType, 0, Alignment, UseRawMemOps, false, true>::template type<
+            FixedVector<T, SizeType, Alignment, UseRawMemOps> >
+{
+};
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+struct layout_traits<PodDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime> >
+    : _private_deque_layout_traits<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>::template type<
+            PodDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime> >
+{
+};
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+struct layout_traits<ConsistentDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime> >
+    : _private_deque_layout_traits<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>::template type<
+            ConsistentDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime> >
+{
+};
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps>
+struct layout_traits<StaticDeque<T, SizeType, Capacity, Alignment, UseRawMemOps> >
+    : _private_deque_layout_traits<T, SizeType, Capacity, Alignment, UseRawMemOps, false, false>::template type<
+            StaticDeque<T, SizeType, Capacity, Alignment, UseRawMemOps> >
+{
+};
+
+template <class T, class SizeType, unsigned int Alignment, bool UseRawMemOps>
+struct layout_traits<FixedDeque<T, SizeType, Alignment, UseRawMemOps> >
+    : _private_deque_layout_traits<T, SizeType, 0, Alignment, UseRawMemOps, false, true>::template type<
+            FixedDeque<T, SizeType, Alignment, UseRawMemOps> >
+{
+};
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool Uninitialized, bool Runtime>
+struct layout_traits<PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime> >
+    : _private_list_layout_traits<T, SizeType, Capacity, Alignment, Uninitialized, Runtime>::template type<
+            PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime> >
+{
+};
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool Uninitialized, bool Runtime>
+struct layout_traits<ConsistentList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime> >
+    : _private_list_layout_traits<T, SizeType, Capacity, Alignment, Uninitialized, Runtime>::template type<
+            ConsistentList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime> >
+{
+};
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment>
+struct layout_traits<StaticList<T, SizeType, Capacity, Alignment> >
+    : _private_list_layout_traits<T, SizeType, Capacity, Alignment, false, false>::template type<
+            StaticList<T, SizeType, Capacity, Alignment> >
+{
+};
+
+template <class T, class SizeType, unsigned int Alignment>
+struct layout_traits<FixedList<T, SizeType, Alignment> >
+    : _private_list_layout_traits<T, SizeType, 0, Alignment, false, true>::template type<
+            FixedList<T, SizeType, Alignment> >
+{
+};
+
+}
+
+#endif /* CCC_LAYOUT_TRAITS_H_ */
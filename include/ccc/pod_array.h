@@ -50,8 +50,8 @@ struct PODArray
     typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
     // support zero-sized arrays (see std::array in gcc)
-    typedef typename Storage<T, SizeType, Capacity ? Capacity : 1, Alignment, StaticStorage,
-            true>::type storage_type;
+    typedef typename Storage<T, SizeType, Capacity ? Capacity : 1, Alignment, false,
+            not StaticStorage>::type storage_type;
     storage_type m_Storage;
 
     pointer data() CCC_NOEXCEPT
@@ -76,12 +76,12 @@ struct PODArray
 
     iterator end() CCC_NOEXCEPT
     {
-        return iterator(data() + m_Storage.max_size());
+        return iterator(data() + m_Storage.capacity());
     }
 
     const_iterator end() const CCC_NOEXCEPT
     {
-        return const_iterator(data() + m_Storage.max_size());
+        return const_iterator(data() + m_Storage.capacity());
     }
 
     reverse_iterator rbegin() CCC_NOEXCEPT
@@ -107,13 +107,13 @@ struct PODArray
     CCC_CONSTEXPR
     size_type size() const CCC_NOEXCEPT
     {
-        return m_Storage.max_size();
+        return m_Storage.capacity();
     }
 
     CCC_CONSTEXPR
     size_type max_size() const CCC_NOEXCEPT
     {
-        return m_Storage.max_size();
+        return m_Storage.capacity();
     }
 
     CCC_CONSTEXPR
@@ -135,7 +135,7 @@ struct PODArray
 
     reference at(size_type Index)
     {
-        if (Index >= m_Storage.max_size())
+        if (Index >= m_Storage.capacity())
         {
             throw std::out_of_range("ConsistentArray::at"), m_Storage[0];
         }
@@ -145,7 +145,7 @@ struct PODArray
     CCC_CONSTEXPR
     const_reference at(size_type Index) const
     {
-        return Index < m_Storage.max_size() ? m_Storage[Index] : (throw std::out_of_range("ConsistentArray::at"), m_Storage[0]);
+        return Index < m_Storage.capacity() ? m_Storage[Index] : (throw std::out_of_range("ConsistentArray::at"), m_Storage[0]);
     }
 
     reference front()
@@ -160,12 +160,12 @@ struct PODArray
 
     reference back()
     {
-        return m_Storage.max_size() ? *(end() - 1) : *end();
+        return m_Storage.capacity() ? *(end() - 1) : *end();
     }
 
     const_reference back() const
     {
-        return m_Storage.max_size() ? *(end() - 1) : *end();
+        return m_Storage.capacity() ? *(end() - 1) : *end();
     }
 
     void fill(const_reference Value)
@@ -25,6 +25,7 @@
 #include <ccc/alignment.h>
 #include <ccc/storage.h>
 #include <ccc/algorithm.h>
+#include <ccc/container_stats.h>
 
 namespace ccc
 {
@@ -96,7 +97,7 @@ struct PodDeque
 
         pointer operator->() const
         {
-            return ccc::addressof<pointer>(m_Container->m_Storage[m_PhysicalIndex]);
+            return ccc::addressof(m_Container->m_Storage[m_PhysicalIndex]);
         }
 
         iterator_type& operator++()
@@ -245,7 +246,7 @@ struct PodDeque
 
         pointer operator->() const
         {
-            return ccc::addressof<pointer>(m_Container->m_Storage[m_PhysicalIndex]);
+            return ccc::addressof(m_Container->m_Storage[m_PhysicalIndex]);
         }
 
         iterator_type& operator++()
@@ -399,6 +400,7 @@ struct PodDeque
         m_Storage.construct_and_assign(begin(), Count, Value);
         m_Storage.construct_and_assign(begin(), Count, Value);
         m_End = next(end(), Count).m_PhysicalIndex;
+        CCC_CONTAINER_STATS_RECORD(ContainerAssign);
     }
 
     template <typename IteratorType>
@@ -407,6 +409,7 @@ struct PodDeque
         clear();
         m_Storage.construct_and_assign(begin(), First, Last);
         m_End = next(end(), std::distance(First, Last)).m_PhysicalIndex;
+        CCC_CONTAINER_STATS_RECORD(ContainerAssign);
     }
 
     // Element access:
@@ -525,6 +528,7 @@ struct PodDeque
         m_Storage.destroy(begin(), end());
         m_Begin = size_type();
         m_End = size_type();
+        CCC_CONTAINER_STATS_RECORD(ContainerClear);
     }
 
     void push_front(const_reference Value)
@@ -533,9 +537,11 @@ struct PodDeque
         {
             m_Begin = (0 == m_Begin) ? max_size() : (m_Begin - 1);
             m_Storage.construct_and_assign(begin(), Value);
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -546,9 +552,11 @@ struct PodDeque
         {
             m_Storage.construct_and_assign(end(), Value);
             m_End = (max_size() == m_End) ? 0 : (m_End + 1);
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -559,6 +567,7 @@ struct PodDeque
         {
             m_Storage.destroy(begin());
             m_Begin = (max_size() == m_Begin) ? 0 : (m_Begin + 1);
+            CCC_CONTAINER_STATS_RECORD(ContainerErase);
         }
     }
 
@@ -568,12 +577,13 @@ struct PodDeque
         {
             m_End = (0 == m_End) ? max_size() : (m_End - 1);
             m_Storage.destroy(end());
+            CCC_CONTAINER_STATS_RECORD(ContainerErase);
         }
     }
 
     iterator insert(size_type Position, const_reference Value)
     {
-        return insert(iterator(ccc::addressof(m_Storage[Position])), Value);
+        return insert(begin() + static_cast<difference_type>(Position), Value);
     }
 
     iterator insert(iterator Position, const_reference Value)
@@ -586,6 +596,7 @@ struct PodDeque
                 ccc::move(begin(), Position, begin() - 1, UseRawMemOpsType());
                 m_Begin = (0 == m_Begin) ? max_size() : (m_Begin - 1);
                 *(Position - 1) = Value;
+                CCC_CONTAINER_STATS_RECORD(ContainerInsert);
                 return (Position - 1);
             }
             else // == Position is in range [PhysicalBegin, LogicalEnd], if PhysicalBegin <= LogicalEnd < LogicalBegin <= PhysicalEnd
@@ -595,11 +606,13 @@ struct PodDeque
                 ccc::move_backward(Position, end(), end() + 1, UseRawMemOpsType());
                 m_End = (max_size() == m_End) ? 0 : (m_End + 1);
                 *Position = Value;
+                CCC_CONTAINER_STATS_RECORD(ContainerInsert);
                 return Position;
             }
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -618,10 +631,12 @@ struct PodDeque
             ccc::move_backward(Position, end(), end() + Count, UseRawMemOpsType());
             std::copy(First, Last, Position);
             m_End = next(end(), Count).m_PhysicalIndex;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
             return Position;
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -638,10 +653,12 @@ struct PodDeque
             ccc::move_backward(Position, end(), end() + Count, UseRawMemOpsType());
             std::fill(Position, Position + Count, Value);
             m_End = next(end(), Count).m_PhysicalIndex;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
             return Position;
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -653,6 +670,7 @@ struct PodDeque
             ccc::move_backward(begin(), Position, Position + 1, UseRawMemOpsType());
             m_Storage.destroy(begin());
             m_Begin = (max_size() == m_Begin) ? 0 : (m_Begin + 1);
+            CCC_CONTAINER_STATS_RECORD(ContainerErase);
             return Position + 1;
         }
         else
@@ -660,6 +678,7 @@ struct PodDeque
             ccc::move(Position + 1, end(), Position, UseRawMemOpsType());
             m_End = (0 == m_End) ? max_size() : (m_End - 1);
             m_Storage.destroy(end());
+            CCC_CONTAINER_STATS_RECORD(ContainerErase);
             return Position;
         }
     }
@@ -669,6 +688,10 @@ struct PodDeque
         std::copy(Last, end(), First);
         m_End = next(end(), -std::distance(First, Last)).m_PhysicalIndex;
         m_Storage.destroy(end(), end() + std::distance(First, Last));
+        if (First != Last)
+        {
+            CCC_CONTAINER_STATS_RECORD(ContainerErase);
+        }
         return First;
     }
 
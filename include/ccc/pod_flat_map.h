@@ -0,0 +1,339 @@
+/**
+ *
+ * @file This file contains the PodFlatMap container.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_POD_FLAT_MAP_H_
+#define CCC_POD_FLAT_MAP_H_
+
+#include <ciso646>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include <ccc/compat.h>
+#include <ccc/algorithm.h>
+#include <ccc/pod_vector.h>
+#include <ccc/eytzinger_layout.h>
+#include <ccc/container_stats.h>
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Consistent, static-capacity map of key-value pairs sorted by key in contiguous memory.
+ *
+ * Lookups use a branchless binary search. If EytzingerLayout is true, rebuild_layout() additionally
+ * stores a copy of the keys in breadth-first order, which is used by all lookups until the keys are
+ * modified again. Modifying mapped values does not invalidate the layout.
+ *
+ * Compare has to be stateless, since it is default-constructed for each comparison.
+ *
+ * Logarithmic time: searching elements.
+ * Linear time: inserting and erasing single elements; merging a sorted range (insert_sorted_range).
+ * Noncompliance: value_type::first is not const, but must not be modified through an iterator.
+ */
+template <class KeyType, class T, class SizeType, SizeType Capacity, class Compare = std::less<KeyType>, unsigned int Alignment = 8,
+        bool EytzingerLayout = false, bool Runtime = false>
+struct PodFlatMap
+{
+    typedef KeyType key_type;
+    typedef T mapped_type;
+    typedef SizeType size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Compare key_compare;
+
+    struct Element
+    {
+        key_type first;
+        mapped_type second;
+    };
+
+    typedef Element value_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    struct value_compare
+    {
+        bool operator()(const value_type& lhs, const value_type& rhs) const
+        {
+            return key_compare()(lhs.first, rhs.first);
+        }
+
+        bool operator()(const value_type& lhs, const key_type& rhs) const
+        {
+            return key_compare()(lhs.first, rhs);
+        }
+    };
+
+    struct KeyOfValue
+    {
+        const key_type& operator()(const value_type& Value) const
+        {
+            return Value.first;
+        }
+    };
+
+    typedef PodVector<value_type, size_type, Capacity, Alignment, false, false, Runtime> values_storage_type;
+    typedef PodEytzingerLayout<key_type, size_type, EytzingerLayout ? Capacity : 0, Alignment, Runtime> layout_type;
+
+    values_storage_type m_Values;
+    layout_type m_Layout;
+
+    // Element access:
+
+    mapped_type& operator[](const key_type& Key)
+    {
+        iterator Position = lower_bound(Key);
+        if ((Position == end()) or key_compare()(Key, Position->first))
+        {
+            value_type Value;
+            Value.first = Key;
+            Value.second = mapped_type();
+            Position = _private_insert(Position, Value);
+        }
+        return Position->second;
+    }
+
+    mapped_type& at(const key_type& Key)
+    {
+        iterator Position = find(Key);
+        if (Position == end())
+        {
+            throw std::out_of_range("PodFlatMap::at");
+        }
+        return Position->second;
+    }
+
+    const mapped_type& at(const key_type& Key) const
+    {
+        const_iterator Position = find(Key);
+        if (Position == end())
+        {
+            throw std::out_of_range("PodFlatMap::at");
+        }
+        return Position->second;
+    }
+
+    // Iterators:
+
+    iterator begin() CCC_NOEXCEPT
+    {
+        return m_Values.begin();
+    }
+
+    const_iterator begin() const CCC_NOEXCEPT
+    {
+        return m_Values.begin();
+    }
+
+    iterator end() CCC_NOEXCEPT
+    {
+        return m_Values.end();
+    }
+
+    const_iterator end() const CCC_NOEXCEPT
+    {
+        return m_Values.end();
+    }
+
+    reverse_iterator rbegin() CCC_NOEXCEPT
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const CCC_NOEXCEPT
+    {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() CCC_NOEXCEPT
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const CCC_NOEXCEPT
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    // Capacity:
+
+    bool empty() const CCC_NOEXCEPT
+    {
+        return m_Values.empty();
+    }
+
+    size_type size() const CCC_NOEXCEPT
+    {
+        return m_Values.size();
+    }
+
+    size_type max_size() const CCC_NOEXCEPT
+    {
+        return m_Values.max_size();
+    }
+
+    // Lookup:
+
+    iterator lower_bound(const key_type& Key)
+    {
+        return begin() + (static_cast<const PodFlatMap*>(this)->lower_bound(Key) - begin());
+    }
+
+    const_iterator lower_bound(const key_type& Key) const
+    {
+        if (EytzingerLayout and m_Layout.valid())
+        {
+            return begin() + m_Layout.lower_bound(Key, key_compare());
+        }
+        return ccc::branchless_lower_bound(begin(), size(), Key, value_compare());
+    }
+
+    iterator upper_bound(const key_type& Key)
+    {
+        iterator Position = lower_bound(Key);
+        return ((Position != end()) and not key_compare()(Key, Position->first)) ? (Position + 1) : Position;
+    }
+
+    const_iterator upper_bound(const key_type& Key) const
+    {
+        const_iterator Position = lower_bound(Key);
+        return ((Position != end()) and not key_compare()(Key, Position->first)) ? (Position + 1) : Position;
+    }
+
+    iterator find(const key_type& Key)
+    {
+        iterator Position = lower_bound(Key);
+        return ((Position != end()) and not key_compare()(Key, Position->first)) ? Position : end();
+    }
+
+    const_iterator find(const key_type& Key) const
+    {
+        const_iterator Position = lower_bound(Key);
+        return ((Position != end()) and not key_compare()(Key, Position->first)) ? Position : end();
+    }
+
+    size_type count(const key_type& Key) const
+    {
+        return (find(Key) != end()) ? 1 : 0;
+    }
+
+    /**
+     * Builds the breadth-first copy of the keys used by subsequent lookups. Has no effect unless
+     * EytzingerLayout is true.
+     */
+    void rebuild_layout()
+    {
+        if (EytzingerLayout)
+        {
+            m_Layout.build(m_Values.begin(), size(), KeyOfValue());
+        }
+    }
+
+    // Modifiers:
+
+    void clear() CCC_NOEXCEPT
+    {
+        m_Values.clear();
+        m_Layout.invalidate();
+        CCC_CONTAINER_STATS_RECORD(ContainerClear);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& Value)
+    {
+        iterator Position = lower_bound(Value.first);
+        if ((Position != end()) and not key_compare()(Value.first, Position->first))
+        {
+            return std::make_pair(Position, false);
+        }
+        return std::make_pair(_private_insert(Position, Value), true);
+    }
+
+    /**
+     * Merges the range [First, Last) of elements sorted by key into the map in a single pass.
+     * Elements whose key is already contained are skipped, and of elements with equal keys only the
+     * first is inserted. Throws std::bad_alloc if the map could exceed its capacity.
+     */
+    template <typename BidirectionalIt>
+    void insert_sorted_range(BidirectionalIt First, BidirectionalIt Last)
+    {
+        difference_type Count = std::distance(First, Last);
+        if (Count > static_cast<difference_type>(max_size() - size()))
+        {
+            CCC_CONTAINER_STATS_OVERFLOW();
+            throw std::bad_alloc();
+        }
+        m_Layout.invalidate();
+        size_type OldSize = size();
+        m_Values.resize(static_cast<size_type>(OldSize + Count));
+        m_Values.resize(ccc::merge_unique_backward(m_Values.begin(), OldSize, First, Last, value_compare()));
+        CCC_CONTAINER_STATS_RECORD(ContainerInsert);
+    }
+
+    iterator erase(const_iterator Position)
+    {
+        m_Layout.invalidate();
+        iterator Next = m_Values.erase(Position);
+        CCC_CONTAINER_STATS_RECORD(ContainerErase);
+        return Next;
+    }
+
+    size_type erase(const key_type& Key)
+    {
+        iterator Position = find(Key);
+        if (Position != end())
+        {
+            erase(Position);
+            return 1;
+        }
+        return 0;
+    }
+
+    void swap(PodFlatMap& Other)
+    {
+        this->m_Values.swap(Other.m_Values);
+        this->m_Layout.swap(Other.m_Layout);
+    }
+
+    // Private methods:
+
+    /**
+     * Inserts Value with a new key at Position. Throws std::bad_alloc if the map is full, before
+     * anything is changed.
+     */
+    iterator _private_insert(iterator Position, const value_type& Value)
+    {
+        if (size() == max_size())
+        {
+            CCC_CONTAINER_STATS_OVERFLOW();
+            throw std::bad_alloc();
+        }
+        m_Layout.invalidate();
+        iterator Inserted = m_Values.insert(Position, Value);
+        CCC_CONTAINER_STATS_RECORD(ContainerInsert);
+        return Inserted;
+    }
+};
+
+#pragma pack(pop)
+
+}
+
+#endif /* CCC_POD_FLAT_MAP_H_ */
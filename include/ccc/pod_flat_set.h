@@ -0,0 +1,225 @@
+/**
+ *
+ * @file This file contains the PodFlatSet container.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_POD_FLAT_SET_H_
+#define CCC_POD_FLAT_SET_H_
+
+#include <ciso646>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include <ccc/compat.h>
+#include <ccc/algorithm.h>
+#include <ccc/pod_vector.h>
+#include <ccc/eytzinger_layout.h>
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Consistent, static-capacity set of sorted keys in contiguous memory.
+ *
+ * Lookups use a branchless binary search. If EytzingerLayout is true, rebuild_layout() additionally
+ * stores a copy of the keys in breadth-first order, which is used by all lookups until the set is
+ * modified again. This pays off for read-mostly sets that exceed the first-level cache.
+ *
+ * Compare has to be stateless, since it is default-constructed for each comparison.
+ *
+ * Logarithmic time: searching elements.
+ * Linear time: inserting and erasing single elements; merging a sorted range (insert_sorted_range).
+ */
+template <class KeyType, class SizeType, SizeType Capacity, class Compare = std::less<KeyType>, unsigned int Alignment = 8,
+        bool EytzingerLayout = false, bool Runtime = false>
+struct PodFlatSet
+{
+    typedef KeyType key_type;
+    typedef KeyType value_type;
+    typedef SizeType size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef const value_type* iterator; // keys must not be modified in place
+    typedef const value_type* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    typedef PodVector<key_type, size_type, Capacity, Alignment, false, false, Runtime> keys_storage_type;
+    typedef PodEytzingerLayout<key_type, size_type, EytzingerLayout ? Capacity : 0, Alignment, Runtime> layout_type;
+
+    struct KeyOfValue
+    {
+        const key_type& operator()(const value_type& Value) const
+        {
+            return Value;
+        }
+    };
+
+    keys_storage_type m_Keys;
+    layout_type m_Layout;
+
+    // Iterators:
+
+    const_iterator begin() const CCC_NOEXCEPT
+    {
+        return m_Keys.begin();
+    }
+
+    const_iterator end() const CCC_NOEXCEPT
+    {
+        return m_Keys.end();
+    }
+
+    const_reverse_iterator rbegin() const CCC_NOEXCEPT
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const CCC_NOEXCEPT
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    const_pointer data() const CCC_NOEXCEPT
+    {
+        return m_Keys.data();
+    }
+
+    // Capacity:
+
+    bool empty() const CCC_NOEXCEPT
+    {
+        return m_Keys.empty();
+    }
+
+    size_type size() const CCC_NOEXCEPT
+    {
+        return m_Keys.size();
+    }
+
+    size_type max_size() const CCC_NOEXCEPT
+    {
+        return m_Keys.max_size();
+    }
+
+    // Lookup:
+
+    const_iterator lower_bound(const key_type& Key) const
+    {
+        if (EytzingerLayout and m_Layout.valid())
+        {
+            return begin() + m_Layout.lower_bound(Key, key_compare());
+        }
+        return ccc::branchless_lower_bound(begin(), size(), Key, key_compare());
+    }
+
+    const_iterator upper_bound(const key_type& Key) const
+    {
+        const_iterator Position = lower_bound(Key);
+        return ((Position != end()) and not key_compare()(Key, *Position)) ? (Position + 1) : Position;
+    }
+
+    const_iterator find(const key_type& Key) const
+    {
+        const_iterator Position = lower_bound(Key);
+        return ((Position != end()) and not key_compare()(Key, *Position)) ? Position : end();
+    }
+
+    size_type count(const key_type& Key) const
+    {
+        return (find(Key) != end()) ? 1 : 0;
+    }
+
+    /**
+     * Builds the breadth-first copy of the keys used by subsequent lookups. Has no effect unless
+     * EytzingerLayout is true.
+     */
+    void rebuild_layout()
+    {
+        if (EytzingerLayout)
+        {
+            m_Layout.build(begin(), size(), KeyOfValue());
+        }
+    }
+
+    // Modifiers:
+
+    void clear() CCC_NOEXCEPT
+    {
+        m_Keys.clear();
+        m_Layout.invalidate();
+    }
+
+    std::pair<iterator, bool> insert(const value_type& Value)
+    {
+        const_iterator Position = lower_bound(Value);
+        if ((Position != end()) and not key_compare()(Value, *Position))
+        {
+            return std::make_pair(Position, false);
+        }
+        m_Layout.invalidate();
+        return std::make_pair(m_Keys.insert(Position, Value), true);
+    }
+
+    /**
+     * Merges the sorted range [First, Last) into the set in a single pass. Keys that are already
+     * contained are skipped. Throws std::bad_alloc if the set could exceed its capacity.
+     */
+    template <typename BidirectionalIt>
+    void insert_sorted_range(BidirectionalIt First, BidirectionalIt Last)
+    {
+        difference_type Count = std::distance(First, Last);
+        if (Count > static_cast<difference_type>(max_size() - size()))
+        {
+            throw std::bad_alloc();
+        }
+        m_Layout.invalidate();
+        size_type OldSize = size();
+        m_Keys.resize(static_cast<size_type>(OldSize + Count));
+        m_Keys.resize(ccc::merge_unique_backward(m_Keys.begin(), OldSize, First, Last, key_compare()));
+    }
+
+    iterator erase(const_iterator Position)
+    {
+        m_Layout.invalidate();
+        return m_Keys.erase(Position);
+    }
+
+    size_type erase(const key_type& Key)
+    {
+        const_iterator Position = find(Key);
+        if (Position != end())
+        {
+            erase(Position);
+            return 1;
+        }
+        return 0;
+    }
+
+    void swap(PodFlatSet& Other)
+    {
+        this->m_Keys.swap(Other.m_Keys);
+        this->m_Layout.swap(Other.m_Layout);
+    }
+};
+
+#pragma pack(pop)
+
+}
+
+#endif /* CCC_POD_FLAT_SET_H_ */
@@ -0,0 +1,438 @@
+/**
+ *
+ * @file This file contains the PodHashMap container.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_POD_HASH_MAP_H_
+#define CCC_POD_HASH_MAP_H_
+
+#include <algorithm>
+#include <ciso646>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <stdint.h>
+
+#include <ccc/compat.h>
+#include <ccc/memory.h>
+#include <ccc/storage.h>
+#include <ccc/type_traits.h>
+#include <ccc/container_stats.h>
+
+namespace ccc
+{
+
+/**
+ * Finalizer of SplitMix64; spreads the entropy of the input over all 64 bits.
+ */
+inline uint64_t mix_hash(uint64_t Value)
+{
+    Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+    return Value ^ (Value >> 31);
+}
+
+/**
+ * @brief Default hash of PodHashMap: 64 bits, of which the lower and the upper half are used independently.
+ *
+ * Hashes the object representation of the key, so keys must not contain padding bytes.
+ */
+template <class Key>
+struct pod_hash
+{
+    uint64_t operator()(const Key& Value) const
+    {
+        const unsigned char* Bytes = reinterpret_cast<const unsigned char*>(addressof(Value));
+        uint64_t Hash = 0xCBF29CE484222325ull;
+        for (std::size_t i = 0; i < sizeof(Key); ++i)
+        {
+            Hash = (Hash ^ Bytes[i]) * 0x100000001B3ull;
+        }
+        return mix_hash(Hash);
+    }
+};
+
+#define CCC_INTEGRAL_POD_HASH(Type) \
+template <> \
+struct pod_hash<Type> \
+{ \
+    uint64_t operator()(Type Value) const \
+    { \
+        return mix_hash(static_cast<uint64_t>(Value)); \
+    } \
+};
+
+CCC_INTEGRAL_POD_HASH(char)
+CCC_INTEGRAL_POD_HASH(signed char)
+CCC_INTEGRAL_POD_HASH(unsigned char)
+CCC_INTEGRAL_POD_HASH(short)
+CCC_INTEGRAL_POD_HASH(unsigned short)
+CCC_INTEGRAL_POD_HASH(int)
+CCC_INTEGRAL_POD_HASH(unsigned int)
+CCC_INTEGRAL_POD_HASH(long)
+CCC_INTEGRAL_POD_HASH(unsigned long)
+CCC_INTEGRAL_POD_HASH(long long)
+CCC_INTEGRAL_POD_HASH(unsigned long long)
+
+#undef CCC_INTEGRAL_POD_HASH
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Consistent, static-capacity hash map with open addressing and linear probing.
+ *
+ * Capacity is the number of buckets, each holding at most one element; the flags marking used buckets
+ * are kept in a separate array. The home bucket of a key is derived from the lower 32 bits of its hash
+ * by a multiplication (not a modulo), so the capacity need not be a power of two and the upper 32 bits
+ * stay available for users like ShardedMap. Erasing shifts the following elements of the probe
+ * sequence backwards instead of leaving tombstones, so lookups never get slower by erasing.
+ *
+ * Lookups degrade as the map fills up, so choose the capacity such that the load stays below about 80%.
+ * Hash and KeyEqual have to be stateless, since they are default-constructed for each call.
+ *
+ * Constant time (expected): searching, inserting and erasing elements.
+ * Noncompliance: value_type::first is not const, but must not be modified through an iterator; erasing
+ * invalidates all iterators.
+ */
+template <class KeyType, class T, class SizeType, SizeType Capacity, class Hash = pod_hash<KeyType>,
+        class KeyEqual = std::equal_to<KeyType>, unsigned int Alignment = 8, bool Runtime = false>
+struct PodHashMap
+{
+    typedef KeyType key_type;
+    typedef T mapped_type;
+    typedef SizeType size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Hash hasher;
+    typedef KeyEqual key_equal;
+
+    struct Element
+    {
+        key_type first;
+        mapped_type second;
+    };
+
+    typedef Element value_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+
+    typedef typename Storage<value_type, size_type, Capacity, Alignment, false, Runtime>::type buckets_storage_type;
+    typedef typename Storage<unsigned char, size_type, Capacity, Alignment, false, Runtime>::type used_storage_type;
+
+    size_type m_Size;
+    used_storage_type m_Used;
+    buckets_storage_type m_Buckets;
+
+    /**
+     * Visits the used buckets in ascending order. Uses the template-variant (see PodList) to implement
+     * const and non-const iterator.
+     */
+    template <class IteratedType, class ContainerType>
+    struct ForwardIterator
+    {
+        typedef typename ccc::remove_const<IteratedType>::type value_type;
+        typedef IteratedType* pointer;
+        typedef IteratedType& reference;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::forward_iterator_tag iterator_category;
+
+        ContainerType* m_Container;
+        size_type m_Bucket;
+
+        ForwardIterator()
+                : m_Container(), m_Bucket()
+        {
+        }
+
+        ForwardIterator(ContainerType* Container, size_type Bucket)
+                : m_Container(Container), m_Bucket(Bucket)
+        {
+        }
+
+        ForwardIterator(ForwardIterator<Element, PodHashMap> const& Other)
+        {
+            this->m_Container = Other.m_Container;
+            this->m_Bucket = Other.m_Bucket;
+        }
+
+        reference operator*() const
+        {
+            return m_Container->m_Buckets[m_Bucket];
+        }
+
+        pointer operator->() const
+        {
+            return ccc::addressof(m_Container->m_Buckets[m_Bucket]);
+        }
+
+        ForwardIterator& operator++()
+        {
+            m_Bucket = m_Container->_private_next_used(m_Bucket + 1);
+            return *this;
+        }
+
+        ForwardIterator operator++(int)
+        {
+            ForwardIterator tmp = *this;
+            m_Bucket = m_Container->_private_next_used(m_Bucket + 1);
+            return tmp;
+        }
+
+        bool operator==(const ForwardIterator& rhs) const
+        {
+            return (m_Container == rhs.m_Container) and (m_Bucket == rhs.m_Bucket);
+        }
+
+        bool operator!=(const ForwardIterator& rhs) const
+        {
+            return (m_Container != rhs.m_Container) or (m_Bucket != rhs.m_Bucket);
+        }
+    };
+
+    typedef ForwardIterator<value_type, PodHashMap> iterator;
+    typedef ForwardIterator<const value_type, const PodHashMap> const_iterator;
+
+    // Element access:
+
+    mapped_type& operator[](const key_type& Key)
+    {
+        value_type Value;
+        Value.first = Key;
+        Value.second = mapped_type();
+        return insert(Value).first->second;
+    }
+
+    mapped_type& at(const key_type& Key)
+    {
+        iterator Position = find(Key);
+        if (Position == end())
+        {
+            throw std::out_of_range("PodHashMap::at");
+        }
+        return Position->second;
+    }
+
+    const mapped_type& at(const key_type& Key) const
+    {
+        const_iterator Position = find(Key);
+        if (Position == end())
+        {
+            throw std::out_of_range("PodHashMap::at");
+        }
+        return Position->second;
+    }
+
+    // Iterators:
+
+    iterator begin() CCC_NOEXCEPT
+    {
+        return iterator(this, _private_next_used(0));
+    }
+
+    const_iterator begin() const CCC_NOEXCEPT
+    {
+        return const_iterator(this, _private_next_used(0));
+    }
+
+    iterator end() CCC_NOEXCEPT
+    {
+        return iterator(this, bucket_count());
+    }
+
+    const_iterator end() const CCC_NOEXCEPT
+    {
+        return const_iterator(this, bucket_count());
+    }
+
+    // Capacity:
+
+    bool empty() const CCC_NOEXCEPT
+    {
+        return 0 == m_Size;
+    }
+
+    size_type size() const CCC_NOEXCEPT
+    {
+        return m_Size;
+    }
+
+    size_type max_size() const CCC_NOEXCEPT
+    {
+        return bucket_count();
+    }
+
+    size_type bucket_count() const CCC_NOEXCEPT
+    {
+        return m_Buckets.capacity();
+    }
+
+    // Lookup:
+
+    iterator find(const key_type& Key)
+    {
+        return iterator(this, _private_find(Key));
+    }
+
+    const_iterator find(const key_type& Key) const
+    {
+        return const_iterator(this, _private_find(Key));
+    }
+
+    size_type count(const key_type& Key) const
+    {
+        return (_private_find(Key) != bucket_count()) ? 1 : 0;
+    }
+
+    /**
+     * Returns the bucket at which the probe sequence of Key starts.
+     */
+    size_type bucket(const key_type& Key) const
+    {
+        return static_cast<size_type>(((hasher()(Key) & 0xFFFFFFFFull) * bucket_count()) >> 32);
+    }
+
+    /**
+     * Hints the processor to load the home bucket of Key, so that a lookup of several keys can overlap
+     * their cache misses.
+     */
+    void prefetch(const key_type& Key) const
+    {
+        if (0 != bucket_count())
+        {
+            const size_type Bucket = bucket(Key);
+            CCC_PREFETCH(&m_Used[Bucket]);
+            CCC_PREFETCH(&m_Buckets[Bucket]);
+        }
+    }
+
+    // Modifiers:
+
+    void clear() CCC_NOEXCEPT
+    {
+        std::fill(&m_Used[0], &m_Used[0] + bucket_count(), static_cast<unsigned char>(0));
+        m_Size = 0;
+        CCC_CONTAINER_STATS_RECORD(ContainerClear);
+    }
+
+    /**
+     * Throws std::bad_alloc if the key is not contained and all buckets are used.
+     */
+    std::pair<iterator, bool> insert(const value_type& Value)
+    {
+        const size_type Buckets = bucket_count();
+        size_type Bucket = (0 != Buckets) ? bucket(Value.first) : 0;
+        for (size_type Probe = 0; Probe < Buckets; ++Probe)
+        {
+            if (not m_Used[Bucket])
+            {
+                m_Buckets[Bucket] = Value;
+                m_Used[Bucket] = 1;
+                ++m_Size;
+                CCC_CONTAINER_STATS_RECORD(ContainerInsert);
+                return std::make_pair(iterator(this, Bucket), true);
+            }
+            if (key_equal()(m_Buckets[Bucket].first, Value.first))
+            {
+                return std::make_pair(iterator(this, Bucket), false);
+            }
+            Bucket = _private_next_bucket(Bucket);
+        }
+        CCC_CONTAINER_STATS_OVERFLOW();
+        throw std::bad_alloc();
+    }
+
+    size_type erase(const key_type& Key)
+    {
+        const size_type Bucket = _private_find(Key);
+        if (Bucket != bucket_count())
+        {
+            _private_erase(Bucket);
+            return 1;
+        }
+        return 0;
+    }
+
+    void erase(const_iterator Position)
+    {
+        _private_erase(Position.m_Bucket);
+    }
+
+    void swap(PodHashMap& Other)
+    {
+        std::swap(this->m_Size, Other.m_Size);
+        this->m_Used.swap(Other.m_Used);
+        this->m_Buckets.swap(Other.m_Buckets);
+    }
+
+    // Private methods:
+
+    size_type _private_next_bucket(size_type Bucket) const
+    {
+        return (Bucket + 1 == bucket_count()) ? 0 : (Bucket + 1);
+    }
+
+    size_type _private_next_used(size_type Bucket) const
+    {
+        while ((Bucket < bucket_count()) and not m_Used[Bucket])
+        {
+            ++Bucket;
+        }
+        return Bucket;
+    }
+
+    // Returns bucket_count() if the key is not contained
+    size_type _private_find(const key_type& Key) const
+    {
+        const size_type Buckets = bucket_count();
+        size_type Bucket = (0 != Buckets) ? bucket(Key) : 0;
+        for (size_type Probe = 0; Probe < Buckets; ++Probe)
+        {
+            if (not m_Used[Bucket])
+            {
+                break;
+            }
+            if (key_equal()(m_Buckets[Bucket].first, Key))
+            {
+                return Bucket;
+            }
+            Bucket = _private_next_bucket(Bucket);
+        }
+        return Buckets;
+    }
+
+    void _private_erase(size_type Hole)
+    {
+        m_Used[Hole] = 0;
+        --m_Size;
+        CCC_CONTAINER_STATS_RECORD(ContainerErase);
+        // Moves each following element of the probe sequence into the hole, unless its home bucket
+        // lies cyclically in (Hole, Next], where it would not be found anymore.
+        for (size_type Next = _private_next_bucket(Hole); m_Used[Next]; Next = _private_next_bucket(Next))
+        {
+            const size_type Home = bucket(m_Buckets[Next].first);
+            const bool Stays = (Hole <= Next) ? ((Hole < Home) and (Home <= Next)) : ((Hole < Home) or (Home <= Next));
+            if (not Stays)
+            {
+                m_Buckets[Hole] = m_Buckets[Next];
+                m_Used[Hole] = 1;
+                m_Used[Next] = 0;
+                Hole = Next;
+            }
+        }
+    }
+};
+
+#pragma pack(pop)
+
+}
+
+#endif /* CCC_POD_HASH_MAP_H_ */
@@ -56,7 +56,7 @@ struct PodLinearMap
 
         pointer operator->() const
         {
-            return ccc::addressof<pointer>(m_Container->m_Values[m_Node - 1]);
+            return ccc::addressof(m_Container->m_Values[m_Node - 1]);
         }
 
         iterator_type& operator++()
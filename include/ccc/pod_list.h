@@ -14,6 +14,7 @@
 #include <ccc/compat.h>
 #include <ccc/iterator.h>
 #include <ccc/pod_vector.h>
+#include <ccc/container_stats.h>
 
 namespace ccc
 {
@@ -96,7 +97,7 @@ struct PodList
 
         pointer operator->() const
         {
-            return ccc::addressof<pointer>(m_Container->m_Values[m_Node - 1]);
+            return ccc::addressof(m_Container->m_Values[m_Node - 1]);
         }
 
         BidirectionalIterator& operator++()
@@ -275,6 +276,7 @@ struct PodList
             pop_front();
         }
         m_Deallocated.clear();
+        CCC_CONTAINER_STATS_RECORD(ContainerClear);
     }
 
     void push_front(const_reference Value)
@@ -290,9 +292,11 @@ struct PodList
             m_Nodes[NewFront].m_Next = OldFront;
             m_Nodes[OldFront].m_Prev = NewFront;
             m_Nodes[m_Anchor].m_Next = NewFront;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -310,9 +314,11 @@ struct PodList
             m_Nodes[NewBack].m_Next = m_Anchor;
             m_Nodes[m_Anchor].m_Prev = NewBack;
             m_Nodes[OldBack].m_Next = NewBack;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -330,9 +336,11 @@ struct PodList
             m_Nodes[NewFront].m_Next = OldFront;
             m_Nodes[OldFront].m_Prev = NewFront;
             m_Nodes[m_Anchor].m_Next = NewFront;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -350,9 +358,11 @@ struct PodList
             m_Nodes[NewBack].m_Next = m_Anchor;
             m_Nodes[m_Anchor].m_Prev = NewBack;
             m_Nodes[OldBack].m_Next = NewBack;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -370,6 +380,7 @@ struct PodList
             m_Nodes.destroy(&m_Nodes[OldFront]);
             m_Values.destroy(&m_Values[OldFront - 1]);
             _private_deallocate_node(OldFront);
+            CCC_CONTAINER_STATS_RECORD(ContainerErase);
         }
     }
 
@@ -386,6 +397,7 @@ struct PodList
             m_Nodes.destroy(&m_Nodes[OldBack]);
             m_Values.destroy(&m_Values[OldBack - 1]);
             _private_deallocate_node(OldBack);
+            CCC_CONTAINER_STATS_RECORD(ContainerErase);
         }
     }
 
@@ -403,10 +415,12 @@ struct PodList
             m_Nodes[Behind].m_Prev = Inserted;
             m_Nodes[Inserted].m_Prev = InFront;
             m_Nodes[Inserted].m_Next = Behind;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
             return iterator(this, Inserted);
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -430,6 +444,7 @@ struct PodList
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -451,6 +466,7 @@ struct PodList
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -469,10 +485,12 @@ struct PodList
             m_Nodes[Behind].m_Prev = Inserted;
             m_Nodes[Inserted].m_Prev = InFront;
             m_Nodes[Inserted].m_Next = Behind;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
             return iterator(this, Inserted);
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -493,6 +511,7 @@ struct PodList
         m_Nodes.destroy(&m_Nodes[Erase]);
         m_Values.destroy(&m_Values[Erase - 1]);
         _private_deallocate_node(Erase);
+        CCC_CONTAINER_STATS_RECORD(ContainerErase);
         return iterator(this, Behind);
     }
 
@@ -0,0 +1,305 @@
+/**
+ *
+ * @file This file contains the PodObjectPool, which hands out slots of uninitialized storage to multiple threads.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_POD_OBJECT_POOL_H_
+#define CCC_POD_OBJECT_POOL_H_
+
+#include <ciso646>
+#include <cstddef>
+#include <new>
+#include <stdint.h>
+
+#include <ccc/compat.h>
+#include <ccc/atomic.h>
+#include <ccc/memory.h>
+#include <ccc/storage.h>
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Consistent, static-capacity pool of objects, which can be allocated and deallocated by any thread without locks.
+ *
+ * Works like the deallocated nodes of PodList, but the free slots form a lock-free stack: the head
+ * combines the top slot with a tag, which is incremented by each modification, so that a compare and
+ * exchange fails if the head was popped and pushed again in between (ABA). The links of the stack
+ * are kept apart from the values, so a thread that read a stale head never touches an object in use.
+ * Slots that were never allocated are handed out from a counter, thus a zero-initialized pool is
+ * empty and ready to use, also in shared memory.
+ *
+ * Each modification of the pool is a compare and exchange on a shared cache line; threads allocating
+ * at high rates should use an ObjectPoolCache, which moves slots in batches. The capacity must be
+ * less than 2^32.
+ *
+ * Constant time: allocating and deallocating single objects (lock-free, not wait-free).
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment = 8, bool Runtime = false>
+struct PodObjectPool
+{
+    typedef T value_type;
+    typedef SizeType size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+
+    typedef typename Storage<value_type, size_type, Capacity, Alignment, true, Runtime>::type values_storage_type;
+    typedef typename Storage<uint32_t, size_type, Capacity, Alignment, false, Runtime>::type links_storage_type;
+
+    volatile uint64_t m_Free; // tag in the upper, top slot + 1 (0 if empty) in the lower 32 bits
+    char m_Padding[64 - sizeof(uint64_t)];
+    volatile uint32_t m_Unused; // slots in [m_Unused, max_size()) were never allocated
+    char m_Padding2[64 - sizeof(uint32_t)];
+    links_storage_type m_Next; // slot + 1 of the next free slot (0 at the bottom)
+    values_storage_type m_Values;
+
+    // Capacity:
+
+    size_type max_size() const CCC_NOEXCEPT
+    {
+        return m_Values.capacity();
+    }
+
+    // Slots:
+
+    size_type slot(const_pointer Object) const
+    {
+        return static_cast<size_type>(Object - &m_Values[0]);
+    }
+
+    pointer address(size_type Slot)
+    {
+        return &m_Values[Slot];
+    }
+
+    const_pointer address(size_type Slot) const
+    {
+        return &m_Values[Slot];
+    }
+
+    /**
+     * Takes up to Count free slots and stores them in Slots. Returns the number of slots taken, which
+     * is less than Count only if the pool is exhausted.
+     */
+    size_type allocate_slots(size_type* Slots, size_type Count)
+    {
+        // Plain volatile loads suffice (and save the fences of atomic_load), since each value read is
+        // validated by the following exchange.
+        size_type Taken = 0;
+        while (Taken < Count)
+        {
+            const uint64_t Head = m_Free;
+            const uint32_t Top = static_cast<uint32_t>(Head);
+            if (0 != Top)
+            {
+                if (atomic_compare_exchange(m_Free, Head, _private_tagged(Head, _private_next(Top - 1))))
+                {
+                    Slots[Taken++] = Top - 1;
+                }
+                continue;
+            }
+            const uint32_t Unused = m_Unused;
+            if (Unused < max_size())
+            {
+                // take as many never allocated slots as needed with a single exchange
+                const uint32_t Available = static_cast<uint32_t>(max_size() - Unused);
+                const uint32_t Take = ((Count - Taken) < Available) ? static_cast<uint32_t>(Count - Taken) : Available;
+                if (atomic_compare_exchange(m_Unused, Unused, Unused + Take))
+                {
+                    for (uint32_t i = 0; i < Take; ++i)
+                    {
+                        Slots[Taken++] = Unused + i;
+                    }
+                }
+            }
+            else if (m_Free == Head)
+            {
+                break;
+            }
+        }
+        return Taken;
+    }
+
+    /**
+     * Returns Count slots to the pool with a single exchange.
+     */
+    void deallocate_slots(const size_type* Slots, size_type Count)
+    {
+        if (0 == Count)
+        {
+            return;
+        }
+        for (size_type i = 0; i + 1 < Count; ++i)
+        {
+            _private_link(Slots[i], static_cast<uint32_t>(Slots[i + 1] + 1));
+        }
+        const uint32_t First = static_cast<uint32_t>(Slots[0] + 1);
+        for (;;)
+        {
+            const uint64_t Head = m_Free;
+            _private_link(Slots[Count - 1], static_cast<uint32_t>(Head));
+            if (atomic_compare_exchange(m_Free, Head, _private_tagged(Head, First)))
+            {
+                return;
+            }
+        }
+    }
+
+    // Objects:
+
+    /**
+     * Returns uninitialized storage for one object. Throws std::bad_alloc if the pool is exhausted.
+     */
+    pointer allocate()
+    {
+        size_type Slot;
+        if (0 == allocate_slots(&Slot, 1))
+        {
+            throw std::bad_alloc();
+        }
+        return address(Slot);
+    }
+
+    void deallocate(pointer Object)
+    {
+        const size_type Slot = slot(Object);
+        deallocate_slots(&Slot, 1);
+    }
+
+    pointer create(const_reference Value)
+    {
+        pointer Object = allocate();
+        m_Values.construct_and_assign(Object, Value);
+        return Object;
+    }
+
+    void destroy(pointer Object)
+    {
+        m_Values.destroy(Object);
+        deallocate(Object);
+    }
+
+    // Private methods:
+
+    static uint64_t _private_tagged(uint64_t Head, uint32_t Top)
+    {
+        return (((Head >> 32) + 1) << 32) | Top;
+    }
+
+    // The link of a slot may be read concurrently by a thread holding a stale head, whose exchange fails.
+    void _private_link(size_type Slot, uint32_t Next)
+    {
+        *static_cast<volatile uint32_t*>(&m_Next[Slot]) = Next;
+    }
+
+    uint32_t _private_next(size_type Slot) const
+    {
+        return *static_cast<const volatile uint32_t*>(&m_Next[Slot]);
+    }
+};
+
+/**
+ * @brief Per-thread cache of slots of a PodObjectPool.
+ *
+ * Allocates from and deallocates to a local stack of up to CacheSize slots, which is refilled and
+ * flushed by CacheSize / 2 slots at a time. Objects may be deallocated through another cache than the
+ * one that allocated them. An object of this class must only be used by one thread at a time; the
+ * destructor returns the cached slots to the pool. CacheSize must be at least 2.
+ */
+template <class Pool, unsigned int CacheSize = 32>
+class ObjectPoolCache
+{
+public:
+    typedef Pool pool_type;
+    typedef typename pool_type::value_type value_type;
+    typedef typename pool_type::size_type size_type;
+    typedef typename pool_type::pointer pointer;
+    typedef typename pool_type::const_reference const_reference;
+
+    explicit ObjectPoolCache(pool_type& SharedPool)
+            : m_Pool(SharedPool), m_Count(0)
+    {
+    }
+
+    ~ObjectPoolCache()
+    {
+        flush();
+    }
+
+    /**
+     * Returns uninitialized storage for one object. Throws std::bad_alloc if the pool is exhausted.
+     */
+    pointer allocate()
+    {
+        if (0 == m_Count)
+        {
+            m_Count = m_Pool.allocate_slots(m_Slots, CacheSize / 2);
+            if (0 == m_Count)
+            {
+                throw std::bad_alloc();
+            }
+        }
+        return m_Pool.address(m_Slots[--m_Count]);
+    }
+
+    void deallocate(pointer Object)
+    {
+        if (CacheSize == m_Count)
+        {
+            m_Count = m_Count - CacheSize / 2;
+            m_Pool.deallocate_slots(&m_Slots[m_Count], CacheSize / 2);
+        }
+        m_Slots[m_Count++] = m_Pool.slot(Object);
+    }
+
+    pointer create(const_reference Value)
+    {
+        pointer Object = allocate();
+        m_Pool.m_Values.construct_and_assign(Object, Value);
+        return Object;
+    }
+
+    void destroy(pointer Object)
+    {
+        m_Pool.m_Values.destroy(Object);
+        deallocate(Object);
+    }
+
+    /**
+     * Returns all cached slots to the pool.
+     */
+    void flush()
+    {
+        m_Pool.deallocate_slots(m_Slots, m_Count);
+        m_Count = 0;
+    }
+
+    size_type cached() const
+    {
+        return m_Count;
+    }
+
+private:
+    ObjectPoolCache(ObjectPoolCache const&);
+    void operator=(ObjectPoolCache const&);
+
+    pool_type& m_Pool;
+    size_type m_Count;
+    size_type m_Slots[CacheSize];
+};
+
+#pragma pack(pop)
+
+}
+
+#endif /* CCC_POD_OBJECT_POOL_H_ */
@@ -0,0 +1,476 @@
+/**
+ *
+ * @file This file contains the PodPriorityQueue and PodIndexedPriorityQueue containers.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_POD_PRIORITY_QUEUE_H_
+#define CCC_POD_PRIORITY_QUEUE_H_
+
+#include <ciso646>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+
+#include <ccc/compat.h>
+#include <ccc/storage.h>
+#include <ccc/pod_vector.h>
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Consistent, static-capacity priority queue implemented as implicit d-ary heap.
+ *
+ * As for std::priority_queue, top() is the greatest element with respect to Compare, so
+ * std::greater yields a min-queue. Node i has its children at Arity * i + 1 ... Arity * i + Arity.
+ * A larger Arity makes the heap shallower, so sifting down touches fewer cache lines at the cost of
+ * more comparisons per level; 4 is a good choice for small elements. Arity has to be at least 2.
+ *
+ * Compare has to be stateless, since it is default-constructed for each comparison.
+ *
+ * Constant time: accessing the top element.
+ * Logarithmic time: push, pop, replace_top.
+ * Linear time: heapify.
+ */
+template <class T, class SizeType, SizeType Capacity, class Compare = std::less<T>, unsigned int Arity = 2,
+        unsigned int Alignment = 8, bool Runtime = false>
+struct PodPriorityQueue
+{
+    typedef T value_type;
+    typedef SizeType size_type;
+    typedef Compare value_compare;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+
+    typedef PodVector<value_type, size_type, Capacity, Alignment, false, false, Runtime> container_type;
+
+    CCC_STATIC_ASSERT(Arity >= 2, "a heap needs an arity of at least 2");
+
+    container_type m_Heap;
+
+    // Element access:
+
+    const_reference top() const
+    {
+        return m_Heap.front();
+    }
+
+    // Capacity:
+
+    bool empty() const CCC_NOEXCEPT
+    {
+        return m_Heap.empty();
+    }
+
+    size_type size() const CCC_NOEXCEPT
+    {
+        return m_Heap.size();
+    }
+
+    size_type max_size() const CCC_NOEXCEPT
+    {
+        return m_Heap.max_size();
+    }
+
+    // Modifiers:
+
+    void push(const_reference Value)
+    {
+        value_type Copy = Value; // Value might refer to an element of the heap
+        m_Heap.push_back(Copy);
+        _private_sift_up(size() - 1, Copy);
+    }
+
+    void pop()
+    {
+        if (size() > 1)
+        {
+            value_type Last = m_Heap.back();
+            m_Heap.pop_back();
+            // The last element most likely belongs near the bottom again, so move the hole down to
+            // a leaf without comparing against it and sift it up from there.
+            _private_sift_up(_private_move_hole_to_leaf(0), Last);
+        }
+        else
+        {
+            m_Heap.pop_back();
+        }
+    }
+
+    /**
+     * Equivalent to pop() followed by push(Value), but sifts only once. Assumes the queue is not
+     * empty.
+     */
+    void replace_top(const_reference Value)
+    {
+        value_type Copy = Value;
+        _private_sift_down(0, Copy);
+    }
+
+    /**
+     * Replaces the content with the range [First, Last) and restores the heap property bottom-up.
+     * Throws std::bad_alloc if the range exceeds the capacity.
+     */
+    template <typename IteratorType>
+    void heapify(IteratorType First, IteratorType Last)
+    {
+        if (std::distance(First, Last) > static_cast<std::ptrdiff_t>(max_size()))
+        {
+            throw std::bad_alloc();
+        }
+        m_Heap.assign(First, Last);
+        for (std::size_t i = size() / Arity + 1; i > 0; --i)
+        {
+            if (i - 1 < size())
+            {
+                value_type Value = m_Heap[static_cast<size_type>(i - 1)];
+                _private_sift_down(i - 1, Value);
+            }
+        }
+    }
+
+    void clear() CCC_NOEXCEPT
+    {
+        m_Heap.clear();
+    }
+
+    void swap(PodPriorityQueue& Other)
+    {
+        this->m_Heap.swap(Other.m_Heap);
+    }
+
+    // Private methods:
+
+    void _private_sift_up(std::size_t Index, const value_type& Value)
+    {
+        while (Index > 0)
+        {
+            std::size_t Parent = (Index - 1) / Arity;
+            if (not value_compare()(m_Heap[static_cast<size_type>(Parent)], Value))
+            {
+                break;
+            }
+            m_Heap[static_cast<size_type>(Index)] = m_Heap[static_cast<size_type>(Parent)];
+            Index = Parent;
+        }
+        m_Heap[static_cast<size_type>(Index)] = Value;
+    }
+
+    std::size_t _private_move_hole_to_leaf(std::size_t Index)
+    {
+        const std::size_t Size = size();
+        value_type* Heap = m_Heap.data();
+        std::size_t Child = Arity * Index + 1;
+        // nodes with all Arity children take the loop with a fixed trip count
+        while (Child + Arity <= Size)
+        {
+            std::size_t Greatest = Child;
+            for (unsigned int i = 1; i < Arity; ++i)
+            {
+                Greatest = value_compare()(Heap[Greatest], Heap[Child + i]) ? (Child + i) : Greatest;
+            }
+            Heap[Index] = Heap[Greatest];
+            Index = Greatest;
+            Child = Arity * Index + 1;
+        }
+        if (Child < Size)
+        {
+            std::size_t Greatest = Child;
+            for (++Child; Child < Size; ++Child)
+            {
+                Greatest = value_compare()(Heap[Greatest], Heap[Child]) ? Child : Greatest;
+            }
+            Heap[Index] = Heap[Greatest];
+            Index = Greatest;
+        }
+        return Index;
+    }
+
+    void _private_sift_down(std::size_t Index, const value_type& Value)
+    {
+        const std::size_t Size = size();
+        for (;;)
+        {
+            std::size_t Child = Arity * Index + 1;
+            if (Child >= Size)
+            {
+                break;
+            }
+            std::size_t Last = (Child + Arity < Size) ? (Child + Arity) : Size;
+            std::size_t Greatest = Child;
+            for (++Child; Child < Last; ++Child)
+            {
+                if (value_compare()(m_Heap[static_cast<size_type>(Greatest)], m_Heap[static_cast<size_type>(Child)]))
+                {
+                    Greatest = Child;
+                }
+            }
+            if (not value_compare()(Value, m_Heap[static_cast<size_type>(Greatest)]))
+            {
+                break;
+            }
+            m_Heap[static_cast<size_type>(Index)] = m_Heap[static_cast<size_type>(Greatest)];
+            Index = Greatest;
+        }
+        m_Heap[static_cast<size_type>(Index)] = Value;
+    }
+};
+
+/**
+ * @brief PodPriorityQueue that supports changing and erasing queued elements.
+ *
+ * push() returns a handle, which stays valid until its element is popped or erased. Handles are
+ * indices into a position table and are recycled from a stack of deallocated handles, as in
+ * PodList. update() moves an element in either direction, so it covers decrease-key as well as
+ * increase-key.
+ *
+ * Logarithmic time: push, pop, update, erase.
+ * Noncompliance: A recycled handle refers to the new element; contains() can not detect a handle,
+ * whose element was popped, once the handle was reused.
+ */
+template <class T, class SizeType, SizeType Capacity, class Compare = std::less<T>, unsigned int Arity = 2,
+        unsigned int Alignment = 8, bool Runtime = false>
+struct PodIndexedPriorityQueue
+{
+    typedef T value_type;
+    typedef SizeType size_type;
+    typedef Compare value_compare;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_type handle_type;
+
+    struct Entry
+    {
+        value_type m_Value;
+        handle_type m_Handle;
+    };
+
+    typedef Entry entry_type;
+    typedef PodVector<entry_type, size_type, Capacity, Alignment, false, false, Runtime> container_type;
+    typedef typename Storage<size_type, size_type, Capacity, Alignment, false, Runtime>::type positions_storage_type;
+    typedef PodVector<handle_type, size_type, Capacity, Alignment, false, false, Runtime> handles_storage_type;
+
+    CCC_STATIC_ASSERT(Arity >= 2, "a heap needs an arity of at least 2");
+
+    container_type m_Heap;
+    positions_storage_type m_Positions; // index of the entry of a handle in m_Heap
+    handles_storage_type m_Deallocated;
+
+    // Element access:
+
+    const_reference top() const
+    {
+        return m_Heap.front().m_Value;
+    }
+
+    handle_type top_handle() const
+    {
+        return m_Heap.front().m_Handle;
+    }
+
+    /**
+     * Note: Passing an invalid handle causes undefined behavior (see at() for a checked variant).
+     */
+    const_reference operator[](handle_type Handle) const
+    {
+        return m_Heap[m_Positions[Handle]].m_Value;
+    }
+
+    const_reference at(handle_type Handle) const
+    {
+        if (not contains(Handle))
+        {
+            throw std::out_of_range("PodIndexedPriorityQueue::at");
+        }
+        return m_Heap[m_Positions[Handle]].m_Value;
+    }
+
+    bool contains(handle_type Handle) const
+    {
+        return (Handle < max_size()) and (m_Positions[Handle] < size()) and (m_Heap[m_Positions[Handle]].m_Handle == Handle);
+    }
+
+    // Capacity:
+
+    bool empty() const CCC_NOEXCEPT
+    {
+        return m_Heap.empty();
+    }
+
+    size_type size() const CCC_NOEXCEPT
+    {
+        return m_Heap.size();
+    }
+
+    size_type max_size() const CCC_NOEXCEPT
+    {
+        return m_Heap.max_size();
+    }
+
+    // Modifiers:
+
+    handle_type push(const_reference Value)
+    {
+        if (size() < max_size())
+        {
+            entry_type Inserted;
+            Inserted.m_Value = Value;
+            if (not m_Deallocated.empty())
+            {
+                Inserted.m_Handle = m_Deallocated.back();
+                m_Deallocated.pop_back();
+            }
+            else
+            {
+                // all handles in [0, size()) are in use
+                Inserted.m_Handle = size();
+            }
+            m_Heap.push_back(Inserted);
+            _private_sift_up(size() - 1, Inserted);
+            return Inserted.m_Handle;
+        }
+        else
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    void pop()
+    {
+        if (not empty())
+        {
+            _private_remove(0);
+        }
+    }
+
+    /**
+     * Assigns Value to the element of Handle and restores the heap property.
+     */
+    void update(handle_type Handle, const_reference Value)
+    {
+        std::size_t Index = m_Positions[Handle];
+        entry_type Updated;
+        Updated.m_Value = Value;
+        Updated.m_Handle = Handle;
+        if ((Index > 0) and value_compare()(m_Heap[static_cast<size_type>((Index - 1) / Arity)].m_Value, Updated.m_Value))
+        {
+            _private_sift_up(Index, Updated);
+        }
+        else
+        {
+            _private_sift_down(Index, Updated);
+        }
+    }
+
+    /**
+     * Returns false if the handle is not contained.
+     */
+    bool erase(handle_type Handle)
+    {
+        if (contains(Handle))
+        {
+            _private_remove(m_Positions[Handle]);
+            return true;
+        }
+        return false;
+    }
+
+    void clear() CCC_NOEXCEPT
+    {
+        m_Heap.clear();
+        m_Deallocated.clear();
+    }
+
+    void swap(PodIndexedPriorityQueue& Other)
+    {
+        this->m_Heap.swap(Other.m_Heap);
+        this->m_Positions.swap(Other.m_Positions);
+        this->m_Deallocated.swap(Other.m_Deallocated);
+    }
+
+    // Private methods:
+
+    void _private_remove(std::size_t Index)
+    {
+        m_Deallocated.push_back(m_Heap[static_cast<size_type>(Index)].m_Handle);
+        entry_type Last = m_Heap.back();
+        m_Heap.pop_back();
+        if (Index < size())
+        {
+            // the last entry fills the gap and may have to move in either direction
+            if ((Index > 0) and value_compare()(m_Heap[static_cast<size_type>((Index - 1) / Arity)].m_Value, Last.m_Value))
+            {
+                _private_sift_up(Index, Last);
+            }
+            else
+            {
+                _private_sift_down(Index, Last);
+            }
+        }
+    }
+
+    void _private_place(std::size_t Index, const entry_type& Placed)
+    {
+        m_Heap[static_cast<size_type>(Index)] = Placed;
+        m_Positions[Placed.m_Handle] = static_cast<size_type>(Index);
+    }
+
+    void _private_sift_up(std::size_t Index, const entry_type& Sifted)
+    {
+        while (Index > 0)
+        {
+            std::size_t Parent = (Index - 1) / Arity;
+            if (not value_compare()(m_Heap[static_cast<size_type>(Parent)].m_Value, Sifted.m_Value))
+            {
+                break;
+            }
+            _private_place(Index, m_Heap[static_cast<size_type>(Parent)]);
+            Index = Parent;
+        }
+        _private_place(Index, Sifted);
+    }
+
+    void _private_sift_down(std::size_t Index, const entry_type& Sifted)
+    {
+        const std::size_t Size = size();
+        for (;;)
+        {
+            std::size_t Child = Arity * Index + 1;
+            if (Child >= Size)
+            {
+                break;
+            }
+            std::size_t Last = (Child + Arity < Size) ? (Child + Arity) : Size;
+            std::size_t Greatest = Child;
+            for (++Child; Child < Last; ++Child)
+            {
+                if (value_compare()(m_Heap[static_cast<size_type>(Greatest)].m_Value, m_Heap[static_cast<size_type>(Child)].m_Value))
+                {
+                    Greatest = Child;
+                }
+            }
+            if (not value_compare()(Sifted.m_Value, m_Heap[static_cast<size_type>(Greatest)].m_Value))
+            {
+                break;
+            }
+            _private_place(Index, m_Heap[static_cast<size_type>(Greatest)]);
+            Index = Greatest;
+        }
+        _private_place(Index, Sifted);
+    }
+};
+
+#pragma pack(pop)
+
+}
+
+#endif /* CCC_POD_PRIORITY_QUEUE_H_ */
@@ -0,0 +1,334 @@
+/**
+ *
+ * @file This file contains the PodSlotMap container.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_POD_SLOT_MAP_H_
+#define CCC_POD_SLOT_MAP_H_
+
+#include <ciso646>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+
+#include <ccc/compat.h>
+#include <ccc/memory.h>
+#include <ccc/storage.h>
+#include <ccc/pod_vector.h>
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Consistent, static-capacity container addressed by stable handles.
+ *
+ * The values are kept densely packed in a PodVector, so iterating visits contiguous memory. Each
+ * value is owned by a slot, which stays at the same index for the lifetime of the value. A handle
+ * consists of the slot index and the generation of the slot. Erasing a value increments the
+ * generation, so handles of erased values are recognized as stale even after the slot was reused.
+ * As in PodList, freed slots are recycled from a stack of deallocated indices.
+ *
+ * Constant time: inserting and erasing elements; accessing elements by handle.
+ * Noncompliance: Erasing moves the last element into the gap, so the order of the elements
+ * is not preserved and iterators to the last element are invalidated.
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment = 8, bool Uninitialized = false, bool Runtime = false>
+struct PodSlotMap
+{
+    typedef T value_type;
+    typedef SizeType size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+
+    typedef size_type slot_index_type;
+
+    struct SlotHandle
+    {
+        slot_index_type m_Slot;
+        size_type m_Generation;
+
+        bool operator==(const SlotHandle& rhs) const
+        {
+            return (m_Slot == rhs.m_Slot) and (m_Generation == rhs.m_Generation);
+        }
+
+        bool operator!=(const SlotHandle& rhs) const
+        {
+            return (m_Slot != rhs.m_Slot) or (m_Generation != rhs.m_Generation);
+        }
+    };
+
+    struct Slot
+    {
+        size_type m_Dense; // index of the value in m_Values
+        size_type m_Generation;
+    };
+
+    typedef SlotHandle handle_type;
+    typedef Slot slot_type;
+
+    typedef PodVector<value_type, size_type, Capacity, Alignment, false, Uninitialized, Runtime> values_storage_type;
+    typedef PodVector<slot_index_type, size_type, Capacity, Alignment, false, false, Runtime> slot_indices_storage_type;
+    typedef typename Storage<slot_type, size_type, Capacity, Alignment, false, Runtime>::type slots_storage_type;
+
+    typedef typename values_storage_type::iterator iterator;
+    typedef typename values_storage_type::const_iterator const_iterator;
+    typedef typename values_storage_type::reverse_iterator reverse_iterator;
+    typedef typename values_storage_type::const_reverse_iterator const_reverse_iterator;
+
+    values_storage_type m_Values;
+    slot_indices_storage_type m_Owners; // slot owning the value at the same index in m_Values
+    slots_storage_type m_Slots;
+    slot_indices_storage_type m_Deallocated;
+
+    // Iterators:
+
+    iterator begin() CCC_NOEXCEPT
+    {
+        return m_Values.begin();
+    }
+
+    const_iterator begin() const CCC_NOEXCEPT
+    {
+        return m_Values.begin();
+    }
+
+    iterator end() CCC_NOEXCEPT
+    {
+        return m_Values.end();
+    }
+
+    const_iterator end() const CCC_NOEXCEPT
+    {
+        return m_Values.end();
+    }
+
+    reverse_iterator rbegin() CCC_NOEXCEPT
+    {
+        return m_Values.rbegin();
+    }
+
+    const_reverse_iterator rbegin() const CCC_NOEXCEPT
+    {
+        return m_Values.rbegin();
+    }
+
+    reverse_iterator rend() CCC_NOEXCEPT
+    {
+        return m_Values.rend();
+    }
+
+    const_reverse_iterator rend() const CCC_NOEXCEPT
+    {
+        return m_Values.rend();
+    }
+
+    pointer data() CCC_NOEXCEPT
+    {
+        return m_Values.data();
+    }
+
+    const_pointer data() const CCC_NOEXCEPT
+    {
+        return m_Values.data();
+    }
+
+    // Capacity:
+
+    bool empty() const CCC_NOEXCEPT
+    {
+        return m_Values.empty();
+    }
+
+    size_type size() const CCC_NOEXCEPT
+    {
+        return m_Values.size();
+    }
+
+    size_type max_size() const CCC_NOEXCEPT
+    {
+        return m_Values.max_size();
+    }
+
+    // Lookup:
+
+    bool contains(handle_type Handle) const
+    {
+        if (Handle.m_Slot >= max_size())
+        {
+            return false;
+        }
+        const slot_type& S = m_Slots[Handle.m_Slot];
+        return (S.m_Dense < size()) and (m_Owners[S.m_Dense] == Handle.m_Slot) and (S.m_Generation == Handle.m_Generation);
+    }
+
+    iterator find(handle_type Handle)
+    {
+        return contains(Handle) ? (begin() + m_Slots[Handle.m_Slot].m_Dense) : end();
+    }
+
+    const_iterator find(handle_type Handle) const
+    {
+        return contains(Handle) ? (begin() + m_Slots[Handle.m_Slot].m_Dense) : end();
+    }
+
+    /**
+     * Note: Passing a stale handle causes undefined behavior (see at() for a checked variant).
+     */
+    reference operator[](handle_type Handle)
+    {
+        return m_Values[m_Slots[Handle.m_Slot].m_Dense];
+    }
+
+    const_reference operator[](handle_type Handle) const
+    {
+        return m_Values[m_Slots[Handle.m_Slot].m_Dense];
+    }
+
+    reference at(handle_type Handle)
+    {
+        if (not contains(Handle))
+        {
+            throw std::out_of_range("PodSlotMap::at");
+        }
+        return m_Values[m_Slots[Handle.m_Slot].m_Dense];
+    }
+
+    const_reference at(handle_type Handle) const
+    {
+        if (not contains(Handle))
+        {
+            throw std::out_of_range("PodSlotMap::at");
+        }
+        return m_Values[m_Slots[Handle.m_Slot].m_Dense];
+    }
+
+    /**
+     * Returns the handle of the element Position points at.
+     */
+    handle_type handle(const_iterator Position) const
+    {
+        handle_type Handle;
+        Handle.m_Slot = m_Owners[static_cast<size_type>(Position - begin())];
+        Handle.m_Generation = m_Slots[Handle.m_Slot].m_Generation;
+        return Handle;
+    }
+
+    // Modifiers:
+
+    // Assumes there are free slots
+    slot_index_type _private_allocate_slot()
+    {
+        slot_index_type Allocated;
+        if (not m_Deallocated.empty())
+        {
+            // Prefer a slot, that was already used
+            Allocated = m_Deallocated.back();
+            m_Deallocated.pop_back();
+        }
+        else
+        {
+            // all slots in [0, size()) are in use
+            Allocated = size();
+        }
+        return Allocated;
+    }
+
+    void _private_deallocate_slot(slot_index_type Index)
+    {
+        m_Slots[Index].m_Generation = m_Slots[Index].m_Generation + 1;
+        m_Deallocated.push_back(Index);
+    }
+
+    handle_type insert(const_reference Value)
+    {
+        if (size() < max_size())
+        {
+            handle_type Handle;
+            Handle.m_Slot = _private_allocate_slot();
+            Handle.m_Generation = m_Slots[Handle.m_Slot].m_Generation;
+            m_Slots[Handle.m_Slot].m_Dense = size();
+            m_Owners.push_back(Handle.m_Slot);
+            m_Values.push_back(Value);
+            return Handle;
+        }
+        else
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    /**
+     * Returns false if the handle is stale.
+     */
+    bool erase(handle_type Handle)
+    {
+        if (contains(Handle))
+        {
+            erase(begin() + m_Slots[Handle.m_Slot].m_Dense);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Moves the last element to Position and returns Position, so that erasing while iterating
+     * continues with the moved element.
+     */
+    iterator erase(const_iterator Position)
+    {
+        size_type Dense = static_cast<size_type>(Position - begin());
+        size_type Last = size() - 1;
+        slot_index_type Erased = m_Owners[Dense];
+        if (Dense != Last)
+        {
+            slot_index_type Moved = m_Owners[Last];
+            m_Values[Dense] = m_Values[Last];
+            m_Owners[Dense] = Moved;
+            m_Slots[Moved].m_Dense = Dense;
+        }
+        m_Values.pop_back();
+        m_Owners.pop_back();
+        _private_deallocate_slot(Erased);
+        return begin() + Dense;
+    }
+
+    /**
+     * Invalidates all handles.
+     */
+    void clear() CCC_NOEXCEPT
+    {
+        for (size_type i = 0; i < size(); ++i)
+        {
+            m_Slots[m_Owners[i]].m_Generation = m_Slots[m_Owners[i]].m_Generation + 1;
+        }
+        m_Values.clear();
+        m_Owners.clear();
+        m_Deallocated.clear();
+    }
+
+    void swap(PodSlotMap& Other)
+    {
+        this->m_Values.swap(Other.m_Values);
+        this->m_Owners.swap(Other.m_Owners);
+        this->m_Slots.swap(Other.m_Slots);
+        this->m_Deallocated.swap(Other.m_Deallocated);
+    }
+};
+
+#pragma pack(pop)
+
+}
+
+#endif /* CCC_POD_SLOT_MAP_H_ */
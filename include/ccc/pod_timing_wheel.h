@@ -0,0 +1,411 @@
+/**
+ *
+ * @file This file contains the PodTimingWheel container.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_POD_TIMING_WHEEL_H_
+#define CCC_POD_TIMING_WHEEL_H_
+
+#include <ciso646>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+
+#include <ccc/compat.h>
+#include <ccc/alignment.h>
+#include <ccc/storage.h>
+#include <ccc/pod_vector.h>
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Consistent, static-capacity hierarchical timing wheel.
+ *
+ * The wheel has Levels levels of 2^SlotBits buckets each. A bucket of level L holds the timers,
+ * whose deadline first differs from the current tick in the L-th group of SlotBits bits. When the
+ * current tick enters a new slot of level L, the timers of that slot are cascaded to lower levels;
+ * the timers of the current slot of level 0 are due. Deadlines beyond the range of the top level
+ * are cascaded once per revolution of the top level until they are in range.
+ *
+ * The buckets are intrusive, doubly linked chains over a single pool of timer nodes. As in PodList,
+ * freed nodes are recycled from a stack of deallocated indices. Links store the node index plus one,
+ * so zero denotes the end of a chain and a zero-initialized wheel is empty. Handles are checked by a
+ * generation counter as in PodSlotMap, which is odd while the node is in use.
+ *
+ * SlotBits * Levels must not exceed the number of bits of TickType.
+ *
+ * Constant time: schedule, cancel; advance per expired or cascaded timer.
+ */
+template <class T, class SizeType, SizeType Capacity, class TickType = unsigned long, unsigned int SlotBits = 8,
+        unsigned int Levels = 4, unsigned int Alignment = 8, bool Runtime = false>
+struct PodTimingWheel
+{
+    typedef T value_type;
+    typedef SizeType size_type;
+    typedef TickType tick_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+
+    typedef size_type node_index_type;
+
+    struct TimerHandle
+    {
+        node_index_type m_Index;
+        size_type m_Generation;
+
+        bool operator==(const TimerHandle& rhs) const
+        {
+            return (m_Index == rhs.m_Index) and (m_Generation == rhs.m_Generation);
+        }
+
+        bool operator!=(const TimerHandle& rhs) const
+        {
+            return (m_Index != rhs.m_Index) or (m_Generation != rhs.m_Generation);
+        }
+    };
+
+    struct TimerNode
+    {
+        tick_type m_Deadline;
+        node_index_type m_Prev; // index + 1, 0 if first in the bucket
+        node_index_type m_Next; // index + 1, 0 if last in the bucket
+        size_type m_Bucket;
+        size_type m_Generation;
+        value_type m_Value; // next to the links, so that expiring a timer touches a single node
+    };
+
+    typedef TimerHandle handle_type;
+    typedef TimerNode node_type;
+
+    static const size_type SlotCount = static_cast<size_type>(1) << SlotBits;
+    static const size_type BucketCount = static_cast<size_type>(Levels) << SlotBits;
+
+    typedef typename Storage<node_type, size_type, Capacity, Alignment, false, Runtime>::type nodes_storage_type;
+    typedef typename Storage<node_index_type, size_type, BucketCount, Alignment, false, Runtime>::type buckets_storage_type;
+    typedef typename Storage<size_type, size_type, Levels, Alignment, false, Runtime>::type level_sizes_storage_type;
+    typedef PodVector<node_index_type, size_type, Capacity, Alignment, false, false, Runtime> deallocated_storage_type;
+
+#if (CCC_ALIGNAS_AVAILABLE)
+    alignas(Alignment) tick_type m_Now;
+    alignas(Alignment) size_type m_Size;
+#elif CCC_ALIGNED_AVAILABLE
+    typename ccc::Aligned<tick_type, Alignment>::type m_Now;
+    typename ccc::Aligned<size_type, Alignment>::type m_Size;
+#else
+    PaddedValue<tick_type, Alignment> m_Now;
+    PaddedValue<size_type, Alignment> m_Size;
+#endif
+    nodes_storage_type m_Nodes;
+    buckets_storage_type m_Buckets; // first node of each bucket (index + 1)
+    level_sizes_storage_type m_LevelSizes; // number of timers in each level
+    deallocated_storage_type m_Deallocated;
+
+    // Capacity:
+
+    bool empty() const CCC_NOEXCEPT
+    {
+        return 0 == m_Size;
+    }
+
+    size_type size() const CCC_NOEXCEPT
+    {
+        return m_Size;
+    }
+
+    size_type max_size() const CCC_NOEXCEPT
+    {
+        return m_Deallocated.max_size();
+    }
+
+    // Lookup:
+
+    /**
+     * Returns the last tick advance() processed.
+     */
+    tick_type now() const CCC_NOEXCEPT
+    {
+        return m_Now;
+    }
+
+    bool contains(handle_type Handle) const
+    {
+        return (Handle.m_Index < max_size()) and (m_Nodes[Handle.m_Index].m_Generation == Handle.m_Generation)
+                and (0 != (Handle.m_Generation & 1));
+    }
+
+    /**
+     * Note: Passing a stale handle causes undefined behavior (see at() for a checked variant).
+     */
+    reference operator[](handle_type Handle)
+    {
+        return m_Nodes[Handle.m_Index].m_Value;
+    }
+
+    const_reference operator[](handle_type Handle) const
+    {
+        return m_Nodes[Handle.m_Index].m_Value;
+    }
+
+    reference at(handle_type Handle)
+    {
+        if (not contains(Handle))
+        {
+            throw std::out_of_range("PodTimingWheel::at");
+        }
+        return m_Nodes[Handle.m_Index].m_Value;
+    }
+
+    const_reference at(handle_type Handle) const
+    {
+        if (not contains(Handle))
+        {
+            throw std::out_of_range("PodTimingWheel::at");
+        }
+        return m_Nodes[Handle.m_Index].m_Value;
+    }
+
+    /**
+     * Returns the tick at which the timer expires. Deadlines that had already passed when the timer
+     * was scheduled are reported as the tick it was scheduled at.
+     */
+    tick_type deadline(handle_type Handle) const
+    {
+        return m_Nodes[Handle.m_Index].m_Deadline;
+    }
+
+    // Modifiers:
+
+    /**
+     * Schedules Value to expire at the tick Deadline. A deadline, that has already passed, expires
+     * with the next call of advance(). Throws std::bad_alloc if the wheel is full.
+     */
+    handle_type schedule(tick_type Deadline, const_reference Value)
+    {
+        if (size() < max_size())
+        {
+            handle_type Handle;
+            Handle.m_Index = _private_allocate_node();
+            node_type& Node = m_Nodes[Handle.m_Index];
+            Node.m_Generation = Node.m_Generation + 1;
+            Node.m_Deadline = (Deadline < m_Now) ? static_cast<tick_type>(m_Now) : Deadline;
+            Handle.m_Generation = Node.m_Generation;
+            Node.m_Value = Value;
+            _private_link(Handle.m_Index);
+            m_Size = m_Size + 1;
+            return Handle;
+        }
+        else
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    /**
+     * Returns false if the timer already expired or was cancelled.
+     */
+    bool cancel(handle_type Handle)
+    {
+        if (contains(Handle))
+        {
+            _private_unlink(Handle.m_Index);
+            _private_deallocate_node(Handle.m_Index);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Advances the wheel to the tick Now and writes the values of expired timers to Out, at most
+     * MaxCount of them. Returns the number of values written. If that equals MaxCount, further
+     * timers may be due; the next call continues with them before advancing any further.
+     */
+    template <class OutputIt>
+    size_type advance(tick_type Now, OutputIt Out, size_type MaxCount)
+    {
+        size_type Count = 0;
+        for (;;)
+        {
+            node_index_type& Due = m_Buckets[static_cast<size_type>(m_Now & (SlotCount - 1))];
+            while ((0 != Due) and (Count < MaxCount))
+            {
+                node_index_type Index = Due - 1;
+                *Out = m_Nodes[Index].m_Value;
+                ++Out;
+                ++Count;
+                _private_unlink(Index);
+                _private_deallocate_node(Index);
+            }
+            if ((0 != Due) or not (m_Now < Now))
+            {
+                return Count;
+            }
+            _private_tick(Now);
+        }
+    }
+
+    /**
+     * Cancels all timers.
+     */
+    void clear() CCC_NOEXCEPT
+    {
+        for (size_type Bucket = 0; Bucket < BucketCount; ++Bucket)
+        {
+            for (node_index_type Next = m_Buckets[Bucket]; 0 != Next; Next = m_Nodes[Next - 1].m_Next)
+            {
+                m_Nodes[Next - 1].m_Generation = m_Nodes[Next - 1].m_Generation + 1;
+            }
+            m_Buckets[Bucket] = 0;
+        }
+        for (unsigned int Level = 0; Level < Levels; ++Level)
+        {
+            m_LevelSizes[Level] = 0;
+        }
+        m_Deallocated.clear();
+        m_Size = 0;
+    }
+
+    // Private methods:
+
+    // Assumes there are free nodes
+    node_index_type _private_allocate_node()
+    {
+        node_index_type Allocated;
+        if (not m_Deallocated.empty())
+        {
+            // Prefer a node, that was already used
+            Allocated = m_Deallocated.back();
+            m_Deallocated.pop_back();
+        }
+        else
+        {
+            // all nodes in [0, size()) are in use
+            Allocated = size();
+        }
+        return Allocated;
+    }
+
+    void _private_deallocate_node(node_index_type Index)
+    {
+        m_Nodes[Index].m_Generation = m_Nodes[Index].m_Generation + 1;
+        m_Deallocated.push_back(Index);
+        m_Size = m_Size - 1;
+    }
+
+    unsigned int _private_level(tick_type Deadline) const
+    {
+        tick_type Difference = Deadline ^ m_Now;
+        unsigned int Level = 0;
+        while ((Level + 1 < Levels) and (0 != (Difference >> (SlotBits * (Level + 1)))))
+        {
+            ++Level;
+        }
+        return Level;
+    }
+
+    void _private_link(node_index_type Index)
+    {
+        node_type& Node = m_Nodes[Index];
+        unsigned int Level = _private_level(Node.m_Deadline);
+        Node.m_Bucket = static_cast<size_type>((Level << SlotBits) + ((Node.m_Deadline >> (SlotBits * Level)) & (SlotCount - 1)));
+        Node.m_Prev = 0;
+        Node.m_Next = m_Buckets[Node.m_Bucket];
+        if (0 != Node.m_Next)
+        {
+            m_Nodes[Node.m_Next - 1].m_Prev = Index + 1;
+        }
+        m_Buckets[Node.m_Bucket] = Index + 1;
+        m_LevelSizes[Level] = m_LevelSizes[Level] + 1;
+    }
+
+    void _private_unlink(node_index_type Index)
+    {
+        node_type& Node = m_Nodes[Index];
+        if (0 != Node.m_Prev)
+        {
+            m_Nodes[Node.m_Prev - 1].m_Next = Node.m_Next;
+        }
+        else
+        {
+            m_Buckets[Node.m_Bucket] = Node.m_Next;
+        }
+        if (0 != Node.m_Next)
+        {
+            m_Nodes[Node.m_Next - 1].m_Prev = Node.m_Prev;
+        }
+        size_type Level = Node.m_Bucket >> SlotBits;
+        m_LevelSizes[Level] = m_LevelSizes[Level] - 1;
+    }
+
+    void _private_cascade(unsigned int Level)
+    {
+        size_type Bucket = static_cast<size_type>((Level << SlotBits) + ((m_Now >> (SlotBits * Level)) & (SlotCount - 1)));
+        node_index_type Next = m_Buckets[Bucket];
+        m_Buckets[Bucket] = 0;
+        while (0 != Next)
+        {
+            node_index_type Index = Next - 1;
+            Next = m_Nodes[Index].m_Next;
+            if (0 != Next)
+            {
+                CCC_PREFETCH(&m_Nodes[Next - 1]); // overlaps the chain walk with linking the node
+            }
+            m_LevelSizes[Level] = m_LevelSizes[Level] - 1;
+            _private_link(Index);
+        }
+    }
+
+    /**
+     * Moves to the next tick at which a timer may expire or cascade, but not beyond Now, and
+     * cascades the slots the new tick enters.
+     */
+    void _private_tick(tick_type Now)
+    {
+        unsigned int EmptyLevels = 0;
+        while ((EmptyLevels < Levels) and (0 == m_LevelSizes[EmptyLevels]))
+        {
+            ++EmptyLevels;
+        }
+        tick_type Next = m_Now + 1;
+        if (EmptyLevels == Levels)
+        {
+            Next = Now;
+        }
+        else if (EmptyLevels > 0)
+        {
+            // none of the levels below can cascade into level 0 before the next slot of this level
+            unsigned int Shift = SlotBits * EmptyLevels;
+            tick_type Boundary = ((m_Now >> Shift) + 1) << Shift;
+            Next = (Boundary < Now) ? Boundary : Now;
+        }
+        m_Now = Next;
+        for (unsigned int Level = Levels - 1; Level > 0; --Level)
+        {
+            if (0 == (m_Now & ((static_cast<tick_type>(1) << (SlotBits * Level)) - 1)))
+            {
+                _private_cascade(Level);
+            }
+        }
+    }
+};
+
+template <class T, class SizeType, SizeType Capacity, class TickType, unsigned int SlotBits, unsigned int Levels,
+        unsigned int Alignment, bool Runtime>
+const SizeType PodTimingWheel<T, SizeType, Capacity, TickType, SlotBits, Levels, Alignment, Runtime>::SlotCount;
+
+template <class T, class SizeType, SizeType Capacity, class TickType, unsigned int SlotBits, unsigned int Levels,
+        unsigned int Alignment, bool Runtime>
+const SizeType PodTimingWheel<T, SizeType, Capacity, TickType, SlotBits, Levels, Alignment, Runtime>::BucketCount;
+
+#pragma pack(pop)
+
+}
+
+#endif /* CCC_POD_TIMING_WHEEL_H_ */
@@ -24,6 +24,7 @@
 #include <ccc/alignment.h>
 #include <ccc/algorithm.h>
 #include <ccc/storage.h>
+#include <ccc/container_stats.h>
 
 namespace ccc
 {
@@ -72,6 +73,7 @@ struct PodVector
         clear();
         m_Storage.construct_and_assign(begin(), Count, Value);
         m_End = m_End + Count;
+        CCC_CONTAINER_STATS_RECORD(ContainerAssign);
     }
 
     template <typename IteratorType>
@@ -80,6 +82,7 @@ struct PodVector
         clear();
         m_Storage.construct_and_assign(begin(), First, Last);
         m_End = m_End + static_cast<size_type>(std::distance(First, Last));
+        CCC_CONTAINER_STATS_RECORD(ContainerAssign);
     }
 
     reference operator[](size_type Position)
@@ -227,13 +230,14 @@ struct PodVector
 
     size_type capacity() const CCC_NOEXCEPT
     {
-        return m_Storage.max_size();
+        return m_Storage.capacity();
     }
 
     void clear() CCC_NOEXCEPT
     {
         m_Storage.destroy(begin(), end());
         m_End = 0;
+        CCC_CONTAINER_STATS_RECORD(ContainerClear);
     }
 
     iterator insert(const_iterator Position, value_type const& Value)
@@ -244,10 +248,12 @@ struct PodVector
             ccc::move_backward(const_cast<pointer>(Position), end(), end() + 1, UseRawMemOpsType());
             m_End = m_End + 1;
             *const_cast<pointer>(Position) = Value;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
             return iterator(const_cast<pointer>(Position));
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -262,10 +268,12 @@ struct PodVector
             ccc::move_backward(const_cast<pointer>(Position), end(), end() + Count, UseRawMemOpsType());
             std::copy(First, Last, const_cast<pointer>(Position));
             m_End = m_End + Count;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
             return iterator(const_cast<pointer>(Position));
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -278,10 +286,12 @@ struct PodVector
             ccc::move_backward(const_cast<pointer>(Position), end(), end() + Count, UseRawMemOpsType());
             std::fill(const_cast<pointer>(Position), const_cast<pointer>(Position) + Count, Value);
             m_End = m_End + Count;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
             return iterator(const_cast<pointer>(Position));
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -291,6 +301,7 @@ struct PodVector
         ccc::move(const_cast<pointer>(Position) + 1, end(), const_cast<pointer>(Position), UseRawMemOpsType());
         m_End = m_End - 1;
         m_Storage.destroy(end());
+        CCC_CONTAINER_STATS_RECORD(ContainerErase);
         return const_cast<pointer>(Position);
     }
 
@@ -301,6 +312,7 @@ struct PodVector
             ccc::move(const_cast<pointer>(Last), end(), const_cast<pointer>(First), UseRawMemOpsType());
             m_End = static_cast<size_type>(m_End - std::distance(First, Last));
             m_Storage.destroy(end(), end() + std::distance(First, Last));
+            CCC_CONTAINER_STATS_RECORD(ContainerErase);
         }
         return const_cast<pointer>(First);
     }
@@ -311,9 +323,11 @@ struct PodVector
         {
             m_Storage.construct_and_assign(end(), Value);
             m_End = m_End + 1;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
         }
         else
         {
+            CCC_CONTAINER_STATS_OVERFLOW();
             throw std::bad_alloc();
         }
     }
@@ -324,6 +338,7 @@ struct PodVector
         {
             m_End = m_End - 1;
             m_Storage.destroy(end());
+            CCC_CONTAINER_STATS_RECORD(ContainerErase);
         }
     }
 
@@ -333,15 +348,18 @@ struct PodVector
         {
             m_End = Count;
             m_Storage.destroy(end(), end() + Count);
+            CCC_CONTAINER_STATS_RECORD(ContainerErase);
         }
         else if (Count > size())
         {
             if (Count > max_size())
             {
+                CCC_CONTAINER_STATS_OVERFLOW();
                 throw std::bad_alloc();
             }
             m_Storage.construct_default(end(), Count - size());
             m_End = Count;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
         }
     }
 
@@ -351,15 +369,18 @@ struct PodVector
         {
             m_End = Count;
             m_Storage.destroy(end(), end() + Count);
+            CCC_CONTAINER_STATS_RECORD(ContainerErase);
         }
         else if (Count > size())
         {
             if (Count > max_size())
             {
+                CCC_CONTAINER_STATS_OVERFLOW();
                 throw std::bad_alloc();
             }
             m_Storage.construct_and_assign(end(), Count - size(), Value);
             m_End = Count;
+            CCC_CONTAINER_STATS_RECORD(ContainerInsert);
         }
     }
 
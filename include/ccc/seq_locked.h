@@ -0,0 +1,126 @@
+/**
+ *
+ * @file This file contains the SeqLocked wrapper, which lets many readers copy a container modified by a single writer.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_SEQ_LOCKED_H_
+#define CCC_SEQ_LOCKED_H_
+
+#include <cstring>
+#include <stdint.h>
+
+#include <ccc/compat.h>
+#include <ccc/atomic.h>
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Protects a small container with static storage by a sequence lock.
+ *
+ * The writer increments the sequence before and after each modification, so it is odd while the
+ * container is being modified. Readers copy the container bytewise and retry if the sequence was odd
+ * or changed meanwhile; they never block the writer and never write shared memory. This pays off for
+ * containers, which are small enough to be copied on each read (a few cache lines).
+ *
+ * The sequence resides on its own cache line if the wrapper is 64 byte aligned, as in a SharedContainer.
+ * The wrapper consists of plain data, so it can be placed in shared memory; the container has to be
+ * bytewise copyable. Writers have to be serialized by the user.
+ */
+template <class Container>
+class SeqLocked
+{
+public:
+    typedef Container container_type;
+    typedef typename Container::value_type value_type;
+    typedef typename Container::size_type size_type;
+
+    SeqLocked()
+            : m_Sequence(0)
+    {
+    }
+
+    /**
+     * Calls Function(container_type&) as one atomic modification.
+     */
+    template <class Modifier>
+    void write(Modifier Function)
+    {
+        atomic_store(m_Sequence, m_Sequence + 1);
+        Function(m_Container);
+        atomic_store(m_Sequence, m_Sequence + 1);
+    }
+
+    /**
+     * Copies a consistent state of the container to Copy.
+     */
+    void read_copy(container_type& Copy) const
+    {
+        for (unsigned int Iteration = 0;; ++Iteration)
+        {
+            const uint32_t Before = atomic_load(m_Sequence);
+            if (0 == (Before & 1))
+            {
+                std::memcpy(static_cast<void*>(&Copy), const_cast<const container_type*>(&m_Container), sizeof(container_type));
+                atomic_thread_fence(); // atomic_load only fences after its load, the copy must complete before it
+                if (atomic_load(m_Sequence) == Before)
+                {
+                    return;
+                }
+            }
+            spin_wait(Iteration);
+        }
+    }
+
+    container_type read_copy() const
+    {
+        container_type Copy;
+        read_copy(Copy);
+        return Copy;
+    }
+
+    /**
+     * Calls Function(const container_type&) on a consistent copy of the container.
+     */
+    template <class ReaderFunction>
+    void read(ReaderFunction Function) const
+    {
+        container_type Copy;
+        read_copy(Copy);
+        Function(static_cast<const container_type&>(Copy));
+    }
+
+    /**
+     * Even while no modification is in progress; the number of modifications is sequence() / 2.
+     */
+    uint32_t sequence() const
+    {
+        return atomic_load(m_Sequence);
+    }
+
+    size_type max_size() const
+    {
+        return m_Container.max_size();
+    }
+
+private:
+    SeqLocked(SeqLocked const&);
+    void operator=(SeqLocked const&);
+
+    volatile uint32_t m_Sequence;
+    char m_Padding[64 - sizeof(uint32_t)]; // keeps the container off the cache line of the sequence
+    container_type m_Container;
+};
+
+#pragma pack(pop)
+
+}
+
+#endif /* CCC_SEQ_LOCKED_H_ */
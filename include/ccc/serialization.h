@@ -0,0 +1,336 @@
+/**
+ *
+ * @file This file contains functions to serialize the live elements of containers into compact buffers.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_SERIALIZATION_H_
+#define CCC_SERIALIZATION_H_
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <stdint.h>
+
+#include <sys/uio.h>
+
+#include <ccc/compat.h>
+#include <ccc/pod_vector.h>
+#include <ccc/pod_deque.h>
+#include <ccc/pod_list.h>
+
+/*
+ * In contrast to a snapshot (see snapshot.h) a serialized container consists only of a
+ * SerializationHeader followed by its elements in container order, so the size is proportional to
+ * the number of elements and not to the capacity. The unused part of a vector, the dead part of the
+ * ring of a deque and the free nodes and links of a list are not written; a deserialized list stores
+ * its elements contiguously in list order.
+ *
+ * The elements are copied with memcpy, so T has to be trivially copyable. The format is the native
+ * one of the machine (byte order, sizeof(T)), so it is meant for exchanging data between processes of
+ * the same binary, e.g. for replicating a container to a standby process over a local socket.
+ *
+ * The functions take the Pod* base, so they accept the Consistent*, Static* and Fixed* variants as
+ * well. deserialize() requires a valid (e.g. constructed) container, whose content it replaces.
+ */
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Precedes the elements of a serialized container.
+ */
+struct SerializationHeader
+{
+    uint64_t m_Count; // number of elements following the header
+    uint64_t m_ValueSize; // sizeof(T) of the writer
+};
+
+#pragma pack(pop)
+
+inline SerializationHeader make_serialization_header(std::size_t Count, std::size_t ValueSize)
+{
+    SerializationHeader Header;
+    Header.m_Count = Count;
+    Header.m_ValueSize = ValueSize;
+    return Header;
+}
+
+inline char* _private_serialize_bytes(char* Out, const void* Data, std::size_t Size)
+{
+    if (Size > 0)
+    {
+        std::memcpy(Out, Data, Size);
+    }
+    return Out + Size;
+}
+
+inline void _private_add_iovec(struct iovec* Out, std::size_t OutCount, std::size_t& Count, const void* Data, std::size_t Size)
+{
+    if (0 == Size)
+    {
+        return;
+    }
+    if (Count < OutCount)
+    {
+        Out[Count].iov_base = const_cast<void*>(Data);
+        Out[Count].iov_len = Size;
+    }
+    ++Count;
+}
+
+/**
+ * Reads the header at In and returns the number of elements following it. Throws
+ * std::runtime_error if the buffer is too small or was written for another value size, and
+ * std::bad_alloc if the elements exceed MaxSize.
+ */
+template <class T>
+std::size_t _private_deserialize_header(const char* In, const char* End, std::size_t MaxSize)
+{
+    if (static_cast<std::size_t>(End - In) < sizeof(SerializationHeader))
+    {
+        throw std::runtime_error("ccc::deserialize: truncated header");
+    }
+    SerializationHeader Header;
+    std::memcpy(&Header, In, sizeof(Header));
+    if (Header.m_ValueSize != sizeof(T))
+    {
+        throw std::runtime_error("ccc::deserialize: value size mismatch");
+    }
+    if (Header.m_Count > MaxSize)
+    {
+        throw std::bad_alloc();
+    }
+    if (static_cast<std::size_t>(End - In - sizeof(Header)) / sizeof(T) < Header.m_Count)
+    {
+        throw std::runtime_error("ccc::deserialize: truncated elements");
+    }
+    return static_cast<std::size_t>(Header.m_Count);
+}
+
+// PodVector
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+std::size_t serialized_size(const PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Vector)
+{
+    return sizeof(SerializationHeader) + Vector.size() * sizeof(T);
+}
+
+/**
+ * Writes Vector to Out, which has to provide serialized_size(Vector) bytes, and returns the end of
+ * the written data.
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+char* serialize(const PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Vector, char* Out)
+{
+    SerializationHeader Header = make_serialization_header(Vector.size(), sizeof(T));
+    Out = _private_serialize_bytes(Out, &Header, sizeof(Header));
+    return _private_serialize_bytes(Out, Vector.data(), Vector.size() * sizeof(T));
+}
+
+/**
+ * Writes at most OutCount iovecs to Out, which reference the header and the elements of Vector, and
+ * returns the number of iovecs required. Header and Vector have to outlive the iovecs.
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+std::size_t serialize_iovec(const PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Vector,
+        SerializationHeader& Header, struct iovec* Out, std::size_t OutCount)
+{
+    std::size_t Count = 0;
+    Header = make_serialization_header(Vector.size(), sizeof(T));
+    _private_add_iovec(Out, OutCount, Count, &Header, sizeof(Header));
+    _private_add_iovec(Out, OutCount, Count, Vector.data(), Vector.size() * sizeof(T));
+    return Count;
+}
+
+/**
+ * Replaces the content of Vector by the elements serialized in [In, End) and returns the end of the
+ * consumed data.
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+const char* deserialize(PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Vector,
+        const char* In, const char* End)
+{
+    const std::size_t Count = _private_deserialize_header<T>(In, End, Vector.max_size());
+    In += sizeof(SerializationHeader);
+    Vector.clear();
+    if (Count > 0)
+    {
+        std::memcpy(Vector.data(), In, Count * sizeof(T));
+    }
+    Vector.m_End = static_cast<SizeType>(Count);
+    return In + Count * sizeof(T);
+}
+
+// PodDeque
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+std::size_t serialized_size(const PodDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Deque)
+{
+    return sizeof(SerializationHeader) + Deque.size() * sizeof(T);
+}
+
+/**
+ * Writes the one or two live segments of the ring of Deque to Out (see serialize(PodVector)).
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+char* serialize(const PodDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Deque, char* Out)
+{
+    const std::size_t Begin = Deque.m_Begin;
+    const std::size_t End = Deque.m_End;
+    SerializationHeader Header = make_serialization_header(Deque.size(), sizeof(T));
+    Out = _private_serialize_bytes(Out, &Header, sizeof(Header));
+    if (Begin <= End)
+    {
+        return _private_serialize_bytes(Out, Deque.data(Begin), (End - Begin) * sizeof(T));
+    }
+    Out = _private_serialize_bytes(Out, Deque.data(Begin), (Deque.max_size() + 1 - Begin) * sizeof(T));
+    return _private_serialize_bytes(Out, Deque.data(0), End * sizeof(T));
+}
+
+/**
+ * Needs at most three iovecs (see serialize_iovec(PodVector)).
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+std::size_t serialize_iovec(const PodDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Deque,
+        SerializationHeader& Header, struct iovec* Out, std::size_t OutCount)
+{
+    const std::size_t Begin = Deque.m_Begin;
+    const std::size_t End = Deque.m_End;
+    std::size_t Count = 0;
+    Header = make_serialization_header(Deque.size(), sizeof(T));
+    _private_add_iovec(Out, OutCount, Count, &Header, sizeof(Header));
+    if (Begin <= End)
+    {
+        _private_add_iovec(Out, OutCount, Count, Deque.data(Begin), (End - Begin) * sizeof(T));
+    }
+    else
+    {
+        _private_add_iovec(Out, OutCount, Count, Deque.data(Begin), (Deque.max_size() + 1 - Begin) * sizeof(T));
+        _private_add_iovec(Out, OutCount, Count, Deque.data(0), End * sizeof(T));
+    }
+    return Count;
+}
+
+/**
+ * Stores the elements at the beginning of the ring (see deserialize(PodVector)).
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+const char* deserialize(PodDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Deque,
+        const char* In, const char* End)
+{
+    const std::size_t Count = _private_deserialize_header<T>(In, End, Deque.max_size());
+    In += sizeof(SerializationHeader);
+    Deque.clear();
+    if (Count > 0)
+    {
+        std::memcpy(Deque.data(0), In, Count * sizeof(T));
+    }
+    Deque.m_End = static_cast<SizeType>(Count);
+    return In + Count * sizeof(T);
+}
+
+// PodList
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool Uninitialized, bool Runtime>
+std::size_t serialized_size(const PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime>& List)
+{
+    return sizeof(SerializationHeader) + List.size() * sizeof(T);
+}
+
+/**
+ * Writes the values of List in list order to Out (see serialize(PodVector)). Runs of nodes, which
+ * are adjacent in the storage, are copied at once.
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool Uninitialized, bool Runtime>
+char* serialize(const PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime>& List, char* Out)
+{
+    typedef PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime> list_type;
+    SerializationHeader Header = make_serialization_header(List.size(), sizeof(T));
+    Out = _private_serialize_bytes(Out, &Header, sizeof(Header));
+    SizeType Node = List.m_Nodes[list_type::m_Anchor].m_Next;
+    while (list_type::m_Anchor != Node)
+    {
+        SizeType RunEnd = Node;
+        while (List.m_Nodes[RunEnd].m_Next == RunEnd + 1)
+        {
+            ++RunEnd;
+        }
+        Out = _private_serialize_bytes(Out, ccc::addressof(List.m_Values[Node - 1]), (RunEnd - Node + 1) * sizeof(T));
+        Node = List.m_Nodes[RunEnd].m_Next;
+    }
+    return Out;
+}
+
+/**
+ * Needs one iovec for the header and one for each run of adjacent nodes (see
+ * serialize_iovec(PodVector)), i.e. two if the list was filled by push_back() only.
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool Uninitialized, bool Runtime>
+std::size_t serialize_iovec(const PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime>& List,
+        SerializationHeader& Header, struct iovec* Out, std::size_t OutCount)
+{
+    typedef PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime> list_type;
+    std::size_t Count = 0;
+    Header = make_serialization_header(List.size(), sizeof(T));
+    _private_add_iovec(Out, OutCount, Count, &Header, sizeof(Header));
+    SizeType Node = List.m_Nodes[list_type::m_Anchor].m_Next;
+    while (list_type::m_Anchor != Node)
+    {
+        SizeType RunEnd = Node;
+        while (List.m_Nodes[RunEnd].m_Next == RunEnd + 1)
+        {
+            ++RunEnd;
+        }
+        _private_add_iovec(Out, OutCount, Count, ccc::addressof(List.m_Values[Node - 1]), (RunEnd - Node + 1) * sizeof(T));
+        Node = List.m_Nodes[RunEnd].m_Next;
+    }
+    return Count;
+}
+
+/**
+ * Links the first Count nodes of the cleared List in order, whose values were stored already.
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool Uninitialized, bool Runtime>
+void _private_link_list_contiguously(PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime>& List, std::size_t Count)
+{
+    typedef PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime> list_type;
+    for (std::size_t Node = 1; Node <= Count; ++Node)
+    {
+        List.m_Nodes[Node].m_Prev = static_cast<SizeType>(Node - 1);
+        List.m_Nodes[Node].m_Next = static_cast<SizeType>((Node == Count) ? list_type::m_Anchor : Node + 1);
+    }
+    List.m_Nodes[list_type::m_Anchor].m_Next = static_cast<SizeType>((Count > 0) ? 1 : list_type::m_Anchor);
+    List.m_Nodes[list_type::m_Anchor].m_Prev = static_cast<SizeType>(Count);
+    List.m_Size = static_cast<SizeType>(Count);
+}
+
+/**
+ * Stores the elements in the first nodes and links them in order, so that a following serialize()
+ * copies them at once (see deserialize(PodVector)).
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool Uninitialized, bool Runtime>
+const char* deserialize(PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime>& List, const char* In,
+        const char* End)
+{
+    const std::size_t Count = _private_deserialize_header<T>(In, End, List.max_size());
+    In += sizeof(SerializationHeader);
+    List.clear();
+    if (Count > 0)
+    {
+        std::memcpy(ccc::addressof(List.m_Values[0]), In, Count * sizeof(T));
+    }
+    _private_link_list_contiguously(List, Count);
+    return In + Count * sizeof(T);
+}
+
+}
+
+#endif /* CCC_SERIALIZATION_H_ */
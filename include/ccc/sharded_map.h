@@ -0,0 +1,301 @@
+/**
+ *
+ * @file This file contains the ShardedMap, which splits a hash map into independently locked shards.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_SHARDED_MAP_H_
+#define CCC_SHARDED_MAP_H_
+
+#include <ciso646>
+#include <cstddef>
+#include <utility>
+#include <stdint.h>
+
+#include <ccc/compat.h>
+#include <ccc/alignment.h>
+#include <ccc/atomic.h>
+#include <ccc/pod_hash_map.h>
+
+namespace ccc
+{
+
+// default packing, since #pragma pack(16) would cap the 64 byte alignment of the shards
+#pragma pack(push)
+#pragma pack()
+
+/**
+ * @brief Concurrent hash map consisting of ShardCount maps with static storage, each guarded by its own spinlock.
+ *
+ * A key belongs to the shard selected by the upper 32 bits of its hash, while the map of the shard
+ * uses the lower 32 bits (see PodHashMap), so both choices are independent. Each shard is padded to a
+ * multiple of 64 bytes and the shards are 64 byte aligned, so they do not share cache lines (for
+ * objects on the heap this requires an allocator honoring the alignment, e.g. new since C++17).
+ *
+ * Since the lock of a shard is only held inside the member functions, values are copied in and out.
+ * The batched functions sort their keys by shard and lock each shard once per batch of up to
+ * batch_size keys, which amortizes the locking and lets the lookups of a shard overlap their cache
+ * misses.
+ *
+ * The object consists of plain data only, so it can be placed in shared memory as well.
+ */
+template <class Map, unsigned int ShardCount>
+class ShardedMap
+{
+public:
+    typedef Map map_type;
+    typedef typename map_type::key_type key_type;
+    typedef typename map_type::mapped_type mapped_type;
+    typedef typename map_type::value_type value_type;
+    typedef typename map_type::size_type size_type;
+    typedef typename map_type::hasher hasher;
+
+    static const unsigned int shard_count = ShardCount;
+    static const unsigned int batch_size = 64;
+
+    ShardedMap()
+    {
+        CCC_STATIC_ASSERT(0 == sizeof(Shard) % 64, "shards have to fill whole cache lines");
+        CCC_STATIC_ASSERT(0 == CCC_ALIGNOF(ShardedMap) % 64, "shards have to start on a cache line");
+        for (unsigned int i = 0; i < ShardCount; ++i)
+        {
+            m_Shards[i].Data.m_Lock = 0;
+            m_Shards[i].Data.m_Map.clear();
+        }
+    }
+
+    /**
+     * Returns the shard Key belongs to.
+     */
+    unsigned int shard(const key_type& Key) const
+    {
+        return static_cast<unsigned int>(((hasher()(Key) >> 32) * ShardCount) >> 32);
+    }
+
+    /**
+     * Copies the value mapped to Key to Value. Returns false if the key is not contained.
+     */
+    bool find(const key_type& Key, mapped_type& Value) const
+    {
+        const LockedMap& S = m_Shards[shard(Key)].Data;
+        LockGuard Guard(S.m_Lock);
+        typename map_type::const_iterator Position = S.m_Map.find(Key);
+        if (Position == S.m_Map.end())
+        {
+            return false;
+        }
+        Value = Position->second;
+        return true;
+    }
+
+    /**
+     * Returns false if the key was already contained. Throws std::bad_alloc if the shard is full.
+     */
+    bool insert(const value_type& Value)
+    {
+        LockedMap& S = m_Shards[shard(Value.first)].Data;
+        LockGuard Guard(S.m_Lock);
+        return S.m_Map.insert(Value).second;
+    }
+
+    /**
+     * Returns false if the key was already contained, whose value is replaced then. Throws std::bad_alloc
+     * if the shard is full.
+     */
+    bool insert_or_assign(const value_type& Value)
+    {
+        LockedMap& S = m_Shards[shard(Value.first)].Data;
+        LockGuard Guard(S.m_Lock);
+        std::pair<typename map_type::iterator, bool> Result = S.m_Map.insert(Value);
+        if (not Result.second)
+        {
+            Result.first->second = Value.second;
+        }
+        return Result.second;
+    }
+
+    size_type erase(const key_type& Key)
+    {
+        LockedMap& S = m_Shards[shard(Key)].Data;
+        LockGuard Guard(S.m_Lock);
+        return S.m_Map.erase(Key);
+    }
+
+    /**
+     * Looks up Keys[i] for i in [0, Count). Sets Found[i] and, if the key is contained, Values[i].
+     * Returns the number of keys found.
+     */
+    size_type find_many(const key_type* Keys, size_type Count, mapped_type* Values, bool* Found) const
+    {
+        size_type Result = 0;
+        for (size_type First = 0; First < Count; First += batch_size)
+        {
+            const unsigned int BatchCount = static_cast<unsigned int>(((Count - First) < batch_size) ? (Count - First) : batch_size);
+            Batch B;
+            for (unsigned int i = 0; i < BatchCount; ++i)
+            {
+                B.m_Shard[i] = shard(Keys[First + i]);
+                m_Shards[B.m_Shard[i]].Data.m_Map.prefetch(Keys[First + i]);
+            }
+            B.sort(BatchCount);
+            for (unsigned int Begin = 0, End = 0; Begin < BatchCount; Begin = End)
+            {
+                const LockedMap& S = m_Shards[B.m_Shard[B.m_Order[Begin]]].Data;
+                End = B.group_end(Begin, BatchCount);
+                LockGuard Guard(S.m_Lock);
+                for (unsigned int j = Begin; j < End; ++j)
+                {
+                    const size_type i = First + B.m_Order[j];
+                    typename map_type::const_iterator Position = S.m_Map.find(Keys[i]);
+                    Found[i] = (Position != S.m_Map.end());
+                    if (Found[i])
+                    {
+                        Values[i] = Position->second;
+                        ++Result;
+                    }
+                }
+            }
+        }
+        return Result;
+    }
+
+    /**
+     * Inserts Elements[i] for i in [0, Count) unless its key is already contained. Returns the number of
+     * inserted elements. Throws std::bad_alloc if a shard is full; elements of other shards or of
+     * preceding batches may have been inserted then.
+     */
+    size_type insert_many(const value_type* Elements, size_type Count)
+    {
+        size_type Result = 0;
+        for (size_type First = 0; First < Count; First += batch_size)
+        {
+            const unsigned int BatchCount = static_cast<unsigned int>(((Count - First) < batch_size) ? (Count - First) : batch_size);
+            Batch B;
+            for (unsigned int i = 0; i < BatchCount; ++i)
+            {
+                B.m_Shard[i] = shard(Elements[First + i].first);
+            }
+            B.sort(BatchCount);
+            for (unsigned int Begin = 0, End = 0; Begin < BatchCount; Begin = End)
+            {
+                LockedMap& S = m_Shards[B.m_Shard[B.m_Order[Begin]]].Data;
+                End = B.group_end(Begin, BatchCount);
+                LockGuard Guard(S.m_Lock);
+                for (unsigned int j = Begin; j < End; ++j)
+                {
+                    if (S.m_Map.insert(Elements[First + B.m_Order[j]]).second)
+                    {
+                        ++Result;
+                    }
+                }
+            }
+        }
+        return Result;
+    }
+
+    /**
+     * Sum of the sizes of the shards, which are locked one after another; thus concurrent modifications
+     * make the result approximate.
+     */
+    std::size_t size() const
+    {
+        std::size_t Result = 0;
+        for (unsigned int i = 0; i < ShardCount; ++i)
+        {
+            LockGuard Guard(m_Shards[i].Data.m_Lock);
+            Result += m_Shards[i].Data.m_Map.size();
+        }
+        return Result;
+    }
+
+    void clear()
+    {
+        for (unsigned int i = 0; i < ShardCount; ++i)
+        {
+            LockGuard Guard(m_Shards[i].Data.m_Lock);
+            m_Shards[i].Data.m_Map.clear();
+        }
+    }
+
+private:
+    ShardedMap(ShardedMap const&);
+    void operator=(ShardedMap const&);
+
+    class LockGuard
+    {
+    public:
+        explicit LockGuard(volatile uint32_t& Lock)
+                : m_Lock(Lock)
+        {
+            spin_lock(m_Lock);
+        }
+
+        ~LockGuard()
+        {
+            spin_unlock(m_Lock);
+        }
+
+    private:
+        LockGuard(LockGuard const&);
+        void operator=(LockGuard const&);
+
+        volatile uint32_t& m_Lock;
+    };
+
+    /**
+     * Indices of up to batch_size keys, sorted by shard (counting sort).
+     */
+    struct Batch
+    {
+        unsigned int m_Shard[batch_size];
+        unsigned int m_Order[batch_size];
+
+        void sort(unsigned int Count)
+        {
+            unsigned int Begin[ShardCount + 1] = {};
+            for (unsigned int i = 0; i < Count; ++i)
+            {
+                ++Begin[m_Shard[i] + 1];
+            }
+            for (unsigned int s = 0; s < ShardCount; ++s)
+            {
+                Begin[s + 1] += Begin[s];
+            }
+            for (unsigned int i = 0; i < Count; ++i)
+            {
+                m_Order[Begin[m_Shard[i]]++] = i;
+            }
+        }
+
+        // End of the group of indices of the same shard starting at Begin
+        unsigned int group_end(unsigned int Begin, unsigned int Count) const
+        {
+            unsigned int End = Begin + 1;
+            while ((End < Count) and (m_Shard[m_Order[End]] == m_Shard[m_Order[Begin]]))
+            {
+                ++End;
+            }
+            return End;
+        }
+    };
+
+    struct LockedMap
+    {
+        mutable volatile uint32_t m_Lock;
+        map_type m_Map;
+    };
+
+    typedef Padded<LockedMap, 64> Shard; // keeps the shards on separate cache lines
+
+    CCC_ALIGNED(Shard, 64) m_Shards[ShardCount];
+};
+
+#pragma pack(pop)
+
+}
+
+#endif /* CCC_SHARDED_MAP_H_ */
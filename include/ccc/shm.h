@@ -0,0 +1,240 @@
+/**
+ *
+ * @file This file contains the SharedContainer, which places a container in POSIX shared memory.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_SHM_H_
+#define CCC_SHM_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ccc/compat.h>
+#include <ccc/layout_header.h>
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Header in front of a container in shared memory.
+ */
+struct SharedRegionHeader
+{
+    LayoutHeader m_Layout;
+    volatile uint32_t m_Ready; // set once the creator constructed the container
+};
+
+#pragma pack(pop)
+
+struct SharedMemoryMode
+{
+    enum EnumType
+    {
+        Create, // fails if the region exists
+        Attach // fails if the region does not exist or holds a different layout
+    };
+};
+
+/**
+ * @brief Maps a named POSIX shared memory region holding a container and its layout header.
+ *
+ * The creating process constructs the container in the region; attaching processes validate the
+ * header against the layout of Container and throw std::runtime_error on any mismatch. The region
+ * outlives the SharedContainer objects until remove() is called; the destructor only unmaps it and
+ * never destroys the container.
+ *
+ * Only containers with static storage can be shared, since the Fixed* containers point into the heap
+ * of their process. Synchronizing the processes accessing the container is up to the user.
+ */
+template <class Container>
+class SharedContainer
+{
+public:
+    typedef Container container_type;
+
+    static const char* magic()
+    {
+        return "ccc.shm";
+    }
+
+    SharedContainer(const std::string& Name, typename SharedMemoryMode::EnumType Mode)
+            : m_Address(MAP_FAILED), m_Length(0), m_Container(0)
+    {
+        try
+        {
+            if (SharedMemoryMode::Create == Mode)
+            {
+                Create(Name);
+            }
+            else
+            {
+                Attach(Name);
+            }
+        }
+        catch (...)
+        {
+            if (MAP_FAILED != m_Address)
+            {
+                ::munmap(m_Address, m_Length);
+            }
+            throw;
+        }
+    }
+
+    ~SharedContainer()
+    {
+        if (MAP_FAILED != m_Address)
+        {
+            ::munmap(m_Address, m_Length);
+        }
+    }
+
+    container_type& operator*()
+    {
+        return *m_Container;
+    }
+
+    container_type* operator->()
+    {
+        return m_Container;
+    }
+
+    container_type* get()
+    {
+        return m_Container;
+    }
+
+    const SharedRegionHeader& header() const
+    {
+        return *static_cast<const SharedRegionHeader*>(m_Address);
+    }
+
+    /**
+     * Removes the name of the region. Processes that mapped the region keep using it until they
+     * unmap it. Returns false if there was no region of that name.
+     */
+    static bool remove(const std::string& Name)
+    {
+        return 0 == ::shm_unlink(Name.c_str());
+    }
+
+    static std::size_t payload_offset()
+    {
+        const std::size_t Alignment = (CCC_ALIGNOF(container_type) > 64) ? CCC_ALIGNOF(container_type) : 64;
+        return (sizeof(SharedRegionHeader) + Alignment - 1) / Alignment * Alignment;
+    }
+
+private:
+    SharedContainer(SharedContainer const&);
+    void operator=(SharedContainer const&);
+
+    static void Fail(const std::string& What, const std::string& Name)
+    {
+        throw std::runtime_error("ccc::SharedContainer: " + What + " '" + Name + "': " + std::strerror(errno));
+    }
+
+    void Map(int Fd, const std::string& Name)
+    {
+        m_Address = ::mmap(0, m_Length, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+        int MapErrno = errno;
+        ::close(Fd);
+        if (MAP_FAILED == m_Address)
+        {
+            errno = MapErrno;
+            Fail("mmap failed for", Name);
+        }
+    }
+
+    void Create(const std::string& Name)
+    {
+        int Fd = ::shm_open(Name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (Fd < 0)
+        {
+            Fail("cannot create", Name);
+        }
+        try
+        {
+            m_Length = payload_offset() + sizeof(container_type);
+            if (0 != ::ftruncate(Fd, static_cast<off_t>(m_Length)))
+            {
+                int TruncateErrno = errno;
+                ::close(Fd);
+                errno = TruncateErrno;
+                Fail("cannot resize", Name);
+            }
+            Map(Fd, Name);
+
+            SharedRegionHeader* Header = static_cast<SharedRegionHeader*>(m_Address);
+            m_Container = ::new (static_cast<char*>(m_Address) + payload_offset()) container_type();
+            Header->m_Layout = make_layout_header<container_type>(magic(), m_Container->max_size(), payload_offset(),
+                    sizeof(container_type));
+            __sync_synchronize(); // publish the container before the ready flag
+            Header->m_Ready = 1;
+        }
+        catch (...)
+        {
+            // the region was created by this call, so no other process can rely on it yet
+            ::shm_unlink(Name.c_str());
+            throw;
+        }
+    }
+
+    void Attach(const std::string& Name)
+    {
+        int Fd = ::shm_open(Name.c_str(), O_RDWR, 0600);
+        if (Fd < 0)
+        {
+            Fail("cannot open", Name);
+        }
+        struct stat Status;
+        if ((0 != ::fstat(Fd, &Status)) or (static_cast<std::size_t>(Status.st_size) < sizeof(SharedRegionHeader)))
+        {
+            ::close(Fd);
+            throw std::runtime_error("ccc::SharedContainer: region '" + Name + "' is too small to hold a header");
+        }
+        m_Length = static_cast<std::size_t>(Status.st_size);
+        Map(Fd, Name);
+
+        const SharedRegionHeader* Header = static_cast<const SharedRegionHeader*>(m_Address);
+        if (0 == Header->m_Ready)
+        {
+            throw std::runtime_error("ccc::SharedContainer: region '" + Name + "' is not initialized yet");
+        }
+        __sync_synchronize();
+        validate_layout_header<container_type>(Header->m_Layout, magic());
+        if ((Header->m_Layout.m_PayloadOffset != payload_offset())
+                or (m_Length < payload_offset() + sizeof(container_type)))
+        {
+            throw std::runtime_error("ccc::SharedContainer: region '" + Name + "' has an unexpected size");
+        }
+        m_Container = reinterpret_cast<container_type*>(static_cast<char*>(m_Address) + payload_offset());
+        if (Header->m_Layout.m_Capacity != m_Container->max_size())
+        {
+            throw std::runtime_error("ccc::SharedContainer: capacity mismatch in region '" + Name + "'");
+        }
+    }
+
+    void* m_Address;
+    std::size_t m_Length;
+    container_type* m_Container;
+};
+
+}
+
+#endif /* CCC_SHM_H_ */
@@ -0,0 +1,477 @@
+/**
+ *
+ * @file This file contains the SmallVector container.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_SMALL_VECTOR_H_
+#define CCC_SMALL_VECTOR_H_
+
+#include <ciso646>
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+#include <ccc/compat.h>
+#include <ccc/memory.h>
+#include <ccc/type_traits.h>
+#include <ccc/alignment.h>
+#include <ccc/algorithm.h>
+#include <ccc/storage.h>
+
+namespace ccc
+{
+
+/**
+ * @brief Vector that keeps up to N elements in place and spills to the free store beyond that.
+ *
+ * Elements live in a StaticUninitializedStorage as long as size() <= N. The first insertion
+ * exceeding N moves them into a FixedUninitializedStorage, which afterwards grows geometrically.
+ * The interface and the iterator types are those of PodVector.
+ *
+ * Constant time: inserting and erasing elements at the end (amortized once spilled); accessing random elements.
+ * Linear time: inserting and erasing elements elsewhere.
+ * Noncompliance: max_size() is the largest value of SizeType, not the available memory.
+ */
+template <typename T, unsigned int N, typename SizeType = unsigned int, unsigned int Alignment = 8, bool UseRawMemOps = false>
+class SmallVector
+{
+public:
+    typedef T value_type;
+    typedef SizeType size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    typedef typename ccc::integral_constant<bool, UseRawMemOps>::type UseRawMemOpsType;
+
+    typedef StaticUninitializedStorage<T, SizeType, N, Alignment> static_storage_type;
+    typedef FixedUninitializedStorage<T, SizeType, Alignment> fixed_storage_type;
+
+#if (CCC_ALIGNAS_AVAILABLE)
+    alignas(Alignment) size_type m_End;
+#elif CCC_ALIGNED_AVAILABLE
+    typename ccc::Aligned<size_type, Alignment>::type m_End;
+#else
+    PaddedValue<size_type, Alignment> m_End; // points at the element behind the last valid element
+#endif
+    static_storage_type m_StaticStorage;
+    fixed_storage_type m_FixedStorage; // holds the elements once spilled, unallocated before
+
+    SmallVector()
+    {
+        m_End = 0;
+    }
+
+    SmallVector(SmallVector const& Other)
+    {
+        m_End = 0;
+        assign(Other.begin(), Other.end());
+    }
+
+    SmallVector& operator=(SmallVector const& Other)
+    {
+        if (this != &Other)
+        {
+            assign(Other.begin(), Other.end());
+        }
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        clear();
+    }
+
+    // Assign:
+
+    void assign(size_type Count, value_type const& Value)
+    {
+        clear();
+        reserve(Count);
+        m_StaticStorage.construct_and_assign(begin(), Count, Value);
+        m_End = Count;
+    }
+
+    template <typename IteratorType>
+    void assign(IteratorType First, IteratorType Last)
+    {
+        clear();
+        reserve(static_cast<size_type>(std::distance(First, Last)));
+        m_StaticStorage.construct_and_assign(begin(), First, Last);
+        m_End = static_cast<size_type>(std::distance(First, Last));
+    }
+
+    // Element access:
+
+    reference operator[](size_type Position)
+    {
+        return data()[Position];
+    }
+
+    const_reference operator[](size_type Position) const
+    {
+        return data()[Position];
+    }
+
+    reference at(size_type Position)
+    {
+        if (Position >= size())
+        {
+            throw std::out_of_range("SmallVector::at");
+        }
+        return data()[Position];
+    }
+
+    const_reference at(size_type Position) const
+    {
+        if (Position >= size())
+        {
+            throw std::out_of_range("SmallVector::at");
+        }
+        return data()[Position];
+    }
+
+    reference front()
+    {
+        return *begin();
+    }
+
+    const_reference front() const
+    {
+        return *begin();
+    }
+
+    reference back()
+    {
+        return *(end() - 1);
+    }
+
+    const_reference back() const
+    {
+        return *(end() - 1);
+    }
+
+    pointer data() CCC_NOEXCEPT
+    {
+        return is_small() ? ccc::addressof(m_StaticStorage[0]) : ccc::addressof(m_FixedStorage[0]);
+    }
+
+    const_pointer data() const CCC_NOEXCEPT
+    {
+        return is_small() ? ccc::addressof(m_StaticStorage[0]) : ccc::addressof(m_FixedStorage[0]);
+    }
+
+    // Iterators:
+
+    iterator begin() CCC_NOEXCEPT
+    {
+        return iterator(data());
+    }
+
+    const_iterator begin() const CCC_NOEXCEPT
+    {
+        return const_iterator(data());
+    }
+
+    const_iterator cbegin() const CCC_NOEXCEPT
+    {
+        return const_iterator(data());
+    }
+
+    iterator end() CCC_NOEXCEPT
+    {
+        return iterator(data() + m_End);
+    }
+
+    const_iterator end() const CCC_NOEXCEPT
+    {
+        return const_iterator(data() + m_End);
+    }
+
+    const_iterator cend() const CCC_NOEXCEPT
+    {
+        return const_iterator(data() + m_End);
+    }
+
+    reverse_iterator rbegin() CCC_NOEXCEPT
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const CCC_NOEXCEPT
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator crbegin() const CCC_NOEXCEPT
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    reverse_iterator rend() CCC_NOEXCEPT
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const CCC_NOEXCEPT
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crend() const CCC_NOEXCEPT
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    // Capacity:
+
+    bool empty() const CCC_NOEXCEPT
+    {
+        return 0 == m_End;
+    }
+
+    size_type size() const CCC_NOEXCEPT
+    {
+        return m_End - 0;
+    }
+
+    size_type max_size() const CCC_NOEXCEPT
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    /**
+     * Returns true as long as the elements are kept in the static storage.
+     */
+    bool is_small() const CCC_NOEXCEPT
+    {
+        return 0 == m_FixedStorage.max_size();
+    }
+
+    size_type capacity() const CCC_NOEXCEPT
+    {
+        return is_small() ? static_cast<size_type>(N) : m_FixedStorage.max_size();
+    }
+
+    void reserve(size_type NewCapacity)
+    {
+        if (NewCapacity > capacity())
+        {
+            _private_reallocate(NewCapacity);
+        }
+    }
+
+    /**
+     * Moves the elements back into the static storage if they fit, otherwise releases unused
+     * capacity of the free store.
+     */
+    void shrink_to_fit()
+    {
+        if (not is_small() and (size() < capacity()))
+        {
+            _private_reallocate(size());
+        }
+    }
+
+    // Modifiers:
+
+    void clear() CCC_NOEXCEPT
+    {
+        m_StaticStorage.destroy(begin(), end());
+        m_End = 0;
+    }
+
+    iterator insert(const_iterator Position, value_type const& Value)
+    {
+        size_type Index = static_cast<size_type>(Position - begin());
+        value_type Copy(Value); // Value might refer to an element of this vector
+        _private_grow(1);
+        pointer Inserted = data() + Index;
+        m_StaticStorage.construct_default(end());
+        ccc::move_backward(Inserted, end(), end() + 1, UseRawMemOpsType());
+        m_End = m_End + 1;
+        *Inserted = Copy;
+        return iterator(Inserted);
+    }
+
+    template <typename IteratorType>
+    iterator insert(const_iterator Position, IteratorType First, IteratorType Last)
+    {
+        size_type Index = static_cast<size_type>(Position - begin());
+        difference_type Count = std::distance(First, Last);
+        _private_grow(static_cast<size_type>(Count));
+        pointer Inserted = data() + Index;
+        m_StaticStorage.construct_default(end(), static_cast<size_type>(Count));
+        ccc::move_backward(Inserted, end(), end() + Count, UseRawMemOpsType());
+        std::copy(First, Last, Inserted);
+        m_End = m_End + static_cast<size_type>(Count);
+        return iterator(Inserted);
+    }
+
+    iterator insert(const_iterator Position, size_type Count, value_type const& Value)
+    {
+        size_type Index = static_cast<size_type>(Position - begin());
+        value_type Copy(Value); // Value might refer to an element of this vector
+        _private_grow(Count);
+        pointer Inserted = data() + Index;
+        m_StaticStorage.construct_default(end(), Count);
+        ccc::move_backward(Inserted, end(), end() + Count, UseRawMemOpsType());
+        std::fill(Inserted, Inserted + Count, Copy);
+        m_End = m_End + Count;
+        return iterator(Inserted);
+    }
+
+    iterator erase(const_iterator Position)
+    {
+        ccc::move(const_cast<pointer>(Position) + 1, end(), const_cast<pointer>(Position), UseRawMemOpsType());
+        m_End = m_End - 1;
+        m_StaticStorage.destroy(end());
+        return const_cast<pointer>(Position);
+    }
+
+    iterator erase(const_iterator First, const_iterator Last)
+    {
+        if (First != Last)
+        {
+            size_type Count = static_cast<size_type>(std::distance(First, Last));
+            ccc::move(const_cast<pointer>(Last), end(), const_cast<pointer>(First), UseRawMemOpsType());
+            m_End = m_End - Count;
+            m_StaticStorage.destroy(end(), end() + Count);
+        }
+        return const_cast<pointer>(First);
+    }
+
+    void push_back(value_type const& Value)
+    {
+        if (size() < capacity())
+        {
+            m_StaticStorage.construct_and_assign(end(), Value);
+        }
+        else
+        {
+            value_type Copy(Value); // Value might refer to an element of this vector
+            _private_grow(1);
+            m_StaticStorage.construct_and_assign(end(), Copy);
+        }
+        m_End = m_End + 1;
+    }
+
+    void pop_back()
+    {
+        if (not empty())
+        {
+            m_End = m_End - 1;
+            m_StaticStorage.destroy(end());
+        }
+    }
+
+    void resize(size_type Count)
+    {
+        if (Count < size())
+        {
+            m_StaticStorage.destroy(begin() + Count, end());
+            m_End = Count;
+        }
+        else if (Count > size())
+        {
+            _private_grow(Count - size());
+            m_StaticStorage.construct_default(end(), Count - size());
+            m_End = Count;
+        }
+    }
+
+    void resize(size_type Count, value_type const& Value)
+    {
+        if (Count < size())
+        {
+            m_StaticStorage.destroy(begin() + Count, end());
+            m_End = Count;
+        }
+        else if (Count > size())
+        {
+            value_type Copy(Value); // Value might refer to an element of this vector
+            _private_grow(Count - size());
+            m_StaticStorage.construct_and_assign(end(), Count - size(), Copy);
+            m_End = Count;
+        }
+    }
+
+    void swap(SmallVector& Other)
+    {
+        if (not this->is_small() and not Other.is_small())
+        {
+            using std::swap;
+            this->m_FixedStorage.swap(Other.m_FixedStorage);
+            swap(this->m_End, Other.m_End);
+        }
+        else
+        {
+            SmallVector Tmp(*this);
+            *this = Other;
+            Other = Tmp;
+        }
+    }
+
+    // Private methods:
+
+    /**
+     * Makes room for Count additional elements, at least doubling the capacity if it has to grow.
+     */
+    void _private_grow(size_type Count)
+    {
+        if (Count > max_size() - size())
+        {
+            throw std::bad_alloc();
+        }
+        if (size() + Count > capacity())
+        {
+            size_type NewCapacity = (capacity() > max_size() / 2) ? max_size() : static_cast<size_type>(2 * capacity());
+            _private_reallocate(std::max(NewCapacity, static_cast<size_type>(size() + Count)));
+        }
+    }
+
+    /**
+     * Moves the elements into the static storage if NewCapacity <= N, otherwise into a newly
+     * allocated storage with the given capacity.
+     */
+    void _private_reallocate(size_type NewCapacity)
+    {
+        fixed_storage_type Released;
+        if (NewCapacity <= N)
+        {
+            if (not is_small())
+            {
+                m_StaticStorage.construct_and_assign(ccc::addressof(m_StaticStorage[0]), begin(), end());
+                m_StaticStorage.destroy(begin(), end());
+                Released.swap(m_FixedStorage);
+            }
+        }
+        else
+        {
+            fixed_storage_type Allocated(NewCapacity);
+            Allocated.construct_and_assign(ccc::addressof(Allocated[0]), begin(), end());
+            m_StaticStorage.destroy(begin(), end());
+            Released.swap(m_FixedStorage);
+            m_FixedStorage.swap(Allocated);
+        }
+        // the previously used free store (if any) is released when Released goes out of scope
+    }
+};
+
+}
+
+#endif /* CCC_SMALL_VECTOR_H_ */
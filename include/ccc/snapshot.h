@@ -0,0 +1,372 @@
+/**
+ *
+ * @file This file contains functions to save containers to files and to restore or map them.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_SNAPSHOT_H_
+#define CCC_SNAPSHOT_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ccc/compat.h>
+#include <ccc/layout_header.h>
+#include <ccc/fixed_vector.h>
+#include <ccc/fixed_deque.h>
+#include <ccc/fixed_list.h>
+
+/*
+ * A snapshot consists of a LayoutHeader followed by the payload at header.m_PayloadOffset. For
+ * containers with static storage (PodVector, PodDeque, PodList, PODArray, their Consistent and
+ * Static variants, ...) the payload is the raw object, so that the file can be mapped and used in
+ * place. For the Fixed* containers the payload consists of the state and the allocated storage,
+ * which can only be copied into an instance of equal capacity.
+ *
+ * Which containers have static storage is told by layout_traits<Container>::static_storage; the
+ * generic functions and MappedSnapshot reject all other containers at compile time, including
+ * containers allocating their storage (FixedFlatMap, FixedHashMap, SmallVector, DynamicArray, ...)
+ * and containers without a specialization of layout_traits.
+ *
+ * All functions throw std::runtime_error on I/O errors and on layout mismatches.
+ */
+
+namespace ccc
+{
+
+/**
+ * @brief Contiguous piece of a container written to or read from a snapshot.
+ */
+struct SnapshotBlock
+{
+    void* m_Address;
+    std::size_t m_Size;
+};
+
+inline const char* snapshot_magic()
+{
+    return "ccc.snap";
+}
+
+template <class Container>
+std::size_t snapshot_payload_offset()
+{
+    const std::size_t Alignment = (CCC_ALIGNOF(Container) > 64) ? CCC_ALIGNOF(Container) : 64;
+    return (sizeof(LayoutHeader) + Alignment - 1) / Alignment * Alignment;
+}
+
+inline void _private_snapshot_fail(const char* What)
+{
+    throw std::runtime_error(std::string("ccc::snapshot: ") + What + ": " + std::strerror(errno));
+}
+
+inline void _private_write_all(int Fd, const void* Data, std::size_t Size)
+{
+    const char* Position = static_cast<const char*>(Data);
+    while (Size > 0)
+    {
+        ssize_t Written = ::write(Fd, Position, Size);
+        if (Written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            _private_snapshot_fail("write failed");
+        }
+        Position += Written;
+        Size -= static_cast<std::size_t>(Written);
+    }
+}
+
+inline void _private_read_all(int Fd, void* Data, std::size_t Size)
+{
+    char* Position = static_cast<char*>(Data);
+    while (Size > 0)
+    {
+        ssize_t Read = ::read(Fd, Position, Size);
+        if (Read < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            _private_snapshot_fail("read failed");
+        }
+        if (0 == Read)
+        {
+            throw std::runtime_error("ccc::snapshot: unexpected end of file");
+        }
+        Position += Read;
+        Size -= static_cast<std::size_t>(Read);
+    }
+}
+
+template <class Container>
+void _private_save_blocks(int Fd, uint64_t Capacity, const SnapshotBlock* Blocks, std::size_t Count)
+{
+    std::size_t PayloadSize = 0;
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        PayloadSize += Blocks[i].m_Size;
+    }
+    const std::size_t Offset = snapshot_payload_offset<Container>();
+    LayoutHeader Header = make_layout_header<Container>(snapshot_magic(), Capacity, Offset, PayloadSize);
+    char Padding[256] = { 0 };
+    _private_write_all(Fd, &Header, sizeof(Header));
+    for (std::size_t Remaining = Offset - sizeof(Header); Remaining > 0;)
+    {
+        std::size_t Chunk = (Remaining < sizeof(Padding)) ? Remaining : sizeof(Padding);
+        _private_write_all(Fd, Padding, Chunk);
+        Remaining -= Chunk;
+    }
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        _private_write_all(Fd, Blocks[i].m_Address, Blocks[i].m_Size);
+    }
+}
+
+template <class Container>
+void _private_load_blocks(int Fd, uint64_t Capacity, const SnapshotBlock* Blocks, std::size_t Count)
+{
+    LayoutHeader Header;
+    _private_read_all(Fd, &Header, sizeof(Header));
+    validate_layout_header<Container>(Header, snapshot_magic());
+    if (Header.m_Capacity != Capacity)
+    {
+        throw std::runtime_error("ccc::snapshot: capacity mismatch");
+    }
+    std::size_t PayloadSize = 0;
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        PayloadSize += Blocks[i].m_Size;
+    }
+    if ((Header.m_PayloadSize != PayloadSize) or (Header.m_PayloadOffset < sizeof(Header)))
+    {
+        throw std::runtime_error("ccc::snapshot: unexpected payload size");
+    }
+    char Padding[256];
+    for (std::size_t Remaining = static_cast<std::size_t>(Header.m_PayloadOffset) - sizeof(Header); Remaining > 0;)
+    {
+        std::size_t Chunk = (Remaining < sizeof(Padding)) ? Remaining : sizeof(Padding);
+        _private_read_all(Fd, Padding, Chunk);
+        Remaining -= Chunk;
+    }
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        _private_read_all(Fd, Blocks[i].m_Address, Blocks[i].m_Size);
+    }
+}
+
+/**
+ * Writes a snapshot of a container with static storage to the current position of Fd.
+ */
+template <class Container>
+void save_snapshot(int Fd, const Container& Source)
+{
+    CCC_STATIC_ASSERT(layout_traits<Container>::static_storage, "save_snapshot requires a container with static storage");
+    SnapshotBlock Block = { const_cast<Container*>(&Source), sizeof(Container) };
+    _private_save_blocks<Container>(Fd, Source.max_size(), &Block, 1);
+}
+
+/**
+ * Overwrites Destination with the snapshot read from the current position of Fd. Destination has
+ * to be a container with static storage of the same type the snapshot was saved from.
+ */
+template <class Container>
+void load_snapshot(int Fd, Container& Destination)
+{
+    CCC_STATIC_ASSERT(layout_traits<Container>::static_storage, "load_snapshot requires a container with static storage");
+    SnapshotBlock Block = { &Destination, sizeof(Container) };
+    _private_load_blocks<Container>(Fd, Destination.max_size(), &Block, 1);
+}
+
+template <typename T, typename SizeType, unsigned int Alignment, bool UseRawMemOps>
+void save_snapshot(int Fd, const FixedVector<T, SizeType, Alignment, UseRawMemOps>& Source)
+{
+    typedef PodVector<T, SizeType, 0, Alignment, UseRawMemOps, false, true> pod_type;
+    pod_type& Pod = const_cast<pod_type&>(static_cast<const pod_type&>(Source));
+    SnapshotBlock Blocks[] = {
+        { &Pod.m_End, sizeof(SizeType) },
+        { Pod.m_Storage.m_FixedInitializedStorage, sizeof(T) * Pod.m_Storage.m_Capacity } };
+    _private_save_blocks<FixedVector<T, SizeType, Alignment, UseRawMemOps> >(Fd, Pod.m_Storage.m_Capacity, Blocks, 2);
+}
+
+/**
+ * Restores a FixedVector, whose capacity has to equal the capacity of the saved one.
+ */
+template <typename T, typename SizeType, unsigned int Alignment, bool UseRawMemOps>
+void load_snapshot(int Fd, FixedVector<T, SizeType, Alignment, UseRawMemOps>& Destination)
+{
+    typedef PodVector<T, SizeType, 0, Alignment, UseRawMemOps, false, true> pod_type;
+    pod_type& Pod = Destination;
+    SnapshotBlock Blocks[] = {
+        { &Pod.m_End, sizeof(SizeType) },
+        { Pod.m_Storage.m_FixedInitializedStorage, sizeof(T) * Pod.m_Storage.m_Capacity } };
+    _private_load_blocks<FixedVector<T, SizeType, Alignment, UseRawMemOps> >(Fd, Pod.m_Storage.m_Capacity, Blocks, 2);
+}
+
+template <typename T, typename SizeType, unsigned int Alignment, bool UseRawMemOps>
+void save_snapshot(int Fd, const FixedDeque<T, SizeType, Alignment, UseRawMemOps>& Source)
+{
+    typedef PodDeque<T, SizeType, 0, Alignment, UseRawMemOps, false, true> pod_type;
+    pod_type& Pod = const_cast<pod_type&>(static_cast<const pod_type&>(Source));
+    SnapshotBlock Blocks[] = {
+        { &Pod.m_Begin, sizeof(SizeType) },
+        { &Pod.m_End, sizeof(SizeType) },
+        { Pod.m_Storage.m_FixedInitializedStorage, sizeof(T) * Pod.m_Storage.m_Capacity } };
+    _private_save_blocks<FixedDeque<T, SizeType, Alignment, UseRawMemOps> >(Fd, Pod.m_Storage.m_Capacity, Blocks, 3);
+}
+
+/**
+ * Restores a FixedDeque, whose capacity has to equal the capacity of the saved one.
+ */
+template <typename T, typename SizeType, unsigned int Alignment, bool UseRawMemOps>
+void load_snapshot(int Fd, FixedDeque<T, SizeType, Alignment, UseRawMemOps>& Destination)
+{
+    typedef PodDeque<T, SizeType, 0, Alignment, UseRawMemOps, false, true> pod_type;
+    pod_type& Pod = Destination;
+    SnapshotBlock Blocks[] = {
+        { &Pod.m_Begin, sizeof(SizeType) },
+        { &Pod.m_End, sizeof(SizeType) },
+        { Pod.m_Storage.m_FixedInitializedStorage, sizeof(T) * Pod.m_Storage.m_Capacity } };
+    _private_load_blocks<FixedDeque<T, SizeType, Alignment, UseRawMemOps> >(Fd, Pod.m_Storage.m_Capacity, Blocks, 3);
+}
+
+template <typename T, typename SizeType, unsigned int Alignment>
+void save_snapshot(int Fd, const FixedList<T, SizeType, Alignment>& Source)
+{
+    typedef PodList<T, SizeType, 0, Alignment, false, true> pod_type;
+    pod_type& Pod = const_cast<pod_type&>(static_cast<const pod_type&>(Source));
+    SnapshotBlock Blocks[] = {
+        { &Pod.m_Size, sizeof(SizeType) },
+        { Pod.m_Nodes.m_FixedInitializedStorage, sizeof(typename pod_type::node_type) * Pod.m_Nodes.m_Capacity },
+        { Pod.m_Values.m_FixedInitializedStorage, sizeof(T) * Pod.m_Values.m_Capacity },
+        { &Pod.m_Deallocated.m_End, sizeof(SizeType) },
+        { Pod.m_Deallocated.m_Storage.m_FixedInitializedStorage, sizeof(SizeType) * Pod.m_Deallocated.m_Storage.m_Capacity } };
+    _private_save_blocks<FixedList<T, SizeType, Alignment> >(Fd, Pod.m_Values.m_Capacity, Blocks, 5);
+}
+
+/**
+ * Restores a FixedList, whose capacity has to equal the capacity of the saved one.
+ */
+template <typename T, typename SizeType, unsigned int Alignment>
+void load_snapshot(int Fd, FixedList<T, SizeType, Alignment>& Destination)
+{
+    typedef PodList<T, SizeType, 0, Alignment, false, true> pod_type;
+    pod_type& Pod = Destination;
+    SnapshotBlock Blocks[] = {
+        { &Pod.m_Size, sizeof(SizeType) },
+        { Pod.m_Nodes.m_FixedInitializedStorage, sizeof(typename pod_type::node_type) * Pod.m_Nodes.m_Capacity },
+        { Pod.m_Values.m_FixedInitializedStorage, sizeof(T) * Pod.m_Values.m_Capacity },
+        { &Pod.m_Deallocated.m_End, sizeof(SizeType) },
+        { Pod.m_Deallocated.m_Storage.m_FixedInitializedStorage, sizeof(SizeType) * Pod.m_Deallocated.m_Storage.m_Capacity } };
+    _private_load_blocks<FixedList<T, SizeType, Alignment> >(Fd, Pod.m_Values.m_Capacity, Blocks, 5);
+}
+
+/**
+ * @brief Read-only view of a snapshot file mapped into memory.
+ *
+ * The container is used in place without copying; pages are loaded on first access. Only snapshots
+ * of containers with static storage can be mapped.
+ */
+template <class Container>
+class MappedSnapshot
+{
+public:
+    typedef Container container_type;
+
+    explicit MappedSnapshot(const std::string& Path)
+            : m_Address(MAP_FAILED), m_Length(0)
+    {
+        CCC_STATIC_ASSERT(layout_traits<Container>::static_storage, "MappedSnapshot requires a container with static storage");
+        int Fd = ::open(Path.c_str(), O_RDONLY);
+        if (Fd < 0)
+        {
+            _private_snapshot_fail("cannot open file");
+        }
+        struct stat Status;
+        if ((0 != ::fstat(Fd, &Status)) or (static_cast<std::size_t>(Status.st_size) < sizeof(LayoutHeader)))
+        {
+            ::close(Fd);
+            throw std::runtime_error("ccc::snapshot: '" + Path + "' is too small to hold a header");
+        }
+        m_Length = static_cast<std::size_t>(Status.st_size);
+        m_Address = ::mmap(0, m_Length, PROT_READ, MAP_SHARED, Fd, 0);
+        int MapErrno = errno;
+        ::close(Fd);
+        if (MAP_FAILED == m_Address)
+        {
+            errno = MapErrno;
+            _private_snapshot_fail("mmap failed");
+        }
+        try
+        {
+            const LayoutHeader& Header = header();
+            validate_layout_header<container_type>(Header, snapshot_magic());
+            if ((Header.m_PayloadOffset != snapshot_payload_offset<container_type>())
+                    or (Header.m_PayloadSize != sizeof(container_type))
+                    or (m_Length < Header.m_PayloadOffset + sizeof(container_type)))
+            {
+                throw std::runtime_error("ccc::snapshot: unexpected payload in '" + Path + "'");
+            }
+            if (Header.m_Capacity != get()->max_size())
+            {
+                throw std::runtime_error("ccc::snapshot: capacity mismatch in '" + Path + "'");
+            }
+        }
+        catch (...)
+        {
+            ::munmap(m_Address, m_Length);
+            throw;
+        }
+    }
+
+    ~MappedSnapshot()
+    {
+        ::munmap(m_Address, m_Length);
+    }
+
+    const container_type& operator*() const
+    {
+        return *get();
+    }
+
+    const container_type* operator->() const
+    {
+        return get();
+    }
+
+    const container_type* get() const
+    {
+        return reinterpret_cast<const container_type*>(static_cast<const char*>(m_Address) + snapshot_payload_offset<container_type>());
+    }
+
+    const LayoutHeader& header() const
+    {
+        return *static_cast<const LayoutHeader*>(m_Address);
+    }
+
+private:
+    MappedSnapshot(MappedSnapshot const&);
+    void operator=(MappedSnapshot const&);
+
+    void* m_Address;
+    std::size_t m_Length;
+};
+
+}
+
+#endif /* CCC_SNAPSHOT_H_ */
@@ -0,0 +1,174 @@
+/**
+ *
+ * @file This file contains the SnapshotPublisher, which gives readers consistent views of a container while a writer modifies it.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_SNAPSHOT_PUBLISHER_H_
+#define CCC_SNAPSHOT_PUBLISHER_H_
+
+#include <cstddef>
+#include <stdint.h>
+
+#include <ccc/compat.h>
+#include <ccc/atomic.h>
+
+namespace ccc
+{
+
+#pragma pack(push, 16)
+
+/**
+ * @brief Double-buffered container with a single writer and any number of readers ("left-right").
+ *
+ * Readers obtain a ReadView of the published copy, which stays unchanged while the view exists; they
+ * never wait for the writer and never observe a half-applied modification. The writer applies each
+ * modification to the unpublished copy, publishes it with an atomic switch and then applies the same
+ * modification to the other copy as soon as the readers that started before the switch are done.
+ *
+ * Thus a modification has to be deterministic, so that both copies stay equal, and the writer waits
+ * at most for the longest read that overlaps the switch. Writers have to be serialized by the user.
+ *
+ * The object consists of plain data only (two containers and a few integers), so for containers with
+ * static storage it can be placed in shared memory as well.
+ */
+template <class Container>
+class SnapshotPublisher
+{
+public:
+    typedef Container container_type;
+
+    /**
+     * @brief Keeps the published copy, which was current at construction, unchanged until destruction.
+     */
+    class ReadView
+    {
+    public:
+        explicit ReadView(const SnapshotPublisher& Publisher)
+                : m_Publisher(Publisher)
+        {
+            for (;;)
+            {
+                m_Index = atomic_load(m_Publisher.m_Published);
+                atomic_fetch_add(m_Publisher.m_Readers[m_Index].m_Count, uint32_t(1));
+                // The writer may have switched before the increment became visible; it then does not
+                // wait for this reader, so retry with the new copy.
+                if (atomic_load(m_Publisher.m_Published) == m_Index)
+                {
+                    break;
+                }
+                atomic_fetch_sub(m_Publisher.m_Readers[m_Index].m_Count, uint32_t(1));
+            }
+        }
+
+        ~ReadView()
+        {
+            atomic_fetch_sub(m_Publisher.m_Readers[m_Index].m_Count, uint32_t(1));
+        }
+
+        const container_type& operator*() const
+        {
+            return m_Publisher.m_Copies[m_Index];
+        }
+
+        const container_type* operator->() const
+        {
+            return &m_Publisher.m_Copies[m_Index];
+        }
+
+        /**
+         * Number of publications preceding the viewed copy.
+         */
+        uint64_t epoch() const
+        {
+            return m_Publisher.m_Epochs[m_Index];
+        }
+
+    private:
+        ReadView(ReadView const&);
+        void operator=(ReadView const&);
+
+        const SnapshotPublisher& m_Publisher;
+        uint32_t m_Index;
+    };
+
+    SnapshotPublisher()
+            : m_Copies(), m_Published(0)
+    {
+        m_Epochs[0] = 0;
+        m_Epochs[1] = 0;
+        m_Readers[0].m_Count = 0;
+        m_Readers[1].m_Count = 0;
+    }
+
+    /**
+     * Calls Function(container_type&) twice, once for each copy (see above), and publishes the result.
+     * Returns the new epoch.
+     */
+    template <class Modifier>
+    uint64_t write(Modifier Function)
+    {
+        const uint32_t Published = atomic_load(m_Published);
+        const uint32_t Unpublished = 1 - Published;
+        Function(m_Copies[Unpublished]);
+        m_Epochs[Unpublished] = m_Epochs[Published] + 1;
+        atomic_store(m_Published, Unpublished);
+        WaitForReaders(Published);
+        Function(m_Copies[Published]);
+        return m_Epochs[Unpublished];
+    }
+
+    /**
+     * Calls Function(const container_type&) on the published copy.
+     */
+    template <class ReaderFunction>
+    void read(ReaderFunction Function) const
+    {
+        ReadView View(*this);
+        Function(*View);
+    }
+
+    /**
+     * Returns the number of publications so far.
+     */
+    uint64_t epoch() const
+    {
+        ReadView View(*this);
+        return View.epoch();
+    }
+
+private:
+    SnapshotPublisher(SnapshotPublisher const&);
+    void operator=(SnapshotPublisher const&);
+
+    void WaitForReaders(uint32_t Index) const
+    {
+        for (unsigned int Iteration = 0; 0 != atomic_load(m_Readers[Index].m_Count); ++Iteration)
+        {
+            spin_wait(Iteration);
+        }
+    }
+
+    struct ReaderCount
+    {
+        volatile uint32_t m_Count;
+        char m_Padding[64 - sizeof(uint32_t)]; // keeps the counters on separate cache lines
+    };
+
+    container_type m_Copies[2];
+    uint64_t m_Epochs[2]; // number of publications preceding each copy
+    char m_Padding[64];
+    volatile uint32_t m_Published; // index of the copy new readers use
+    char m_Padding2[64 - sizeof(uint32_t)];
+    mutable ReaderCount m_Readers[2];
+};
+
+#pragma pack(pop)
+
+}
+
+#endif /* CCC_SNAPSHOT_PUBLISHER_H_ */
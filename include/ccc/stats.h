@@ -0,0 +1,156 @@
+/**
+ *
+ * @file This file contains counters of dynamic memory allocations, which are fed by replaced global allocation functions.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_STATS_H_
+#define CCC_STATS_H_
+
+#include <ciso646>
+#include <cstddef>
+#include <stdint.h>
+
+#include <ccc/atomic.h>
+
+namespace ccc
+{
+
+namespace stats
+{
+
+/**
+ * @brief Process-wide allocation counters.
+ *
+ * The library itself never writes them; a program that wants them counted replaces the global
+ * operator new and delete and calls record_allocation and record_deallocation (see
+ * test/include/ccc/test/allocation_hooks.h). The counters are zero-initialized before any dynamic
+ * initialization, so allocations of static constructors are counted as well.
+ */
+struct AllocationCounters
+{
+    volatile uint64_t m_Allocations;
+    volatile uint64_t m_Deallocations;
+    volatile uint64_t m_AllocatedBytes;
+    volatile uint64_t m_DeallocatedBytes;
+    volatile uint64_t m_PeakBytes; // maximum of the bytes in use
+    volatile uint32_t m_HooksInstalled;
+};
+
+inline AllocationCounters& allocation_counters()
+{
+    static AllocationCounters Counters;
+    return Counters;
+}
+
+/**
+ * True if the global allocation functions report to the counters, otherwise all counts stay zero.
+ */
+inline bool hooks_installed()
+{
+    return 0 != allocation_counters().m_HooksInstalled;
+}
+
+inline uint64_t bytes_in_use()
+{
+    const AllocationCounters& Counters = allocation_counters();
+    return Counters.m_AllocatedBytes - Counters.m_DeallocatedBytes;
+}
+
+inline void record_allocation(std::size_t Bytes)
+{
+    AllocationCounters& Counters = allocation_counters();
+    atomic_fetch_add(Counters.m_Allocations, uint64_t(1));
+    atomic_fetch_add(Counters.m_AllocatedBytes, uint64_t(Bytes));
+    // concurrent deallocations may make the peak slightly too high
+    const uint64_t InUse = bytes_in_use();
+    uint64_t Peak = Counters.m_PeakBytes;
+    while ((InUse > Peak) and not atomic_compare_exchange(Counters.m_PeakBytes, Peak, InUse))
+    {
+        Peak = Counters.m_PeakBytes;
+    }
+}
+
+inline void record_deallocation(std::size_t Bytes)
+{
+    AllocationCounters& Counters = allocation_counters();
+    atomic_fetch_add(Counters.m_Deallocations, uint64_t(1));
+    atomic_fetch_add(Counters.m_DeallocatedBytes, uint64_t(Bytes));
+}
+
+/**
+ * @brief Allocations since the construction of the scope.
+ *
+ * Counts the allocations of all threads. The peak is tracked by resetting the process-wide peak to
+ * the bytes in use at construction and restoring the larger of both at destruction, so nested scopes
+ * work, but overlapping scopes of different threads disturb each other's peaks.
+ */
+class AllocationScope
+{
+public:
+    AllocationScope()
+            : m_Allocations(allocation_counters().m_Allocations),
+              m_Deallocations(allocation_counters().m_Deallocations),
+              m_AllocatedBytes(allocation_counters().m_AllocatedBytes),
+              m_BytesInUse(bytes_in_use()),
+              m_OuterPeakBytes(allocation_counters().m_PeakBytes)
+    {
+        allocation_counters().m_PeakBytes = m_BytesInUse;
+    }
+
+    ~AllocationScope()
+    {
+        AllocationCounters& Counters = allocation_counters();
+        if (m_OuterPeakBytes > Counters.m_PeakBytes)
+        {
+            Counters.m_PeakBytes = m_OuterPeakBytes;
+        }
+    }
+
+    uint64_t allocations() const
+    {
+        return allocation_counters().m_Allocations - m_Allocations;
+    }
+
+    uint64_t deallocations() const
+    {
+        return allocation_counters().m_Deallocations - m_Deallocations;
+    }
+
+    /**
+     * Sum of the sizes of all allocations in the scope.
+     */
+    uint64_t allocated_bytes() const
+    {
+        return allocation_counters().m_AllocatedBytes - m_AllocatedBytes;
+    }
+
+    /**
+     * Maximum of the bytes in use during the scope beyond those in use at its construction.
+     */
+    uint64_t peak_bytes() const
+    {
+        const uint64_t Peak = allocation_counters().m_PeakBytes;
+        return (Peak > m_BytesInUse) ? (Peak - m_BytesInUse) : 0;
+    }
+
+private:
+    AllocationScope(AllocationScope const&);
+    void operator=(AllocationScope const&);
+
+    uint64_t m_Allocations;
+    uint64_t m_Deallocations;
+    uint64_t m_AllocatedBytes;
+    uint64_t m_BytesInUse;
+    uint64_t m_OuterPeakBytes;
+};
+
+}
+
+}
+
+#endif /* CCC_STATS_H_ */
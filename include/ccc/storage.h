@@ -433,6 +433,11 @@ struct FixedUninitializedStorage
         return addressof(Object);
     }
 
+    size_type capacity() const
+    {
+        return m_Capacity;
+    }
+
     size_type max_size() const
     {
         return m_Capacity;
@@ -0,0 +1,535 @@
+/**
+ *
+ * @file This file contains a portable encoding of containers, which is independent of byte order, SizeType and padding.
+ *
+ * @author Frank Dierkes
+ *
+ * @copyright MIT license (A copy of the license is distributed with the software.)
+ *
+ */
+
+#ifndef CCC_WIRE_FORMAT_H_
+#define CCC_WIRE_FORMAT_H_
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <stdint.h>
+
+#include <ccc/compat.h>
+#include <ccc/serialization.h>
+#include <ccc/pod_vector.h>
+#include <ccc/pod_deque.h>
+#include <ccc/pod_list.h>
+#include <ccc/pod_array.h>
+#include <ccc/pod_flat_set.h>
+#include <ccc/pod_flat_map.h>
+
+/*
+ * The portable encoding of a container consists of the element count (8 bytes) and the encoded size
+ * of an element (8 bytes) followed by the elements in container order. All integers are stored in
+ * little-endian byte order with the fixed widths given by wire_traits, so the encoding can be read by
+ * builds differing in byte order, SizeType, Alignment or the sizes of the fundamental types. Maps
+ * store the key followed by the mapped value of each element.
+ *
+ * If the host layout of the elements equals their encoding (a little-endian host and no padding),
+ * the elements are copied with memcpy.
+ *
+ * Other value types can be supported by specializing wire_traits, see the specializations for the
+ * fundamental types below.
+ */
+
+namespace ccc
+{
+
+/**
+ * @brief Describes the encoding of T: the encoded size, whether the host representation equals the
+ * encoding (is_raw) and the functions encode(Value, Out) and decode(In, Value).
+ *
+ * decode() throws std::runtime_error if the encoded value is not representable by T.
+ */
+template <class T>
+struct wire_traits;
+
+template <std::size_t Size>
+inline void _private_store_little_endian(unsigned char* Out, uint64_t Value)
+{
+    for (std::size_t i = 0; i < Size; ++i)
+    {
+        Out[i] = static_cast<unsigned char>(Value >> (8 * i));
+    }
+}
+
+template <std::size_t Size>
+inline uint64_t _private_load_little_endian(const unsigned char* In)
+{
+    uint64_t Value = 0;
+    for (std::size_t i = 0; i < Size; ++i)
+    {
+        Value |= static_cast<uint64_t>(In[i]) << (8 * i);
+    }
+    return Value;
+}
+
+template <class T, std::size_t Size, bool Signed>
+struct _private_integral_wire_traits
+{
+    typedef T value_type;
+
+    static const std::size_t size = Size;
+    static const bool is_raw = CCC_LITTLE_ENDIAN and (sizeof(T) == Size);
+
+    static void encode(const T& Value, unsigned char* Out)
+    {
+        _private_store_little_endian<Size>(Out, static_cast<uint64_t>(Value));
+    }
+
+    static void decode(const unsigned char* In, T& Value)
+    {
+        uint64_t Bits = _private_load_little_endian<Size>(In);
+        if (Signed and (Size < 8) and (Bits >> (8 * Size - 1)))
+        {
+            Bits |= ~uint64_t(0) << (8 * (Size % 8)); // sign extension
+        }
+        Value = static_cast<T>(Bits);
+        if (static_cast<uint64_t>(Value) != Bits)
+        {
+            throw std::runtime_error("ccc::wire_traits: value out of range");
+        }
+    }
+};
+
+#define CCC_INTEGRAL_WIRE_TRAITS(Type, Size, Signed) \
+    template <> \
+    struct wire_traits<Type> : _private_integral_wire_traits<Type, Size, Signed> \
+    { \
+    };
+
+CCC_INTEGRAL_WIRE_TRAITS(char, 1, (static_cast<char>(-1) < 0))
+CCC_INTEGRAL_WIRE_TRAITS(signed char, 1, true)
+CCC_INTEGRAL_WIRE_TRAITS(unsigned char, 1, false)
+CCC_INTEGRAL_WIRE_TRAITS(short, 2, true)
+CCC_INTEGRAL_WIRE_TRAITS(unsigned short, 2, false)
+CCC_INTEGRAL_WIRE_TRAITS(int, 4, true)
+CCC_INTEGRAL_WIRE_TRAITS(unsigned int, 4, false)
+CCC_INTEGRAL_WIRE_TRAITS(long, 8, true)
+CCC_INTEGRAL_WIRE_TRAITS(unsigned long, 8, false)
+CCC_INTEGRAL_WIRE_TRAITS(long long, 8, true)
+CCC_INTEGRAL_WIRE_TRAITS(unsigned long long, 8, false)
+
+#undef CCC_INTEGRAL_WIRE_TRAITS
+
+/**
+ * Decoded element-wise, so that bytes other than 0 and 1 are rejected.
+ */
+template <>
+struct wire_traits<bool> : _private_integral_wire_traits<bool, 1, false>
+{
+    static const bool is_raw = false;
+};
+
+/**
+ * Floating point values are encoded as their IEEE 754 bit patterns.
+ */
+template <class T, class Bits>
+struct _private_floating_point_wire_traits
+{
+    typedef T value_type;
+
+    static const std::size_t size = sizeof(Bits);
+    static const bool is_raw = CCC_LITTLE_ENDIAN and (sizeof(T) == sizeof(Bits));
+
+    static void encode(const T& Value, unsigned char* Out)
+    {
+        Bits Pattern;
+        std::memcpy(&Pattern, &Value, sizeof(Pattern));
+        _private_store_little_endian<sizeof(Bits)>(Out, Pattern);
+    }
+
+    static void decode(const unsigned char* In, T& Value)
+    {
+        Bits Pattern = static_cast<Bits>(_private_load_little_endian<sizeof(Bits)>(In));
+        std::memcpy(&Value, &Pattern, sizeof(Pattern));
+    }
+};
+
+template <>
+struct wire_traits<float> : _private_floating_point_wire_traits<float, uint32_t>
+{
+};
+
+template <>
+struct wire_traits<double> : _private_floating_point_wire_traits<double, uint64_t>
+{
+};
+
+/**
+ * Codec of the elements of sequences.
+ */
+template <class T>
+struct _private_value_wire_codec
+{
+    typedef T value_type;
+
+    static const std::size_t size = wire_traits<T>::size;
+    static const bool is_raw = wire_traits<T>::is_raw;
+
+    static void encode(const T& Value, unsigned char* Out)
+    {
+        wire_traits<T>::encode(Value, Out);
+    }
+
+    static void decode(const unsigned char* In, T& Value)
+    {
+        wire_traits<T>::decode(In, Value);
+    }
+};
+
+/**
+ * Codec of the elements of maps, which have the members first and second.
+ */
+template <class Element, class KeyType, class T>
+struct _private_map_wire_codec
+{
+    typedef Element value_type;
+
+    static const std::size_t size = wire_traits<KeyType>::size + wire_traits<T>::size;
+    static const bool is_raw = wire_traits<KeyType>::is_raw and wire_traits<T>::is_raw and (sizeof(Element) == size)
+            and (0 == offsetof(Element, first));
+
+    static void encode(const Element& Value, unsigned char* Out)
+    {
+        wire_traits<KeyType>::encode(Value.first, Out);
+        wire_traits<T>::encode(Value.second, Out + wire_traits<KeyType>::size);
+    }
+
+    static void decode(const unsigned char* In, Element& Value)
+    {
+        wire_traits<KeyType>::decode(In, Value.first);
+        wire_traits<T>::decode(In + wire_traits<KeyType>::size, Value.second);
+    }
+};
+
+static const std::size_t portable_header_size = 16;
+
+template <class Codec>
+std::size_t _private_portable_size(std::size_t Count)
+{
+    return portable_header_size + Count * Codec::size;
+}
+
+template <class Codec>
+char* _private_encode_portable_header(char* Out, std::size_t Count)
+{
+    unsigned char* Bytes = reinterpret_cast<unsigned char*>(Out);
+    _private_store_little_endian<8>(Bytes, Count);
+    _private_store_little_endian<8>(Bytes + 8, Codec::size);
+    return Out + portable_header_size;
+}
+
+/**
+ * Returns the number of encoded elements following the header at In. Throws std::runtime_error if
+ * the buffer is too small or holds elements of another encoded size, and std::bad_alloc if the
+ * elements exceed MaxSize.
+ */
+template <class Codec>
+std::size_t _private_decode_portable_header(const char* In, const char* End, std::size_t MaxSize)
+{
+    if (End - In < static_cast<std::ptrdiff_t>(portable_header_size))
+    {
+        throw std::runtime_error("ccc::deserialize_portable: truncated header");
+    }
+    const unsigned char* Bytes = reinterpret_cast<const unsigned char*>(In);
+    const uint64_t Count = _private_load_little_endian<8>(Bytes);
+    if (_private_load_little_endian<8>(Bytes + 8) != Codec::size)
+    {
+        throw std::runtime_error("ccc::deserialize_portable: encoded value size mismatch");
+    }
+    if (Count > MaxSize)
+    {
+        throw std::bad_alloc();
+    }
+    if (static_cast<std::size_t>(End - In - portable_header_size) / Codec::size < Count)
+    {
+        throw std::runtime_error("ccc::deserialize_portable: truncated elements");
+    }
+    return static_cast<std::size_t>(Count);
+}
+
+template <class Codec>
+char* _private_encode_portable_range(char* Out, const typename Codec::value_type* First, std::size_t Count)
+{
+    if (Codec::is_raw)
+    {
+        return _private_serialize_bytes(Out, First, Count * Codec::size);
+    }
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        Codec::encode(First[i], reinterpret_cast<unsigned char*>(Out));
+        Out += Codec::size;
+    }
+    return Out;
+}
+
+template <class Codec>
+const char* _private_decode_portable_range(const char* In, typename Codec::value_type* First, std::size_t Count)
+{
+    if (Codec::is_raw)
+    {
+        if (Count > 0)
+        {
+            std::memcpy(First, In, Count * Codec::size);
+        }
+        return In + Count * Codec::size;
+    }
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        Codec::decode(reinterpret_cast<const unsigned char*>(In), First[i]);
+        In += Codec::size;
+    }
+    return In;
+}
+
+template <class Codec, class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+const char* _private_decode_portable_vector(PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Vector,
+        const char* In, const char* End)
+{
+    const std::size_t Count = _private_decode_portable_header<Codec>(In, End, Vector.max_size());
+    Vector.clear();
+    In = _private_decode_portable_range<Codec>(In + portable_header_size, Vector.data(), Count);
+    Vector.m_End = static_cast<SizeType>(Count);
+    return In;
+}
+
+// PodVector
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+std::size_t portable_serialized_size(const PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Vector)
+{
+    return _private_portable_size<_private_value_wire_codec<T> >(Vector.size());
+}
+
+/**
+ * Writes the portable encoding of Vector to Out, which has to provide portable_serialized_size(Vector)
+ * bytes, and returns the end of the written data.
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+char* serialize_portable(const PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Vector, char* Out)
+{
+    typedef _private_value_wire_codec<T> codec;
+    Out = _private_encode_portable_header<codec>(Out, Vector.size());
+    return _private_encode_portable_range<codec>(Out, Vector.data(), Vector.size());
+}
+
+/**
+ * Replaces the content of Vector by the elements encoded in [In, End) and returns the end of the
+ * consumed data.
+ */
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+const char* deserialize_portable(PodVector<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Vector,
+        const char* In, const char* End)
+{
+    return _private_decode_portable_vector<_private_value_wire_codec<T> >(Vector, In, End);
+}
+
+// PodDeque
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+std::size_t portable_serialized_size(const PodDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Deque)
+{
+    return _private_portable_size<_private_value_wire_codec<T> >(Deque.size());
+}
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+char* serialize_portable(const PodDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Deque, char* Out)
+{
+    typedef _private_value_wire_codec<T> codec;
+    const std::size_t Begin = Deque.m_Begin;
+    const std::size_t End = Deque.m_End;
+    Out = _private_encode_portable_header<codec>(Out, Deque.size());
+    if (Begin <= End)
+    {
+        return _private_encode_portable_range<codec>(Out, Deque.data(Begin), End - Begin);
+    }
+    Out = _private_encode_portable_range<codec>(Out, Deque.data(Begin), Deque.max_size() + 1 - Begin);
+    return _private_encode_portable_range<codec>(Out, Deque.data(0), End);
+}
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool UseRawMemOps, bool Uninitialized, bool Runtime>
+const char* deserialize_portable(PodDeque<T, SizeType, Capacity, Alignment, UseRawMemOps, Uninitialized, Runtime>& Deque,
+        const char* In, const char* End)
+{
+    typedef _private_value_wire_codec<T> codec;
+    const std::size_t Count = _private_decode_portable_header<codec>(In, End, Deque.max_size());
+    Deque.clear();
+    In = _private_decode_portable_range<codec>(In + portable_header_size, Deque.data(0), Count);
+    Deque.m_End = static_cast<SizeType>(Count);
+    return In;
+}
+
+// PodList
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool Uninitialized, bool Runtime>
+std::size_t portable_serialized_size(const PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime>& List)
+{
+    return _private_portable_size<_private_value_wire_codec<T> >(List.size());
+}
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool Uninitialized, bool Runtime>
+char* serialize_portable(const PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime>& List, char* Out)
+{
+    typedef PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime> list_type;
+    typedef _private_value_wire_codec<T> codec;
+    Out = _private_encode_portable_header<codec>(Out, List.size());
+    SizeType Node = List.m_Nodes[list_type::m_Anchor].m_Next;
+    while (list_type::m_Anchor != Node)
+    {
+        SizeType RunEnd = Node;
+        while (List.m_Nodes[RunEnd].m_Next == RunEnd + 1)
+        {
+            ++RunEnd;
+        }
+        Out = _private_encode_portable_range<codec>(Out, ccc::addressof(List.m_Values[Node - 1]), RunEnd - Node + 1);
+        Node = List.m_Nodes[RunEnd].m_Next;
+    }
+    return Out;
+}
+
+template <class T, class SizeType, SizeType Capacity, unsigned int Alignment, bool Uninitialized, bool Runtime>
+const char* deserialize_portable(PodList<T, SizeType, Capacity, Alignment, Uninitialized, Runtime>& List, const char* In,
+        const char* End)
+{
+    typedef _private_value_wire_codec<T> codec;
+    const std::size_t Count = _private_decode_portable_header<codec>(In, End, List.max_size());
+    List.clear();
+    In = _private_decode_portable_range<codec>(In + portable_header_size, (Count > 0) ? ccc::addressof(List.m_Values[0]) : 0, Count);
+    _private_link_list_contiguously(List, Count);
+    return In;
+}
+
+// PODArray
+
+template <class T, class SizeType, SizeType Capacity, std::size_t Alignment, bool UseRawMemOps, bool StaticStorage>
+std::size_t portable_serialized_size(const PODArray<T, SizeType, Capacity, Alignment, UseRawMemOps, StaticStorage>& Array)
+{
+    return _private_portable_size<_private_value_wire_codec<T> >(Array.size());
+}
+
+template <class T, class SizeType, SizeType Capacity, std::size_t Alignment, bool UseRawMemOps, bool StaticStorage>
+char* serialize_portable(const PODArray<T, SizeType, Capacity, Alignment, UseRawMemOps, StaticStorage>& Array, char* Out)
+{
+    typedef _private_value_wire_codec<T> codec;
+    Out = _private_encode_portable_header<codec>(Out, Array.size());
+    return _private_encode_portable_range<codec>(Out, Array.data(), Array.size());
+}
+
+/**
+ * Throws std::runtime_error unless the encoded array has the size of Array.
+ */
+template <class T, class SizeType, SizeType Capacity, std::size_t Alignment, bool UseRawMemOps, bool StaticStorage>
+const char* deserialize_portable(PODArray<T, SizeType, Capacity, Alignment, UseRawMemOps, StaticStorage>& Array, const char* In,
+        const char* End)
+{
+    typedef _private_value_wire_codec<T> codec;
+    if (_private_decode_portable_header<codec>(In, End, ~std::size_t(0)) != Array.size())
+    {
+        throw std::runtime_error("ccc::deserialize_portable: array size mismatch");
+    }
+    return _private_decode_portable_range<codec>(In + portable_header_size, Array.data(), Array.size());
+}
+
+// PodFlatSet and PodFlatMap
+
+template <class Container>
+void _private_check_strictly_ascending(const Container& C)
+{
+    typename Container::key_compare Less;
+    typename Container::KeyOfValue Key;
+    for (typename Container::size_type i = 1; i < C.size(); ++i)
+    {
+        if (not Less(Key(C.begin()[i - 1]), Key(C.begin()[i])))
+        {
+            throw std::runtime_error("ccc::deserialize_portable: keys are not sorted and unique");
+        }
+    }
+}
+
+template <class KeyType, class SizeType, SizeType Capacity, class Compare, unsigned int Alignment, bool EytzingerLayout, bool Runtime>
+std::size_t portable_serialized_size(const PodFlatSet<KeyType, SizeType, Capacity, Compare, Alignment, EytzingerLayout, Runtime>& Set)
+{
+    return _private_portable_size<_private_value_wire_codec<KeyType> >(Set.size());
+}
+
+template <class KeyType, class SizeType, SizeType Capacity, class Compare, unsigned int Alignment, bool EytzingerLayout, bool Runtime>
+char* serialize_portable(const PodFlatSet<KeyType, SizeType, Capacity, Compare, Alignment, EytzingerLayout, Runtime>& Set, char* Out)
+{
+    return serialize_portable(Set.m_Keys, Out);
+}
+
+/**
+ * Throws std::runtime_error if the encoded keys are not strictly ascending with respect to Compare;
+ * the set is left empty in that case. Rebuilds the search layout.
+ */
+template <class KeyType, class SizeType, SizeType Capacity, class Compare, unsigned int Alignment, bool EytzingerLayout, bool Runtime>
+const char* deserialize_portable(PodFlatSet<KeyType, SizeType, Capacity, Compare, Alignment, EytzingerLayout, Runtime>& Set,
+        const char* In, const char* End)
+{
+    Set.clear();
+    In = deserialize_portable(Set.m_Keys, In, End);
+    try
+    {
+        _private_check_strictly_ascending(Set);
+    }
+    catch (...)
+    {
+        Set.clear();
+        throw;
+    }
+    Set.rebuild_layout();
+    return In;
+}
+
+template <class KeyType, class T, class SizeType, SizeType Capacity, class Compare, unsigned int Alignment, bool EytzingerLayout, bool Runtime>
+std::size_t portable_serialized_size(const PodFlatMap<KeyType, T, SizeType, Capacity, Compare, Alignment, EytzingerLayout, Runtime>& Map)
+{
+    typedef PodFlatMap<KeyType, T, SizeType, Capacity, Compare, Alignment, EytzingerLayout, Runtime> map_type;
+    return _private_portable_size<_private_map_wire_codec<typename map_type::value_type, KeyType, T> >(Map.size());
+}
+
+template <class KeyType, class T, class SizeType, SizeType Capacity, class Compare, unsigned int Alignment, bool EytzingerLayout, bool Runtime>
+char* serialize_portable(const PodFlatMap<KeyType, T, SizeType, Capacity, Compare, Alignment, EytzingerLayout, Runtime>& Map, char* Out)
+{
+    typedef PodFlatMap<KeyType, T, SizeType, Capacity, Compare, Alignment, EytzingerLayout, Runtime> map_type;
+    typedef _private_map_wire_codec<typename map_type::value_type, KeyType, T> codec;
+    Out = _private_encode_portable_header<codec>(Out, Map.size());
+    return _private_encode_portable_range<codec>(Out, Map.begin(), Map.size());
+}
+
+/**
+ * See deserialize_portable(PodFlatSet).
+ */
+template <class KeyType, class T, class SizeType, SizeType Capacity, class Compare, unsigned int Alignment, bool EytzingerLayout, bool Runtime>
+const char* deserialize_portable(PodFlatMap<KeyType, T, SizeType, Capacity, Compare, Alignment, EytzingerLayout, Runtime>& Map,
+        const char* In, const char* End)
+{
+    typedef PodFlatMap<KeyType, T, SizeType, Capacity, Compare, Alignment, EytzingerLayout, Runtime> map_type;
+    typedef _private_map_wire_codec<typename map_type::value_type, KeyType, T> codec;
+    Map.clear();
+    In = _private_decode_portable_vector<codec>(Map.m_Values, In, End);
+    try
+    {
+        _private_check_strictly_ascending(Map);
+    }
+    catch (...)
+    {
+        Map.clear();
+        throw;
+    }
+    Map.rebuild_layout();
+    return In;
+}
+
+}
+
+#endif /* CCC_WIRE_FORMAT_H_ */
@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+"""
+compile_time_benchmark.py
+
+Measures the cost of the container templates at build time. Two scenarios are generated as
+translation units under --work-dir and compiled with the given compiler and flags:
+
+variants   For each container family and each count N of --variants, a translation unit that
+           instantiates N configurations of the Pod container (distinct capacities, alternating
+           element types) and calls their common operations. Reports the compile time and the size
+           of the object file, and the increments per variant against N = 0 (the cost of the
+           headers alone).
+extern     A translation unit using the common configurations of ccc/extern_templates.h, compiled
+           with and without CCC_EXTERN_COMMON_TEMPLATES, at the given flags and at -O0.
+
+    compile_time_benchmark.py [--compiler c++] [--flags "-std=c++11 -O2"] [--variants 1,16,64,256]
+                              [--families vector,deque,list,flat_map,hash_map] [--repetitions 3]
+                              [--work-dir DIR] [--output results.json]
+
+Compile times are the minimum over the repetitions. Object sizes are text + data + bss as reported
+by size(1), or the file size without it.
+"""
+
+import argparse
+import json
+import os
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+
+# family: (header, declaration of variant i with element type T and capacity C, body exercising c)
+FAMILIES = {
+    "vector": ("ccc/pod_vector.h", "ccc::PodVector<{T}, uint32_t, {C}>", """
+    c.push_back(Value);
+    c.insert(c.begin(), Value);
+    c.erase(c.begin());
+    for (uint32_t i = 0; i < c.size(); ++i)
+    {{
+        Sum += c[i];
+    }}
+    c.pop_back();"""),
+    "deque": ("ccc/pod_deque.h", "ccc::PodDeque<{T}, uint32_t, {C}>", """
+    c.push_back(Value);
+    c.push_front(Value);
+    c.insert(c.begin() + 1, Value);
+    c.erase(c.begin() + 1);
+    for (uint32_t i = 0; i < c.size(); ++i)
+    {{
+        Sum += c[i];
+    }}
+    c.pop_front();
+    c.pop_back();"""),
+    "list": ("ccc/pod_list.h", "ccc::PodList<{T}, uint32_t, {C}>", """
+    c.push_back(Value);
+    c.push_front(Value);
+    c.insert(c.begin(), Value);
+    c.erase(c.begin());
+    for (Container::iterator i = c.begin(); i != c.end(); ++i)
+    {{
+        Sum += *i;
+    }}
+    c.pop_front();"""),
+    "flat_map": ("ccc/pod_flat_map.h", "ccc::PodFlatMap<uint32_t, {T}, uint32_t, {C}>", """
+    c[static_cast<uint32_t>(Value)] = Value;
+    Sum += c.count(1);
+    for (Container::iterator i = c.begin(); i != c.end(); ++i)
+    {{
+        Sum += i->second;
+    }}
+    c.erase(static_cast<uint32_t>(Value));"""),
+    "hash_map": ("ccc/pod_hash_map.h", "ccc::PodHashMap<uint32_t, {T}, uint32_t, {C}>", """
+    c[static_cast<uint32_t>(Value)] = Value;
+    Sum += c.count(1);
+    for (Container::iterator i = c.begin(); i != c.end(); ++i)
+    {{
+        Sum += i->second;
+    }}
+    c.erase(static_cast<uint32_t>(Value));"""),
+}
+
+ELEMENT_TYPES = ["uint32_t", "uint64_t", "int32_t", "double"]
+
+# the configurations of CCC_EXTERN_COMMON_TEMPLATES
+COMMON_SEQUENCES = ["ccc::FixedVector<{T}>", "ccc::FixedDeque<{T}>", "ccc::FixedList<{T}>"]
+COMMON_ELEMENTS = ["int32_t", "uint32_t", "int64_t", "uint64_t", "double"]
+COMMON_MAPS = ["ccc::FixedFlatMap<{T}, {T}>", "ccc::FixedHashMap<{T}, {T}>"]
+COMMON_KEYS = ["uint32_t", "uint64_t"]
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--compiler", default=os.environ.get("CXX", "c++"), help="C++ compiler (default: $CXX or c++)")
+    parser.add_argument("--flags", default="-std=c++11 -O2", help="compiler flags (default: -std=c++11 -O2)")
+    parser.add_argument("--include-dir", default=os.path.join(SCRIPT_DIR, "..", "..", "include"),
+                        help="include directory of the library")
+    parser.add_argument("--variants", default="1,16,64,256", help="comma-separated variant counts (default: 1,16,64,256)")
+    parser.add_argument("--families", default=",".join(sorted(FAMILIES)), help="comma-separated container families")
+    parser.add_argument("--repetitions", type=int, default=3, help="compilations per translation unit (default: 3)")
+    parser.add_argument("--work-dir", default=None, help="directory of the generated sources (default: temporary)")
+    parser.add_argument("--output", default=None, help="JSON file of the results")
+    return parser.parse_args()
+
+
+def variants_source(family, count):
+    header, declaration, body = FAMILIES[family]
+    lines = ["#include <stdint.h>", "#include <%s>" % header, ""]
+    for i in range(count):
+        element = ELEMENT_TYPES[i % len(ELEMENT_TYPES)]
+        container = declaration.format(T=element, C=8 + i)
+        lines.append("double exercise_%d(%s& c, %s Value)" % (i, container, element))
+        lines.append("{")
+        lines.append("    typedef %s Container;" % container)
+        lines.append("    double Sum = 0;" + body.format())
+        lines.append("    return Sum;")
+        lines.append("}")
+        lines.append("")
+    return "\n".join(lines)
+
+
+def extern_source():
+    lines = ["#include <ccc/extern_templates.h>", ""]
+    containers = [c.format(T=t) for c in COMMON_SEQUENCES for t in COMMON_ELEMENTS]
+    containers += [m.format(T=k) for m in COMMON_MAPS for k in COMMON_KEYS]
+    for i, container in enumerate(containers):
+        lines.append("double exercise_%d()" % i)
+        lines.append("{")
+        lines.append("    %s c(16);" % container)
+        if "Map" in container:
+            lines.append("    c[1] = 2;")
+            lines.append("    c.erase(1);")
+        else:
+            lines.append("    c.push_back(1);")
+            lines.append("    c.insert(c.begin(), 2);")
+            lines.append("    c.erase(c.begin());")
+        lines.append("    double Sum = 0;")
+        lines.append("    for (%s::const_iterator i = c.begin(); i != c.end(); ++i)" % container)
+        lines.append("    {")
+        lines.append("        Sum += %s;" % ("i->second" if "Map" in container else "*i"))
+        lines.append("    }")
+        lines.append("    return Sum;")
+        lines.append("}")
+        lines.append("")
+    return "\n".join(lines)
+
+
+def object_size(path):
+    size = shutil.which("size")
+    if size:
+        output = subprocess.run([size, path], stdout=subprocess.PIPE, universal_newlines=True, check=False).stdout
+        match = re.search(r"^\s*(\d+)\s+(\d+)\s+(\d+)", output, re.MULTILINE)
+        if match:
+            return sum(int(value) for value in match.groups())
+    return os.path.getsize(path)
+
+
+def compile_unit(arguments, source, name, flags):
+    source_path = os.path.join(arguments.work_dir, name + ".cpp")
+    object_path = os.path.join(arguments.work_dir, name + ".o")
+    with open(source_path, "w") as file:
+        file.write(source)
+    command = [arguments.compiler] + flags + ["-I", arguments.include_dir, "-c", source_path, "-o", object_path]
+    best = None
+    for _ in range(max(1, arguments.repetitions)):
+        start = time.perf_counter()
+        result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        elapsed = time.perf_counter() - start
+        if 0 != result.returncode:
+            raise RuntimeError("%s\n%s" % (" ".join(command), result.stdout))
+        best = elapsed if best is None else min(best, elapsed)
+    return best, object_size(object_path)
+
+
+def main():
+    arguments = parse_arguments()
+    if arguments.work_dir is None:
+        arguments.work_dir = tempfile.mkdtemp(prefix="ccc_compile_time_")
+    os.makedirs(arguments.work_dir, exist_ok=True)
+    flags = shlex.split(arguments.flags)
+    counts = [int(count) for count in arguments.variants.split(",") if count]
+    families = [family for family in arguments.families.split(",") if family]
+    unknown = [family for family in families if family not in FAMILIES]
+    if unknown:
+        print("unknown families: %s" % ", ".join(unknown), file=sys.stderr)
+        return 1
+    results = {"compiler": arguments.compiler, "flags": arguments.flags, "variants": [], "extern": []}
+    try:
+        print("%-10s %8s %10s %12s %14s %14s" % ("family", "variants", "seconds", "object bytes", "seconds/var.", "bytes/var."))
+        for family in families:
+            base_time, base_size = compile_unit(arguments, variants_source(family, 0), "%s_0" % family, flags)
+            for count in counts:
+                seconds, size = compile_unit(arguments, variants_source(family, count), "%s_%d" % (family, count), flags)
+                per_time = (seconds - base_time) / count if count else 0.0
+                per_size = (size - base_size) / float(count) if count else 0.0
+                print("%-10s %8d %10.3f %12d %14.4f %14.0f" % (family, count, seconds, size, per_time, per_size), flush=True)
+                results["variants"].append({"family": family, "variants": count, "seconds": seconds, "object_bytes": size,
+                                            "seconds_per_variant": per_time, "bytes_per_variant": per_size})
+        print()
+        print("%-32s %10s %12s" % ("common configurations", "seconds", "object bytes"))
+        for label, extra in (("implicit", []), ("extern", ["-DCCC_EXTERN_COMMON_TEMPLATES"]),
+                             ("implicit -O0", ["-O0"]), ("extern -O0", ["-O0", "-DCCC_EXTERN_COMMON_TEMPLATES"])):
+            seconds, size = compile_unit(arguments, extern_source(), "common_" + label.replace(" -", "_"), flags + extra)
+            print("%-32s %10.3f %12d" % (label, seconds, size), flush=True)
+            results["extern"].append({"mode": label, "seconds": seconds, "object_bytes": size})
+    except RuntimeError as error:
+        print("compilation failed: %s" % error, file=sys.stderr)
+        return 1
+    if arguments.output:
+        with open(arguments.output, "w") as file:
+            json.dump(results, file, indent=2)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,192 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * @remarks Baseline groups of each ccc container family against its std counterpart, with 16-byte
+ * elements and 16 to 65536 elements per experiment. Celero reports every benchmark relative to the
+ * baseline of its group.
+ *
+ */
+
+#include <celero/Celero.h>
+#include <celero/Benchmark.h>
+
+#include <deque>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <ccc/static_vector.h>
+#include <ccc/fixed_vector.h>
+#include <ccc/static_deque.h>
+#include <ccc/fixed_deque.h>
+#include <ccc/static_list.h>
+#include <ccc/fixed_list.h>
+#include <ccc/fixed_flat_map.h>
+#include <ccc/fixed_hash_map.h>
+
+#include "celero_fixtures.h"
+
+typedef ccc_test::Payload<16> Element;
+
+typedef std::vector<Element> StdVector;
+typedef ccc::StaticVector<Element, uint32_t, MaxElementCount> StaticVector;
+typedef ccc::FixedVector<Element, uint32_t> FixedVector;
+typedef std::deque<Element> StdDeque;
+typedef ccc::StaticDeque<Element, uint32_t, MaxElementCount> StaticDeque;
+typedef ccc::FixedDeque<Element, uint32_t> FixedDeque;
+typedef std::list<Element> StdList;
+typedef ccc::StaticList<Element, uint32_t, MaxElementCount> StaticList;
+typedef ccc::FixedList<Element, uint32_t> FixedList;
+typedef std::map<uint32_t, Element> StdMap;
+typedef ccc::FixedFlatMap<uint32_t, Element, uint32_t> FixedFlatMap;
+typedef std::unordered_map<uint32_t, Element> StdUnorderedMap;
+typedef ccc::FixedHashMap<uint32_t, Element, uint32_t> FixedHashMap;
+
+// Celero takes the fixture as a single macro argument.
+typedef EmptyContainerFixture<StdVector> EmptyStdVector;
+typedef EmptyContainerFixture<StaticVector> EmptyStaticVector;
+typedef EmptyContainerFixture<FixedVector> EmptyFixedVector;
+typedef FilledContainerFixture<StdVector> FilledStdVector;
+typedef FilledContainerFixture<StaticVector> FilledStaticVector;
+typedef FilledContainerFixture<FixedVector> FilledFixedVector;
+typedef EmptyContainerFixture<StdDeque> EmptyStdDeque;
+typedef EmptyContainerFixture<StaticDeque> EmptyStaticDeque;
+typedef EmptyContainerFixture<FixedDeque> EmptyFixedDeque;
+typedef FilledContainerFixture<StdDeque> FilledStdDeque;
+typedef FilledContainerFixture<StaticDeque> FilledStaticDeque;
+typedef FilledContainerFixture<FixedDeque> FilledFixedDeque;
+typedef EmptyContainerFixture<StdList> EmptyStdList;
+typedef EmptyContainerFixture<StaticList> EmptyStaticList;
+typedef EmptyContainerFixture<FixedList> EmptyFixedList;
+typedef FilledContainerFixture<StdList> FilledStdList;
+typedef FilledContainerFixture<StaticList> FilledStaticList;
+typedef FilledContainerFixture<FixedList> FilledFixedList;
+typedef FilledMapFixture<StdMap> FilledStdMap;
+typedef FilledMapFixture<FixedFlatMap> FilledFixedFlatMap;
+typedef FilledMapFixture<StdUnorderedMap> FilledStdUnorderedMap;
+typedef FilledMapFixture<FixedHashMap> FilledFixedHashMap;
+
+// The iterations of each experiment are set by the fixtures.
+static const int Samples = 30;
+
+// Vectors:
+
+BASELINE_F(VectorPushBack, std_vector, EmptyStdVector, Samples, 0)
+{
+    PushBackPopBack();
+}
+
+BENCHMARK_F(VectorPushBack, ccc_StaticVector, EmptyStaticVector, Samples, 0)
+{
+    PushBackPopBack();
+}
+
+BENCHMARK_F(VectorPushBack, ccc_FixedVector, EmptyFixedVector, Samples, 0)
+{
+    PushBackPopBack();
+}
+
+BASELINE_F(VectorIterate, std_vector, FilledStdVector, Samples, 0)
+{
+    Iterate();
+}
+
+BENCHMARK_F(VectorIterate, ccc_StaticVector, FilledStaticVector, Samples, 0)
+{
+    Iterate();
+}
+
+BENCHMARK_F(VectorIterate, ccc_FixedVector, FilledFixedVector, Samples, 0)
+{
+    Iterate();
+}
+
+// Deques:
+
+BASELINE_F(DequePushFront, std_deque, EmptyStdDeque, Samples, 0)
+{
+    PushFrontPopFront();
+}
+
+BENCHMARK_F(DequePushFront, ccc_StaticDeque, EmptyStaticDeque, Samples, 0)
+{
+    PushFrontPopFront();
+}
+
+BENCHMARK_F(DequePushFront, ccc_FixedDeque, EmptyFixedDeque, Samples, 0)
+{
+    PushFrontPopFront();
+}
+
+BASELINE_F(DequeIterate, std_deque, FilledStdDeque, Samples, 0)
+{
+    Iterate();
+}
+
+BENCHMARK_F(DequeIterate, ccc_StaticDeque, FilledStaticDeque, Samples, 0)
+{
+    Iterate();
+}
+
+BENCHMARK_F(DequeIterate, ccc_FixedDeque, FilledFixedDeque, Samples, 0)
+{
+    Iterate();
+}
+
+// Lists:
+
+BASELINE_F(ListPushBack, std_list, EmptyStdList, Samples, 0)
+{
+    PushBackPopBack();
+}
+
+BENCHMARK_F(ListPushBack, ccc_StaticList, EmptyStaticList, Samples, 0)
+{
+    PushBackPopBack();
+}
+
+BENCHMARK_F(ListPushBack, ccc_FixedList, EmptyFixedList, Samples, 0)
+{
+    PushBackPopBack();
+}
+
+BASELINE_F(ListIterate, std_list, FilledStdList, Samples, 0)
+{
+    Iterate();
+}
+
+BENCHMARK_F(ListIterate, ccc_StaticList, FilledStaticList, Samples, 0)
+{
+    Iterate();
+}
+
+BENCHMARK_F(ListIterate, ccc_FixedList, FilledFixedList, Samples, 0)
+{
+    Iterate();
+}
+
+// Maps:
+
+BASELINE_F(MapFind, std_map, FilledStdMap, Samples, 0)
+{
+    Find();
+}
+
+BENCHMARK_F(MapFind, ccc_FixedFlatMap, FilledFixedFlatMap, Samples, 0)
+{
+    Find();
+}
+
+BASELINE_F(HashMapFind, std_unordered_map, FilledStdUnorderedMap, Samples, 0)
+{
+    Find();
+}
+
+BENCHMARK_F(HashMapFind, ccc_FixedHashMap, FilledFixedHashMap, Samples, 0)
+{
+    Find();
+}
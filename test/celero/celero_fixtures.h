@@ -0,0 +1,271 @@
+/*
+ * celero_fixtures.h
+ *
+ *  Fixtures shared by the Celero benchmarks. The container fixtures are parameterized on the element
+ *  count (Celero's experiment values), so every group reports its baseline ratio per problem size.
+ */
+
+#ifndef CCC_CELERO_FIXTURES_H_
+#define CCC_CELERO_FIXTURES_H_
+
+#include <celero/Celero.h>
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <ccc/test/container_factories.h>
+
+class ArrayFixture: public celero::TestFixture
+{
+public:
+    ArrayFixture()
+            : Gen(RandomDevice()), RandomBool(0.5), RandomInt(-100, 100)
+    {
+    }
+
+    inline bool FillArray(int* a, int N)
+    {
+        int prev = 0;
+        for (int i = 0; i < N; ++i)
+        {
+            a[i] = i * prev + prev * prev;
+            prev = a[i];
+        }
+        return true;
+    }
+
+    inline bool FillArrayWithMultiplication(int* a, int N)
+    {
+        int prev = 0;
+        for (int i = 0; i < N; ++i)
+        {
+            a[i] = i * prev + prev * prev;
+            prev = a[i];
+        }
+        return true;
+    }
+
+    template <typename T>
+    inline bool FillVectorWithMultiplication(T& v, int N)
+    {
+        int prev = 0;
+        for (int i = 0; i < N; ++i)
+        {
+            v.push_back(i * prev + prev * prev);
+            prev = v.back();
+        }
+        return true;
+    }
+
+    inline bool FillArrayWithRandom(int* a, int N)
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            a[i] = RandomInt(RandomDevice);
+        }
+        return true;
+    }
+
+    template <typename T>
+    inline bool FillVectorWithRandom(T& v, int N)
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            v.push_back(RandomInt(RandomDevice));
+        }
+        return true;
+    }
+
+    // Improved with Bernoulli distribution of booleans.
+    std::random_device RandomDevice;
+    std::mt19937 Gen;
+
+    // give "true" 1/2 of the time
+    std::bernoulli_distribution RandomBool;
+    std::uniform_int_distribution<int> RandomInt;
+};
+
+/**
+ * Capacity of the containers with static storage, thus the largest element count.
+ */
+static const std::size_t MaxElementCount = 65536;
+
+/**
+ * Runs each benchmark with 16, 256, 4096 and 65536 elements. The iterations are scaled such that
+ * every sample processes about MaxElementCount elements.
+ */
+class ElementCountFixture: public celero::TestFixture
+{
+public:
+    ElementCountFixture()
+            : m_Count(0)
+    {
+    }
+
+    std::vector<std::shared_ptr<celero::TestFixture::ExperimentValue> > getExperimentValues() const override
+    {
+        std::vector<std::shared_ptr<celero::TestFixture::ExperimentValue> > Values;
+        for (std::size_t Count = 16; Count <= MaxElementCount; Count *= 16)
+        {
+            const int64_t Iterations = static_cast<int64_t>(MaxElementCount / Count);
+            Values.push_back(std::make_shared<celero::TestFixture::ExperimentValue>(static_cast<int64_t>(Count), Iterations));
+        }
+        return Values;
+    }
+
+    void setUp(const celero::TestFixture::ExperimentValue* const Experiment) override
+    {
+        m_Count = static_cast<std::size_t>(Experiment->Value);
+    }
+
+    std::size_t m_Count;
+};
+
+/**
+ * Empty container with room for the element count of the experiment.
+ */
+template <class Container>
+class EmptyContainerFixture: public ElementCountFixture
+{
+public:
+    typedef typename Container::value_type value_type;
+
+    EmptyContainerFixture()
+            : m_Container(0)
+    {
+    }
+
+    void setUp(const celero::TestFixture::ExperimentValue* const Experiment) override
+    {
+        ElementCountFixture::setUp(Experiment);
+        m_Container = ccc_test::Factory<Container>::Create(m_Count);
+    }
+
+    void tearDown() override
+    {
+        delete m_Container;
+        m_Container = 0;
+    }
+
+    void PushBackPopBack()
+    {
+        const value_type Value = ccc_test::MakeValue<value_type>(1);
+        for (std::size_t i = 0; i < m_Count; ++i)
+        {
+            m_Container->push_back(Value);
+        }
+        celero::DoNotOptimizeAway(m_Container->back());
+        for (std::size_t i = 0; i < m_Count; ++i)
+        {
+            m_Container->pop_back();
+        }
+    }
+
+    void PushFrontPopFront()
+    {
+        const value_type Value = ccc_test::MakeValue<value_type>(1);
+        for (std::size_t i = 0; i < m_Count; ++i)
+        {
+            m_Container->push_front(Value);
+        }
+        celero::DoNotOptimizeAway(m_Container->front());
+        for (std::size_t i = 0; i < m_Count; ++i)
+        {
+            m_Container->pop_front();
+        }
+    }
+
+    Container* m_Container;
+};
+
+/**
+ * Container holding the element count of the experiment.
+ */
+template <class Container>
+class FilledContainerFixture: public ElementCountFixture
+{
+public:
+    FilledContainerFixture()
+            : m_Container(0)
+    {
+    }
+
+    void setUp(const celero::TestFixture::ExperimentValue* const Experiment) override
+    {
+        ElementCountFixture::setUp(Experiment);
+        m_Container = ccc_test::CreateFilled<Container>(m_Count, m_Count);
+    }
+
+    void tearDown() override
+    {
+        delete m_Container;
+        m_Container = 0;
+    }
+
+    void Iterate()
+    {
+        const Container& Values = *m_Container;
+        uint32_t Sum = 0;
+        for (typename Container::const_iterator it = Values.begin(); it != Values.end(); ++it)
+        {
+            Sum += it->m_Key;
+        }
+        celero::DoNotOptimizeAway(Sum);
+    }
+
+    Container* m_Container;
+};
+
+/**
+ * Map holding the element count of the experiment with the even numbers below twice the count as keys.
+ * Each iteration looks up as many random keys, half of which miss.
+ */
+template <class Map>
+class FilledMapFixture: public ElementCountFixture
+{
+public:
+    FilledMapFixture()
+            : m_Map(0)
+    {
+    }
+
+    void setUp(const celero::TestFixture::ExperimentValue* const Experiment) override
+    {
+        ElementCountFixture::setUp(Experiment);
+        m_Map = ccc_test::MapTraits<Map>::Create(m_Count);
+        for (std::size_t i = 0; i < m_Count; ++i)
+        {
+            m_Map->insert(ccc_test::MapTraits<Map>::MakeEntry(static_cast<uint32_t>(2 * i)));
+        }
+        std::mt19937 Gen(42);
+        std::uniform_int_distribution<uint32_t> RandomKey(0, static_cast<uint32_t>(2 * m_Count - 1));
+        m_Keys.resize(m_Count);
+        for (std::size_t i = 0; i < m_Count; ++i)
+        {
+            m_Keys[i] = RandomKey(Gen);
+        }
+    }
+
+    void tearDown() override
+    {
+        delete m_Map;
+        m_Map = 0;
+    }
+
+    void Find()
+    {
+        std::size_t Found = 0;
+        for (std::size_t i = 0; i < m_Keys.size(); ++i)
+        {
+            Found += (m_Map->find(m_Keys[i]) != m_Map->end()) ? 1 : 0;
+        }
+        celero::DoNotOptimizeAway(Found);
+    }
+
+    Map* m_Map;
+    std::vector<uint32_t> m_Keys;
+};
+
+#endif /* CCC_CELERO_FIXTURES_H_ */
@@ -14,80 +14,9 @@
 #include <ccc/static_vector.h>
 #include <ccc/fixed_vector.h>
 
-#include <random>
+#include "celero_fixtures.h"
 
 const int N = 10000;
-int g_prev = 0;
-
-class ArrayFixture: public celero::TestFixture
-{
-public:
-    ArrayFixture()
-            : Gen(RandomDevice()), RandomBool(0.5), RandomInt(-100, 100)
-    {
-    }
-
-    inline bool FillArray(int* a, int N)
-    {
-        int prev = 0;
-        for (int i = 0; i < N; ++i)
-        {
-            a[i] = i * prev + prev * prev;
-            prev = a[i];
-        }
-        return true;
-    }
-
-    inline bool FillArrayWithMultiplication(int* a, int N)
-    {
-        int prev = 0;
-        for (int i = 0; i < N; ++i)
-        {
-            a[i] = i * prev + prev * prev;
-            prev = a[i];
-        }
-        return true;
-    }
-
-    template <typename T>
-    inline bool FillVectorWithMultiplication(T& v, int N)
-    {
-        int prev = 0;
-        for (int i = 0; i < N; ++i)
-        {
-            v.push_back(i * prev + prev * prev);
-            prev = v.back();
-        }
-        return true;
-    }
-
-    inline bool FillArrayWithRandom(int* a, int N)
-    {
-        for (int i = 0; i < N; ++i)
-        {
-            a[i] = RandomInt(RandomDevice);
-        }
-        return true;
-    }
-
-    template <typename T>
-    inline bool FillVectorWithRandom(T& v, int N)
-    {
-        for (int i = 0; i < N; ++i)
-        {
-            v.push_back(RandomInt(RandomDevice));
-        }
-        return true;
-    }
-
-    // Improved with Bernoulli distribution of booleans.
-    std::random_device RandomDevice;
-    std::mt19937 Gen;
-
-    // give "true" 1/2 of the time
-    std::bernoulli_distribution RandomBool;
-    std::uniform_int_distribution<int> RandomInt;
-};
 
 BENCHMARK_F(FillWithMultiplication, std_vector, ArrayFixture, 300, 100)
 {
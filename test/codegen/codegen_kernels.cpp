@@ -0,0 +1,106 @@
+/*
+ * codegen_kernels.cpp
+ *
+ *  Reference kernels of the hot container operations, compiled but never linked by
+ *  inline_report.py, which counts the instructions of each kernel and checks that no call to a
+ *  function of the library remains. The kernels have C linkage, so that their symbols are their
+ *  names, and take their containers by reference, so that nothing is known about their contents.
+ */
+
+#include <cstddef>
+#include <stdint.h>
+
+#include <ccc/fixed_vector.h>
+#include <ccc/pod_deque.h>
+#include <ccc/pod_hash_map.h>
+#include <ccc/pod_list.h>
+#include <ccc/pod_vector.h>
+
+typedef ccc::PodVector<int, uint32_t, 1024> Vector;
+typedef ccc::FixedVector<int, uint32_t> FixedVector;
+typedef ccc::PodDeque<int, uint32_t, 1024> Deque;
+typedef ccc::PodList<int, uint32_t, 1024> List;
+typedef ccc::PodHashMap<uint32_t, uint32_t, uint32_t, 1024> HashMap;
+
+extern "C"
+{
+
+void kernel_vector_push_back_loop(Vector& v, int Count)
+{
+    for (int i = 0; i < Count; ++i)
+    {
+        v.push_back(i);
+    }
+}
+
+int kernel_vector_index(const Vector& v, uint32_t Index)
+{
+    return v[Index];
+}
+
+long kernel_vector_iterate_sum(const Vector& v)
+{
+    long Sum = 0;
+    for (Vector::const_iterator i = v.begin(); i != v.end(); ++i)
+    {
+        Sum += *i;
+    }
+    return Sum;
+}
+
+void kernel_fixed_vector_push_back_loop(FixedVector& v, int Count)
+{
+    for (int i = 0; i < Count; ++i)
+    {
+        v.push_back(i);
+    }
+}
+
+int kernel_deque_index(const Deque& d, uint32_t Index)
+{
+    return d[Index];
+}
+
+long kernel_deque_iterate_sum(const Deque& d)
+{
+    long Sum = 0;
+    for (Deque::const_iterator i = d.begin(); i != d.end(); ++i)
+    {
+        Sum += *i;
+    }
+    return Sum;
+}
+
+void kernel_deque_push_back_pop_front(Deque& d, int Value)
+{
+    d.push_back(Value);
+    d.pop_front();
+}
+
+void kernel_deque_iterator_advance(Deque::iterator& Position, std::ptrdiff_t Distance)
+{
+    Position += Distance;
+}
+
+std::ptrdiff_t kernel_deque_iterator_distance(const Deque::iterator& First, const Deque::iterator& Last)
+{
+    return Last - First;
+}
+
+long kernel_list_iterate_sum(List& l)
+{
+    long Sum = 0;
+    for (List::iterator i = l.begin(); i != l.end(); ++i)
+    {
+        Sum += *i;
+    }
+    return Sum;
+}
+
+uint32_t kernel_hash_map_find(const HashMap& m, uint32_t Key)
+{
+    HashMap::const_iterator Found = m.find(Key);
+    return (Found == m.end()) ? 0 : Found->second;
+}
+
+}
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""
+inline_report.py
+
+Compiles the reference kernels of codegen_kernels.cpp at each optimization level, disassembles the
+object file with objdump and reports per kernel the number of instructions of its hot path, the
+number of instructions moved to a cold section (e.g. the throw of a full container) and the library
+functions it still calls. Fails if a kernel calls a function of namespace ccc from its hot path
+(an operation that was not inlined) or exceeds its instruction budget.
+
+    inline_report.py [--compiler c++] [--flags "-std=c++11"] [--levels O2,O3]
+                     [--budgets budgets.json] [--work-dir DIR] [--update-budgets]
+
+The budgets are stored per architecture (platform.machine()) and optimization level; on other
+architectures the report is printed without checks. --update-budgets replaces the budgets of the
+current architecture by the measured counts plus a margin of 25% (at least 4 instructions), for
+intended changes of the generated code and new compilers.
+"""
+
+import argparse
+import json
+import math
+import os
+import platform
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+
+FUNCTION_HEADER = re.compile(r"^[0-9a-f]+ <(?P<name>[^>]+)>:$")
+INSTRUCTION = re.compile(r"^\s+[0-9a-f]+:\t(?P<mnemonic>\S+)")
+RELOCATION = re.compile(r"^\s+[0-9a-f]+: R_\S+\s+(?P<target>\S+)")
+LIBRARY_SYMBOL = re.compile(r"_ZN[KVRO]*3ccc\w*")
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--compiler", default=os.environ.get("CXX", "c++"), help="C++ compiler (default: $CXX or c++)")
+    parser.add_argument("--flags", default="-std=c++11", help="compiler flags besides the optimization level (default: -std=c++11)")
+    parser.add_argument("--levels", default="O2,O3", help="comma-separated optimization levels (default: O2,O3)")
+    parser.add_argument("--include-dir", default=os.path.join(SCRIPT_DIR, "..", "..", "include"),
+                        help="include directory of the library")
+    parser.add_argument("--source", default=os.path.join(SCRIPT_DIR, "codegen_kernels.cpp"), help="kernel source")
+    parser.add_argument("--budgets", default=os.path.join(SCRIPT_DIR, "budgets.json"), help="instruction budgets")
+    parser.add_argument("--work-dir", default=None, help="directory of the object files (default: temporary)")
+    parser.add_argument("--update-budgets", action="store_true", help="store the measured counts as budgets")
+    return parser.parse_args()
+
+
+def demangle(names):
+    cxxfilt = shutil.which("c++filt")
+    if not names or not cxxfilt:
+        return dict((name, name) for name in names)
+    output = subprocess.run([cxxfilt], input="\n".join(names), stdout=subprocess.PIPE, universal_newlines=True,
+                            check=True).stdout
+    return dict(zip(names, output.splitlines()))
+
+
+def analyze(object_path):
+    """
+    Returns {kernel: {"instructions": n, "cold_instructions": n, "calls": [...], "cold_calls": [...]}}.
+    """
+    disassembly = subprocess.run(["objdump", "-d", "-r", "--no-show-raw-insn", object_path], stdout=subprocess.PIPE,
+                                 universal_newlines=True, check=True).stdout
+    kernels = {}
+    current = None
+    cold = False
+    for line in disassembly.splitlines():
+        header = FUNCTION_HEADER.match(line)
+        if header:
+            name = header.group("name")
+            cold = name.endswith(".cold")
+            name = name[:-len(".cold")] if cold else name
+            if name.startswith("kernel_"):
+                current = kernels.setdefault(name, {"instructions": 0, "cold_instructions": 0, "calls": [], "cold_calls": []})
+            else:
+                current = None
+            continue
+        if current is None:
+            continue
+        instruction = INSTRUCTION.match(line)
+        if instruction:
+            if not instruction.group("mnemonic").startswith("nop"):
+                current["cold_instructions" if cold else "instructions"] += 1
+            continue
+        relocation = RELOCATION.match(line)
+        if relocation:
+            symbol = LIBRARY_SYMBOL.search(relocation.group("target"))
+            calls = current["cold_calls" if cold else "calls"]
+            if symbol and symbol.group(0) not in calls:
+                calls.append(symbol.group(0))
+    return kernels
+
+
+def load_budgets(path):
+    if not os.path.exists(path):
+        return {}
+    with open(path) as file:
+        return json.load(file)
+
+
+def main():
+    arguments = parse_arguments()
+    if not shutil.which("objdump"):
+        print("objdump not found", file=sys.stderr)
+        return 1
+    if arguments.work_dir is None:
+        arguments.work_dir = tempfile.mkdtemp(prefix="ccc_codegen_")
+    os.makedirs(arguments.work_dir, exist_ok=True)
+    architecture = platform.machine()
+    budgets = load_budgets(arguments.budgets)
+    architecture_budgets = budgets.get(architecture)
+    if architecture_budgets is None and not arguments.update_budgets:
+        print("warning: no budgets for %s in %s, reporting only" % (architecture, arguments.budgets), file=sys.stderr)
+    measured = {}
+    failures = []
+    print("%-40s %-5s %12s %8s %6s  %s" % ("kernel", "level", "instructions", "budget", "cold", "calls"))
+    for level in [level for level in arguments.levels.split(",") if level]:
+        object_path = os.path.join(arguments.work_dir, "codegen_kernels_%s.o" % level)
+        command = ([arguments.compiler] + shlex.split(arguments.flags) +
+                   ["-" + level, "-ffunction-sections", "-I", arguments.include_dir, "-c", arguments.source, "-o", object_path])
+        if 0 != subprocess.call(command):
+            print("compilation failed: %s" % " ".join(command), file=sys.stderr)
+            return 1
+        kernels = analyze(object_path)
+        names = demangle(sorted(set(call for kernel in kernels.values() for call in kernel["calls"] + kernel["cold_calls"])))
+        for name in sorted(kernels):
+            kernel = kernels[name]
+            measured.setdefault(name, {})[level] = kernel["instructions"]
+            budget = (architecture_budgets or {}).get(name, {}).get(level)
+            calls = ", ".join(names[call] for call in kernel["calls"])
+            if kernel["cold_calls"]:
+                calls += (" " if calls else "") + "(cold: %s)" % ", ".join(names[call] for call in kernel["cold_calls"])
+            print("%-40s %-5s %12d %8s %6d  %s" % (name, level, kernel["instructions"], "-" if budget is None else budget,
+                                                   kernel["cold_instructions"], calls or "-"))
+            if architecture_budgets is None or arguments.update_budgets:
+                continue
+            if kernel["calls"]:
+                failures.append("%s -%s: not inlined: %s" % (name, level, ", ".join(names[call] for call in kernel["calls"])))
+            if budget is None:
+                failures.append("%s -%s: no budget" % (name, level))
+            elif kernel["instructions"] > budget:
+                failures.append("%s -%s: %d instructions, budget %d" % (name, level, kernel["instructions"], budget))
+    if arguments.update_budgets:
+        budgets[architecture] = dict(
+            (name, dict((level, max(count + 4, int(math.ceil(count * 1.25)))) for level, count in sorted(levels.items())))
+            for name, levels in sorted(measured.items()))
+        with open(arguments.budgets, "w") as file:
+            json.dump(budgets, file, indent=2, sort_keys=True)
+            file.write("\n")
+        print("budgets of %s written to %s" % (architecture, arguments.budgets))
+        return 0
+    if failures:
+        print("\n".join(["", "regressions:"] + failures), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+"""
+compare_benchmarks.py
+
+Compares gbenchmark results (JSON, written with --benchmark_repetitions) against a baseline. For each
+benchmark, the repetitions of both runs are compared with a two-sided Mann-Whitney U test; a benchmark
+is flagged as a regression if the difference is significant and its median time grew by more than the
+threshold of the benchmark.
+
+    compare_benchmarks.py BASELINE CONTENDER [--thresholds FILE] [--alpha 0.05] [--metric real_time]
+
+BASELINE and CONTENDER are either two JSON files or two directories, whose files are matched by name.
+Benchmarks missing on either side are listed but not compared. The thresholds file is JSON:
+
+    {"default": 0.05, "benchmarks": {"REGEX": 0.10, ...}}
+
+where the first regular expression matching (re.search) the benchmark name wins. Exits with 1 if any
+benchmark regressed and with 2 if no benchmark was compared at all (e.g. no baseline recorded), so
+that a missing baseline does not pass for a successful check.
+
+The test needs no third-party modules; it uses the normal approximation with tie correction, which is
+adequate from about 8 repetitions per side.
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import sys
+
+TIME_UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="baseline JSON file or directory")
+    parser.add_argument("contender", help="contender JSON file or directory")
+    parser.add_argument("--thresholds", default=None, help="JSON file of relative thresholds")
+    parser.add_argument("--alpha", type=float, default=0.05, help="significance level (default: 0.05)")
+    parser.add_argument("--metric", default="real_time", choices=["real_time", "cpu_time"],
+                        help="compared time (default: real_time)")
+    parser.add_argument("--all", action="store_true", help="also list unchanged benchmarks")
+    return parser.parse_args()
+
+
+def load_samples(path, metric):
+    """
+    Returns the times in seconds of all repetitions, by benchmark name. Aggregates are ignored.
+    """
+    with open(path) as f:
+        results = json.load(f)
+    samples = {}
+    for benchmark in results.get("benchmarks", []):
+        if benchmark.get("run_type", "iteration") != "iteration":
+            continue
+        if "error_occurred" in benchmark:
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        time = benchmark[metric] * TIME_UNITS[benchmark.get("time_unit", "ns")]
+        samples.setdefault(name, []).append(time)
+    return samples
+
+
+def result_pairs(baseline, contender):
+    """
+    Returns (label, baseline file, contender file) of the results to compare.
+    """
+    if os.path.isdir(baseline) != os.path.isdir(contender):
+        raise SystemExit("error: compare two files or two directories")
+    if not os.path.isdir(baseline):
+        return [(os.path.basename(contender), baseline, contender)]
+    pairs = []
+    for name in sorted(os.listdir(contender)):
+        if not name.endswith(".json"):
+            continue
+        reference = os.path.join(baseline, name)
+        if os.path.exists(reference):
+            pairs.append((name, reference, os.path.join(contender, name)))
+        else:
+            print("%s: no baseline, skipped" % name)
+    return pairs
+
+
+def load_thresholds(path):
+    if path is None:
+        return 0.05, []
+    with open(path) as f:
+        thresholds = json.load(f)
+    patterns = [(re.compile(pattern), value) for pattern, value in thresholds.get("benchmarks", {}).items()]
+    return thresholds.get("default", 0.05), patterns
+
+
+def threshold_of(name, default, patterns):
+    for pattern, value in patterns:
+        if pattern.search(name):
+            return value
+    return default
+
+
+def median(values):
+    ordered = sorted(values)
+    middle = len(ordered) // 2
+    if len(ordered) % 2:
+        return ordered[middle]
+    return 0.5 * (ordered[middle - 1] + ordered[middle])
+
+
+def mann_whitney_u(a, b):
+    """
+    Returns the U statistic of a and the two-sided p-value (normal approximation with tie and
+    continuity correction).
+    """
+    n1 = len(a)
+    n2 = len(b)
+    n = n1 + n2
+    combined = sorted([(value, 0) for value in a] + [(value, 1) for value in b])
+    rank_sum = 0.0
+    ties = 0.0
+    i = 0
+    while i < n:
+        j = i
+        while j + 1 < n and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        rank = 0.5 * (i + j) + 1.0  # average rank of the tied group
+        count = j - i + 1
+        ties += count ** 3 - count
+        rank_sum += rank * sum(1 for k in range(i, j + 1) if combined[k][1] == 0)
+        i = j + 1
+    u = rank_sum - 0.5 * n1 * (n1 + 1)
+    mean = 0.5 * n1 * n2
+    variance = n1 * n2 / 12.0 * ((n + 1) - ties / (n * (n - 1)))
+    if variance <= 0.0:
+        return u, 1.0
+    z = max(abs(u - mean) - 0.5, 0.0) / math.sqrt(variance)
+    return u, math.erfc(z / math.sqrt(2.0))
+
+
+def format_time(seconds):
+    for unit, scale in (("s", 1.0), ("ms", 1e-3), ("us", 1e-6)):
+        if seconds >= scale:
+            return "%.3g %s" % (seconds / scale, unit)
+    return "%.3g ns" % (seconds / 1e-9)
+
+
+def compare(label, baseline, contender, arguments, default, patterns):
+    """
+    Prints the comparison of two result files and returns the number of regressions and of compared
+    benchmarks.
+    """
+    reference = load_samples(baseline, arguments.metric)
+    current = load_samples(contender, arguments.metric)
+    print("%s:" % label)
+    regressions = 0
+    compared = 0
+    for name in sorted(set(reference) | set(current)):
+        if name not in reference or name not in current:
+            print("  %-60s %s" % (name, "only in baseline" if name in reference else "new"))
+            continue
+        old = reference[name]
+        new = current[name]
+        if min(len(old), len(new)) < 2:
+            print("  %-60s needs repetitions" % name)
+            continue
+        compared += 1
+        change = median(new) / median(old) - 1.0
+        _, p = mann_whitney_u(old, new)
+        threshold = threshold_of(name, default, patterns)
+        verdict = ""
+        if p < arguments.alpha and change > threshold:
+            verdict = "REGRESSION"
+            regressions += 1
+        elif p < arguments.alpha and change < -threshold:
+            verdict = "improvement"
+        if verdict or arguments.all:
+            print("  %-60s %10s -> %10s %+7.1f%% (p=%.3f, threshold %.0f%%) %s" % (
+                name, format_time(median(old)), format_time(median(new)), 100.0 * change, p, 100.0 * threshold,
+                verdict))
+    return regressions, compared
+
+
+def main():
+    arguments = parse_arguments()
+    default, patterns = load_thresholds(arguments.thresholds)
+    regressions = 0
+    compared = 0
+    for label, baseline, contender in result_pairs(arguments.baseline, arguments.contender):
+        file_regressions, file_compared = compare(label, baseline, contender, arguments, default, patterns)
+        regressions += file_regressions
+        compared += file_compared
+    print("%d regression(s) in %d compared benchmark(s)" % (regressions, compared))
+    if regressions:
+        return 1
+    if not compared:
+        print("error: no benchmark was compared; record a baseline with benchmark_update_baseline",
+              file=sys.stderr)
+        return 2
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,218 @@
+/*
+ * gbenchmark_Array.cpp
+ *
+ *  Operations of arrays across element sizes and counts: a std::vector of fixed size versus
+ *  ccc::PODArray (one type per element count), ccc::FixedArray and ccc::DynamicArray. The arrays
+ *  have neither copy assignment nor swap, so copying and swapping use std::copy and std::swap_ranges
+ *  for all of them.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+#include <ccc/pod_array.h>
+#include <ccc/fixed_array.h>
+#include <ccc/dynamic_array.h>
+
+#include <ccc/test/container_benchmarks.h>
+
+using namespace ccc_test;
+
+template <class Array>
+struct ArrayFactory
+{
+    static Array* Create(std::size_t)
+    {
+        return new Array();
+    }
+};
+
+template <class T>
+struct ArrayFactory<std::vector<T> >
+{
+    static std::vector<T>* Create(std::size_t Count)
+    {
+        return new std::vector<T>(Count);
+    }
+};
+
+template <class T, class SizeType>
+struct ArrayFactory<ccc::FixedArray<T, SizeType> >
+{
+    static ccc::FixedArray<T, SizeType>* Create(std::size_t Count)
+    {
+        return new ccc::FixedArray<T, SizeType>(static_cast<SizeType>(Count));
+    }
+};
+
+template <class T, class SizeType>
+struct ArrayFactory<ccc::DynamicArray<T, SizeType> >
+{
+    static ccc::DynamicArray<T, SizeType>* Create(std::size_t Count)
+    {
+        return new ccc::DynamicArray<T, SizeType>(static_cast<SizeType>(Count));
+    }
+};
+
+template <class Array>
+static Array* CreateArray(std::size_t Count)
+{
+    typedef typename Array::value_type value_type;
+    Array* Result = ArrayFactory<Array>::Create(Count);
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        (*Result)[i] = MakeValue<value_type>(static_cast<uint32_t>(i));
+    }
+    return Result;
+}
+
+template <class Array>
+static void BM_ArrayFill(benchmark::State& state)
+{
+    typedef typename Array::value_type value_type;
+    const std::size_t Count = state.range(0);
+    Array* a = CreateArray<Array>(Count);
+    const value_type Value = MakeValue<value_type>(1);
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        std::fill(a->begin(), a->end(), Value);
+        benchmark::DoNotOptimize((*a)[Count - 1]);
+    }
+    Counters.report(state, state.iterations() * Count);
+    state.SetItemsProcessed(state.iterations() * Count);
+    delete a;
+}
+
+template <class Array>
+static void BM_ArrayIterate(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Array* a = CreateArray<Array>(Count);
+    const Array& Values = *a;
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        uint32_t Sum = 0;
+        for (typename Array::const_iterator it = Values.begin(); it != Values.end(); ++it)
+        {
+            Sum += it->m_Key;
+        }
+        benchmark::DoNotOptimize(Sum);
+    }
+    Counters.report(state, state.iterations() * Count);
+    state.SetItemsProcessed(state.iterations() * Count);
+    delete a;
+}
+
+template <class Array>
+static void BM_ArrayRandomAccess(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Array* a = CreateArray<Array>(Count);
+    std::vector<uint32_t> Indices(1024);
+    uint32_t Random = 42;
+    for (std::size_t i = 0; i < Indices.size(); ++i)
+    {
+        Random = Random * 1664525u + 1013904223u;
+        Indices[i] = (Random >> 8) % Count;
+    }
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        uint32_t Sum = 0;
+        for (std::size_t i = 0; i < Indices.size(); ++i)
+        {
+            Sum += (*a)[Indices[i]].m_Key;
+        }
+        benchmark::DoNotOptimize(Sum);
+    }
+    Counters.report(state, state.iterations() * Indices.size());
+    state.SetItemsProcessed(state.iterations() * Indices.size());
+    delete a;
+}
+
+template <class Array>
+static void BM_ArrayCopy(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Array* Source = CreateArray<Array>(Count);
+    Array* Destination = ArrayFactory<Array>::Create(Count);
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        std::copy(Source->begin(), Source->end(), Destination->begin());
+        benchmark::DoNotOptimize((*Destination)[Count - 1]);
+    }
+    Counters.report(state, state.iterations() * Count);
+    state.SetItemsProcessed(state.iterations() * Count);
+    delete Destination;
+    delete Source;
+}
+
+template <class Array>
+static void BM_ArraySwap(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Array* a = CreateArray<Array>(Count);
+    Array* b = CreateArray<Array>(Count);
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        std::swap_ranges(a->begin(), a->end(), b->begin());
+        benchmark::DoNotOptimize((*a)[Count - 1]);
+    }
+    Counters.report(state, state.iterations() * Count);
+    state.SetItemsProcessed(state.iterations() * Count);
+    delete b;
+    delete a;
+}
+
+#define REGISTER_ARRAY_BENCHMARKS(Array, Counts) \
+    BENCHMARK_TEMPLATE(BM_ArrayFill, Array)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_ArrayIterate, Array)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_ArrayRandomAccess, Array)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_ArrayCopy, Array)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_ArraySwap, Array)->Apply(Counts)
+
+#define REGISTER_ARRAYS(Bytes) \
+    typedef std::vector<Payload<Bytes> > StdVector_##Bytes##B; \
+    typedef ccc::FixedArray<Payload<Bytes>, uint32_t> FixedArray_##Bytes##B; \
+    typedef ccc::DynamicArray<Payload<Bytes>, uint32_t> DynamicArray_##Bytes##B; \
+    REGISTER_ARRAY_BENCHMARKS(StdVector_##Bytes##B, ElementCounts<Bytes>); \
+    REGISTER_ARRAY_BENCHMARKS(FixedArray_##Bytes##B, ElementCounts<Bytes>); \
+    REGISTER_ARRAY_BENCHMARKS(DynamicArray_##Bytes##B, ElementCounts<Bytes>)
+
+#define REGISTER_POD_ARRAY(Bytes, Count) \
+    typedef ccc::PODArray<Payload<Bytes>, uint32_t, Count> PODArray_##Bytes##B_##Count; \
+    REGISTER_ARRAY_BENCHMARKS(PODArray_##Bytes##B_##Count, ElementCount<Count>)
+
+REGISTER_ARRAYS(4);
+REGISTER_POD_ARRAY(4, 16);
+REGISTER_POD_ARRAY(4, 256);
+REGISTER_POD_ARRAY(4, 4096);
+REGISTER_POD_ARRAY(4, 65536);
+REGISTER_POD_ARRAY(4, 1048576);
+
+REGISTER_ARRAYS(16);
+REGISTER_POD_ARRAY(16, 16);
+REGISTER_POD_ARRAY(16, 256);
+REGISTER_POD_ARRAY(16, 4096);
+REGISTER_POD_ARRAY(16, 65536);
+REGISTER_POD_ARRAY(16, 1048576);
+
+REGISTER_ARRAYS(64);
+REGISTER_POD_ARRAY(64, 16);
+REGISTER_POD_ARRAY(64, 256);
+REGISTER_POD_ARRAY(64, 4096);
+REGISTER_POD_ARRAY(64, 65536);
+REGISTER_POD_ARRAY(64, 1048576);
+
+REGISTER_ARRAYS(256);
+REGISTER_POD_ARRAY(256, 16);
+REGISTER_POD_ARRAY(256, 256);
+REGISTER_POD_ARRAY(256, 4096);
+REGISTER_POD_ARRAY(256, 65536);
+
+BENCHMARK_MAIN();
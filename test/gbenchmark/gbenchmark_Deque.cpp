@@ -0,0 +1,68 @@
+/*
+ * gbenchmark_Deque.cpp
+ *
+ *  Operations of std::deque, ccc::StaticDeque and ccc::FixedDeque across element sizes and counts,
+ *  see ccc/test/container_benchmarks.h. The capacity of a StaticDeque is a template argument, so there
+ *  is one type per element count; the FixedDeque holds exactly the element count.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <ccc/static_deque.h>
+#include <ccc/fixed_deque.h>
+
+#include <ccc/test/container_benchmarks.h>
+
+using namespace ccc_test;
+
+#define REGISTER_DEQUE_BENCHMARKS(Container, Counts) \
+    BENCHMARK_TEMPLATE(BM_PushBackPopBack, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_PushFrontPopFront, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_InsertEraseFront, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_InsertEraseMiddle, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_InsertEraseBack, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_Iterate, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_RandomAccess, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_Copy, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_Swap, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_Clear, Container)->Apply(Counts)
+
+#define REGISTER_DEQUES(Bytes) \
+    typedef std::deque<Payload<Bytes> > StdDeque_##Bytes##B; \
+    typedef ccc::FixedDeque<Payload<Bytes>, uint32_t> FixedDeque_##Bytes##B; \
+    REGISTER_DEQUE_BENCHMARKS(StdDeque_##Bytes##B, ElementCounts<Bytes>); \
+    REGISTER_DEQUE_BENCHMARKS(FixedDeque_##Bytes##B, ElementCounts<Bytes>)
+
+#define REGISTER_STATIC_DEQUE(Bytes, Count) \
+    typedef ccc::StaticDeque<Payload<Bytes>, uint32_t, Count> StaticDeque_##Bytes##B_##Count; \
+    REGISTER_DEQUE_BENCHMARKS(StaticDeque_##Bytes##B_##Count, ElementCount<Count>)
+
+REGISTER_DEQUES(4);
+REGISTER_STATIC_DEQUE(4, 16);
+REGISTER_STATIC_DEQUE(4, 256);
+REGISTER_STATIC_DEQUE(4, 4096);
+REGISTER_STATIC_DEQUE(4, 65536);
+REGISTER_STATIC_DEQUE(4, 1048576);
+
+REGISTER_DEQUES(16);
+REGISTER_STATIC_DEQUE(16, 16);
+REGISTER_STATIC_DEQUE(16, 256);
+REGISTER_STATIC_DEQUE(16, 4096);
+REGISTER_STATIC_DEQUE(16, 65536);
+REGISTER_STATIC_DEQUE(16, 1048576);
+
+REGISTER_DEQUES(64);
+REGISTER_STATIC_DEQUE(64, 16);
+REGISTER_STATIC_DEQUE(64, 256);
+REGISTER_STATIC_DEQUE(64, 4096);
+REGISTER_STATIC_DEQUE(64, 65536);
+REGISTER_STATIC_DEQUE(64, 1048576);
+
+REGISTER_DEQUES(256);
+REGISTER_STATIC_DEQUE(256, 16);
+REGISTER_STATIC_DEQUE(256, 256);
+REGISTER_STATIC_DEQUE(256, 4096);
+REGISTER_STATIC_DEQUE(256, 65536);
+
+BENCHMARK_MAIN();
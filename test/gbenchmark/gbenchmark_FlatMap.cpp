@@ -0,0 +1,90 @@
+/*
+ * gbenchmark_FlatMap.cpp
+ *
+ *  Lookup latency of sorted associative containers of a few thousand entries.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include <ccc/pod_flat_map.h>
+
+static const unsigned int MaxEntries = 1 << 16;
+
+typedef ccc::PodFlatMap<int, int, unsigned int, MaxEntries> FlatMap;
+typedef ccc::PodFlatMap<int, int, unsigned int, MaxEntries, std::less<int>, 8, true> EytzingerFlatMap;
+
+// keys are the even numbers, so that half of the lookups miss
+static std::vector<int> MakeLookups(int Count)
+{
+    std::vector<int> Lookups(1024);
+    std::srand(42);
+    for (std::size_t i = 0; i < Lookups.size(); ++i)
+    {
+        Lookups[i] = std::rand() % (2 * Count);
+    }
+    return Lookups;
+}
+
+static void BM_StdMapFind(benchmark::State& state)
+{
+    const int Count = state.range(0);
+    std::map<int, int> m;
+    for (int i = 0; i < Count; ++i)
+    {
+        m[2 * i] = i;
+    }
+    std::vector<int> Lookups = MakeLookups(Count);
+    std::size_t i = 0;
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(m.find(Lookups[i++ & 1023]));
+    }
+}
+BENCHMARK(BM_StdMapFind)->Range(16, MaxEntries);
+
+static void BM_StdLowerBound(benchmark::State& state)
+{
+    const int Count = state.range(0);
+    std::vector<int> v;
+    for (int i = 0; i < Count; ++i)
+    {
+        v.push_back(2 * i);
+    }
+    std::vector<int> Lookups = MakeLookups(Count);
+    std::size_t i = 0;
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(std::lower_bound(v.begin(), v.end(), Lookups[i++ & 1023]));
+    }
+}
+BENCHMARK(BM_StdLowerBound)->Range(16, MaxEntries);
+
+template <typename TMap>
+static void BM_FlatMapFind(benchmark::State& state)
+{
+    const int Count = state.range(0);
+    // too large for the stack
+    std::vector<TMap> Storage(1);
+    TMap& m = Storage.front();
+    for (int i = 0; i < Count; ++i)
+    {
+        typename TMap::value_type Value = { 2 * i, i };
+        m.insert(Value);
+    }
+    m.rebuild_layout();
+    std::vector<int> Lookups = MakeLookups(Count);
+    std::size_t i = 0;
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(m.find(Lookups[i++ & 1023]));
+    }
+}
+BENCHMARK_TEMPLATE(BM_FlatMapFind, FlatMap)->Range(16, MaxEntries);
+BENCHMARK_TEMPLATE(BM_FlatMapFind, EytzingerFlatMap)->Range(16, MaxEntries);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,305 @@
+/*
+ * gbenchmark_Latency.cpp
+ *
+ *  Latency distributions of single operations: each operation is timed on its own with the cycle
+ *  clock of ccc/test/latency_histogram.h, and the benchmarks report the 50th, 99th and 99.9th
+ *  percentile and the maximum in nanoseconds (p50_ns, p99_ns, p999_ns, max_ns) next to the overhead of
+ *  a timestamp pair (timer_ns), which is included in every sample. The time per iteration of
+ *  gbenchmark covers a whole round including its untimed preparation and is of little interest here.
+ *
+ *  The std:: containers run the same workload as the ccc containers. Where the workload starts from
+ *  empty containers, the std:: containers are not reserved, so their tails show the reallocations
+ *  (std::vector), block allocations (std::deque) and rehashes (std::unordered_map) that the
+ *  containers with fixed capacity do not have. The first touch of fresh memory (page faults) shows in
+ *  the tails of both.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <list>
+#include <map>
+#include <vector>
+#if __cplusplus >= 201103L
+#include <unordered_map>
+#endif
+
+#include <ccc/test/container_benchmarks.h>
+
+using namespace ccc_test;
+
+/**
+ * Creates an empty container like Factory, but leaves the std:: containers unreserved.
+ */
+template <class Container>
+struct EmptyContainer
+{
+    static Container* Create(std::size_t Capacity)
+    {
+        return Factory<Container>::Create(Capacity);
+    }
+};
+
+template <class T>
+struct EmptyContainer<std::vector<T> >
+{
+    static std::vector<T>* Create(std::size_t)
+    {
+        return new std::vector<T>();
+    }
+};
+
+template <class Map>
+struct EmptyMap
+{
+    static Map* Create(std::size_t Count)
+    {
+        return MapTraits<Map>::Create(Count);
+    }
+};
+
+#if __cplusplus >= 201103L
+template <class K, class T>
+struct EmptyMap<std::unordered_map<K, T> >
+{
+    static std::unordered_map<K, T>* Create(std::size_t)
+    {
+        return new std::unordered_map<K, T>();
+    }
+};
+#endif
+
+// Sequence containers:
+
+/**
+ * Each round fills a new container with state.range(0) elements.
+ */
+template <class Container>
+static void BM_PushBackLatency(benchmark::State& state)
+{
+    typedef typename Container::value_type value_type;
+    const std::size_t Count = state.range(0);
+    const value_type Value = MakeValue<value_type>(1);
+    LatencyHistogram Histogram;
+    while (state.KeepRunning())
+    {
+        Container* c = EmptyContainer<Container>::Create(Count);
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            const uint64_t Start = CycleClock::now();
+            c->push_back(Value);
+            Histogram.record(CycleClock::now() - Start);
+        }
+        benchmark::DoNotOptimize(c->back());
+        delete c;
+    }
+    ReportLatencies(state, Histogram);
+}
+
+/**
+ * Each round grows a container from half of state.range(0) elements to state.range(0) - 1 by
+ * inserting in the middle, then shrinks it back untimed.
+ */
+template <class Container>
+static void BM_InsertMiddleLatency(benchmark::State& state)
+{
+    typedef typename Container::value_type value_type;
+    const std::size_t Count = state.range(0);
+    Container* c = CreateFilled<Container>(Count, Count / 2);
+    const value_type Value = MakeValue<value_type>(1);
+    LatencyHistogram Histogram;
+    while (state.KeepRunning())
+    {
+        for (std::size_t i = Count / 2; i + 1 < Count; ++i)
+        {
+            typename Container::iterator Position = c->begin() + static_cast<std::ptrdiff_t>(c->size() / 2);
+            const uint64_t Start = CycleClock::now();
+            c->insert(Position, Value);
+            Histogram.record(CycleClock::now() - Start);
+        }
+        c->erase(c->begin() + static_cast<std::ptrdiff_t>(Count / 2), c->end());
+    }
+    ReportLatencies(state, Histogram);
+    delete c;
+}
+
+/**
+ * Each round refills a container to state.range(0) elements untimed and erases half of them in the
+ * middle.
+ */
+template <class Container>
+static void BM_EraseMiddleLatency(benchmark::State& state)
+{
+    typedef typename Container::value_type value_type;
+    const std::size_t Count = state.range(0);
+    Container* c = CreateFilled<Container>(Count, Count);
+    const value_type Value = MakeValue<value_type>(1);
+    LatencyHistogram Histogram;
+    while (state.KeepRunning())
+    {
+        for (std::size_t i = 0; i < Count / 2; ++i)
+        {
+            typename Container::iterator Position = c->begin() + static_cast<std::ptrdiff_t>(c->size() / 2);
+            const uint64_t Start = CycleClock::now();
+            c->erase(Position);
+            Histogram.record(CycleClock::now() - Start);
+        }
+        while (c->size() < Count)
+        {
+            c->push_back(Value);
+        }
+    }
+    ReportLatencies(state, Histogram);
+    delete c;
+}
+
+/**
+ * Each round refills a container to state.range(0) elements untimed and empties it with pop_front.
+ */
+template <class Container>
+static void BM_PopFrontLatency(benchmark::State& state)
+{
+    typedef typename Container::value_type value_type;
+    const std::size_t Count = state.range(0);
+    Container* c = Factory<Container>::Create(Count);
+    const value_type Value = MakeValue<value_type>(1);
+    LatencyHistogram Histogram;
+    while (state.KeepRunning())
+    {
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            c->push_back(Value);
+        }
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            const uint64_t Start = CycleClock::now();
+            c->pop_front();
+            Histogram.record(CycleClock::now() - Start);
+        }
+    }
+    ReportLatencies(state, Histogram);
+    delete c;
+}
+
+// Maps:
+
+static std::vector<uint32_t> ShuffledKeys(std::size_t Count)
+{
+    std::vector<uint32_t> Keys(Count);
+    uint32_t Random = 42;
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        Keys[i] = static_cast<uint32_t>(i);
+    }
+    for (std::size_t i = Count - 1; i > 0; --i)
+    {
+        Random = Random * 1664525u + 1013904223u;
+        std::swap(Keys[i], Keys[(Random >> 8) % (i + 1)]);
+    }
+    return Keys;
+}
+
+/**
+ * Each round inserts state.range(0) keys in random order into a new map.
+ */
+template <class Map>
+static void BM_MapInsertLatency(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    const std::vector<uint32_t> Keys = ShuffledKeys(Count);
+    LatencyHistogram Histogram;
+    while (state.KeepRunning())
+    {
+        Map* m = EmptyMap<Map>::Create(Count);
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            const typename Map::value_type Entry = MapTraits<Map>::MakeEntry(Keys[i]);
+            const uint64_t Start = CycleClock::now();
+            m->insert(Entry);
+            Histogram.record(CycleClock::now() - Start);
+        }
+        benchmark::DoNotOptimize(m->size());
+        delete m;
+    }
+    ReportLatencies(state, Histogram);
+}
+
+/**
+ * Each round looks up all keys of a map of state.range(0) elements in random order.
+ */
+template <class Map>
+static void BM_MapFindLatency(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    const std::vector<uint32_t> Keys = ShuffledKeys(Count);
+    Map* m = MapTraits<Map>::Create(Count);
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        m->insert(MapTraits<Map>::MakeEntry(Keys[i]));
+    }
+    LatencyHistogram Histogram;
+    while (state.KeepRunning())
+    {
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            const uint64_t Start = CycleClock::now();
+            benchmark::DoNotOptimize(m->find(Keys[i]));
+            Histogram.record(CycleClock::now() - Start);
+        }
+    }
+    ReportLatencies(state, Histogram);
+    delete m;
+}
+
+static void LatencyCounts(benchmark::internal::Benchmark* Benchmark)
+{
+    Benchmark->Arg(4096)->Arg(65536);
+}
+
+typedef Payload<16> Element;
+
+typedef std::vector<Element> StdVector;
+typedef std::deque<Element> StdDeque;
+typedef std::list<Element> StdList;
+typedef ccc::FixedVector<Element, uint32_t> FixedVector;
+typedef ccc::FixedDeque<Element, uint32_t> FixedDeque;
+typedef ccc::FixedList<Element, uint32_t> FixedList;
+
+BENCHMARK_TEMPLATE(BM_PushBackLatency, StdVector)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_PushBackLatency, FixedVector)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_PushBackLatency, StdDeque)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_PushBackLatency, FixedDeque)->Apply(LatencyCounts);
+
+BENCHMARK_TEMPLATE(BM_InsertMiddleLatency, StdVector)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_InsertMiddleLatency, FixedVector)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_InsertMiddleLatency, StdDeque)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_InsertMiddleLatency, FixedDeque)->Apply(LatencyCounts);
+
+BENCHMARK_TEMPLATE(BM_EraseMiddleLatency, StdVector)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_EraseMiddleLatency, FixedVector)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_EraseMiddleLatency, StdDeque)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_EraseMiddleLatency, FixedDeque)->Apply(LatencyCounts);
+
+BENCHMARK_TEMPLATE(BM_PopFrontLatency, StdDeque)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_PopFrontLatency, FixedDeque)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_PopFrontLatency, StdList)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_PopFrontLatency, FixedList)->Apply(LatencyCounts);
+
+typedef std::map<uint32_t, Element> StdMap;
+typedef ccc::FixedFlatMap<uint32_t, Element, uint32_t> FixedFlatMap;
+typedef ccc::FixedHashMap<uint32_t, Element, uint32_t> FixedHashMap;
+
+BENCHMARK_TEMPLATE(BM_MapInsertLatency, StdMap)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_MapInsertLatency, FixedFlatMap)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_MapInsertLatency, FixedHashMap)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_MapFindLatency, StdMap)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_MapFindLatency, FixedFlatMap)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_MapFindLatency, FixedHashMap)->Apply(LatencyCounts);
+
+#if __cplusplus >= 201103L
+typedef std::unordered_map<uint32_t, Element> StdUnorderedMap;
+BENCHMARK_TEMPLATE(BM_MapInsertLatency, StdUnorderedMap)->Apply(LatencyCounts);
+BENCHMARK_TEMPLATE(BM_MapFindLatency, StdUnorderedMap)->Apply(LatencyCounts);
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,65 @@
+/*
+ * gbenchmark_List.cpp
+ *
+ *  Operations of std::list, ccc::StaticList and ccc::FixedList across element sizes and counts, see
+ *  ccc/test/container_benchmarks.h. There is one StaticList type per element count, up to 65536
+ *  elements (its constructor builds the free list in a temporary on the stack); the FixedList holds
+ *  exactly the element count. Lists have no random access.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <list>
+#include <ccc/static_list.h>
+#include <ccc/fixed_list.h>
+
+#include <ccc/test/container_benchmarks.h>
+
+using namespace ccc_test;
+
+#define REGISTER_LIST_BENCHMARKS(Container, Counts) \
+    BENCHMARK_TEMPLATE(BM_PushBackPopBack, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_PushFrontPopFront, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_InsertEraseFront, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_InsertEraseMiddle, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_InsertEraseBack, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_Iterate, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_Copy, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_Swap, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_Clear, Container)->Apply(Counts)
+
+#define REGISTER_LISTS(Bytes) \
+    typedef std::list<Payload<Bytes> > StdList_##Bytes##B; \
+    typedef ccc::FixedList<Payload<Bytes>, uint32_t> FixedList_##Bytes##B; \
+    REGISTER_LIST_BENCHMARKS(StdList_##Bytes##B, ElementCounts<Bytes>); \
+    REGISTER_LIST_BENCHMARKS(FixedList_##Bytes##B, ElementCounts<Bytes>)
+
+#define REGISTER_STATIC_LIST(Bytes, Count) \
+    typedef ccc::StaticList<Payload<Bytes>, uint32_t, Count> StaticList_##Bytes##B_##Count; \
+    REGISTER_LIST_BENCHMARKS(StaticList_##Bytes##B_##Count, ElementCount<Count>)
+
+REGISTER_LISTS(4);
+REGISTER_STATIC_LIST(4, 16);
+REGISTER_STATIC_LIST(4, 256);
+REGISTER_STATIC_LIST(4, 4096);
+REGISTER_STATIC_LIST(4, 65536);
+
+REGISTER_LISTS(16);
+REGISTER_STATIC_LIST(16, 16);
+REGISTER_STATIC_LIST(16, 256);
+REGISTER_STATIC_LIST(16, 4096);
+REGISTER_STATIC_LIST(16, 65536);
+
+REGISTER_LISTS(64);
+REGISTER_STATIC_LIST(64, 16);
+REGISTER_STATIC_LIST(64, 256);
+REGISTER_STATIC_LIST(64, 4096);
+REGISTER_STATIC_LIST(64, 65536);
+
+REGISTER_LISTS(256);
+REGISTER_STATIC_LIST(256, 16);
+REGISTER_STATIC_LIST(256, 256);
+REGISTER_STATIC_LIST(256, 4096);
+REGISTER_STATIC_LIST(256, 65536);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,173 @@
+/*
+ * gbenchmark_Map.cpp
+ *
+ *  Operations of associative containers with uint32_t keys across mapped sizes and element counts:
+ *  std::map and std::unordered_map versus ccc::FixedFlatMap and ccc::FixedHashMap. The FixedFlatMap
+ *  holds exactly the element count, the FixedHashMap has 1.5 buckets per element (load about 67%).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <ccc/test/container_benchmarks.h>
+
+using namespace ccc_test;
+
+// keys are the even numbers below 2 * Count
+template <class Map>
+static Map* CreateFilledMap(std::size_t Capacity, std::size_t Count)
+{
+    Map* Result = MapTraits<Map>::Create(Capacity);
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        Result->insert(MapTraits<Map>::MakeEntry(static_cast<uint32_t>(2 * i)));
+    }
+    return Result;
+}
+
+static std::vector<uint32_t> RandomKeys(std::size_t Count, uint32_t Odd)
+{
+    std::vector<uint32_t> Keys(1024);
+    uint32_t Random = 42;
+    for (std::size_t i = 0; i < Keys.size(); ++i)
+    {
+        Random = Random * 1664525u + 1013904223u;
+        Keys[i] = 2 * ((Random >> 8) % Count) + Odd;
+    }
+    return Keys;
+}
+
+template <class Map>
+static void BM_MapFind(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Map* m = CreateFilledMap<Map>(Count, Count);
+    const std::vector<uint32_t> Keys = RandomKeys(Count, 0);
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        for (std::size_t i = 0; i < Keys.size(); ++i)
+        {
+            benchmark::DoNotOptimize(m->find(Keys[i]));
+        }
+    }
+    Counters.report(state, state.iterations() * Keys.size());
+    state.SetItemsProcessed(state.iterations() * Keys.size());
+    delete m;
+}
+
+/**
+ * Inserts a missing key and erases it again; the size stays state.range(0) - 1.
+ */
+template <class Map>
+static void BM_MapInsertErase(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Map* m = CreateFilledMap<Map>(Count, Count - 1);
+    const std::vector<uint32_t> Keys = RandomKeys(Count - 1, 1);
+    std::size_t i = 0;
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        const uint32_t Key = Keys[i++ & 1023];
+        m->insert(MapTraits<Map>::MakeEntry(Key));
+        benchmark::DoNotOptimize(m->erase(Key));
+    }
+    Counters.report(state, state.iterations());
+    state.SetItemsProcessed(state.iterations());
+    delete m;
+}
+
+template <class Map>
+static void BM_MapIterate(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Map* m = CreateFilledMap<Map>(Count, Count);
+    const Map& Values = *m;
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        uint32_t Sum = 0;
+        for (typename Map::const_iterator it = Values.begin(); it != Values.end(); ++it)
+        {
+            Sum += it->first;
+        }
+        benchmark::DoNotOptimize(Sum);
+    }
+    Counters.report(state, state.iterations() * Count);
+    state.SetItemsProcessed(state.iterations() * Count);
+    delete m;
+}
+
+template <class Map>
+static void BM_MapCopy(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Map* Source = CreateFilledMap<Map>(Count, Count);
+    Map* Destination = MapTraits<Map>::Create(Count);
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        *Destination = *Source;
+        benchmark::DoNotOptimize(Destination->size());
+    }
+    Counters.report(state, state.iterations() * Count);
+    state.SetItemsProcessed(state.iterations() * Count);
+    delete Destination;
+    delete Source;
+}
+
+template <class Map>
+static void BM_MapClear(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Map* m = MapTraits<Map>::Create(Count);
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            m->insert(MapTraits<Map>::MakeEntry(static_cast<uint32_t>(2 * i)));
+        }
+        state.ResumeTiming();
+        m->clear();
+        benchmark::DoNotOptimize(m->size());
+    }
+    Counters.report(state, state.iterations() * Count);
+    state.SetItemsProcessed(state.iterations() * Count);
+    delete m;
+}
+
+#define REGISTER_MAP_BENCHMARKS(Map, Counts) \
+    BENCHMARK_TEMPLATE(BM_MapFind, Map)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_MapInsertErase, Map)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_MapIterate, Map)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_MapCopy, Map)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_MapClear, Map)->Apply(Counts)
+
+#if __cplusplus >= 201103L
+#define REGISTER_UNORDERED_MAP(Bytes) \
+    typedef std::unordered_map<uint32_t, Payload<Bytes> > StdUnorderedMap_##Bytes##B; \
+    REGISTER_MAP_BENCHMARKS(StdUnorderedMap_##Bytes##B, ElementCounts<Bytes>)
+#else
+#define REGISTER_UNORDERED_MAP(Bytes) \
+    typedef void StdUnorderedMap_##Bytes##B
+#endif
+
+#define REGISTER_MAPS(Bytes) \
+    typedef std::map<uint32_t, Payload<Bytes> > StdMap_##Bytes##B; \
+    typedef ccc::FixedFlatMap<uint32_t, Payload<Bytes>, uint32_t> FixedFlatMap_##Bytes##B; \
+    typedef ccc::FixedHashMap<uint32_t, Payload<Bytes>, uint32_t> FixedHashMap_##Bytes##B; \
+    REGISTER_MAP_BENCHMARKS(StdMap_##Bytes##B, ElementCounts<Bytes>); \
+    REGISTER_UNORDERED_MAP(Bytes); \
+    REGISTER_MAP_BENCHMARKS(FixedFlatMap_##Bytes##B, ElementCounts<Bytes>); \
+    REGISTER_MAP_BENCHMARKS(FixedHashMap_##Bytes##B, ElementCounts<Bytes>)
+
+REGISTER_MAPS(4);
+REGISTER_MAPS(16);
+REGISTER_MAPS(64);
+REGISTER_MAPS(256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,93 @@
+/*
+ * gbenchmark_ObjectPool.cpp
+ *
+ *  Allocating and freeing batches of 64 order objects on 1 to all cores: new/delete versus a shared
+ *  ccc::PodObjectPool, used directly and through a per-thread ccc::ObjectPoolCache.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <ccc/pod_object_pool.h>
+
+struct Order
+{
+    uint64_t m_Id;
+    uint32_t m_Quantity;
+    uint32_t m_Side;
+    double m_Price;
+    char m_Symbol[8];
+};
+
+static const unsigned int BatchSize = 64;
+
+typedef ccc::PodObjectPool<Order, uint32_t, 65536> OrderPool;
+
+// zero-initialized, thus empty and usable by all threads from the start
+static OrderPool Pool;
+
+static void BM_NewDelete(benchmark::State& state)
+{
+    Order* Orders[BatchSize];
+    while (state.KeepRunning())
+    {
+        for (unsigned int i = 0; i < BatchSize; ++i)
+        {
+            Orders[i] = new Order();
+            benchmark::DoNotOptimize(Orders[i]->m_Id = i);
+        }
+        for (unsigned int i = 0; i < BatchSize; ++i)
+        {
+            delete Orders[i];
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+
+static void BM_PodObjectPool(benchmark::State& state)
+{
+    Order* Orders[BatchSize];
+    while (state.KeepRunning())
+    {
+        for (unsigned int i = 0; i < BatchSize; ++i)
+        {
+            Orders[i] = Pool.allocate();
+            benchmark::DoNotOptimize(Orders[i]->m_Id = i);
+        }
+        for (unsigned int i = 0; i < BatchSize; ++i)
+        {
+            Pool.deallocate(Orders[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+
+static void BM_ObjectPoolCache(benchmark::State& state)
+{
+    ccc::ObjectPoolCache<OrderPool, 2 * BatchSize> Cache(Pool);
+    Order* Orders[BatchSize];
+    while (state.KeepRunning())
+    {
+        for (unsigned int i = 0; i < BatchSize; ++i)
+        {
+            Orders[i] = Cache.allocate();
+            benchmark::DoNotOptimize(Orders[i]->m_Id = i);
+        }
+        for (unsigned int i = 0; i < BatchSize; ++i)
+        {
+            Cache.deallocate(Orders[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+
+static void AllCores(benchmark::internal::Benchmark* Benchmark)
+{
+    const int Cores = benchmark::CPUInfo::Get().num_cpus;
+    Benchmark->DenseThreadRange(1, (Cores > 1) ? Cores : 1)->UseRealTime();
+}
+
+BENCHMARK(BM_NewDelete)->Apply(AllCores);
+BENCHMARK(BM_PodObjectPool)->Apply(AllCores);
+BENCHMARK(BM_ObjectPoolCache)->Apply(AllCores);
+
+BENCHMARK_MAIN();
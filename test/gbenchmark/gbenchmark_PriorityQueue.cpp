@@ -0,0 +1,44 @@
+/*
+ * gbenchmark_PriorityQueue.cpp
+ *
+ *  Hold model of a timer queue: each iteration pops the earliest deadline and pushes a later one.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include <ccc/pod_priority_queue.h>
+
+static const unsigned int MaxTimers = 1 << 16;
+
+template <typename TQueue>
+static void BM_PopPush(benchmark::State& state)
+{
+    const int Count = state.range(0);
+    // too large for the stack
+    std::vector<TQueue> Storage(1);
+    TQueue& q = Storage.front();
+    std::srand(42);
+    for (int i = 0; i < Count; ++i)
+    {
+        q.push(std::rand() % Count);
+    }
+    while (state.KeepRunning())
+    {
+        unsigned int Deadline = q.top();
+        q.pop();
+        q.push(Deadline + std::rand() % Count);
+    }
+}
+
+typedef std::priority_queue<unsigned int, std::vector<unsigned int>, std::greater<unsigned int> > StdQueue;
+BENCHMARK_TEMPLATE(BM_PopPush, StdQueue)->Range(64, MaxTimers);
+BENCHMARK_TEMPLATE(BM_PopPush, ccc::PodPriorityQueue<unsigned int, unsigned int, MaxTimers, std::greater<unsigned int>, 2>)->Range(64, MaxTimers);
+BENCHMARK_TEMPLATE(BM_PopPush, ccc::PodPriorityQueue<unsigned int, unsigned int, MaxTimers, std::greater<unsigned int>, 4>)->Range(64, MaxTimers);
+BENCHMARK_TEMPLATE(BM_PopPush, ccc::PodPriorityQueue<unsigned int, unsigned int, MaxTimers, std::greater<unsigned int>, 8>)->Range(64, MaxTimers);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+/*
+ * gbenchmark_ShardedMap.cpp
+ *
+ *  Lookup throughput of a hash map shared by 1 to all cores, each thread looking up batches of 64
+ *  random keys and replacing a value after every 16th batch: 64 shards (ccc::ShardedMap) versus the
+ *  same capacity behind a single lock, and batched lookups (find_many) versus one lock per key.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <ccc/sharded_map.h>
+
+static const uint32_t KeyCount = 131072;
+static const uint32_t BatchSize = 64;
+
+typedef ccc::ShardedMap<ccc::PodHashMap<uint32_t, uint32_t, uint32_t, 4096>, 64> ShardedTable;
+typedef ccc::ShardedMap<ccc::PodHashMap<uint32_t, uint32_t, uint32_t, 64 * 4096>, 1> LockedTable;
+
+// static, so that the shards are 64 byte aligned (operator new before C++17 aligns to 16 bytes only)
+template <class Table>
+struct Shared
+{
+    static Table m_Table;
+};
+
+template <class Table>
+Table Shared<Table>::m_Table;
+
+static uint32_t NextKey(uint32_t& State)
+{
+    State = State * 1664525u + 1013904223u;
+    return (State >> 8) % KeyCount;
+}
+
+template <class Table, bool Batched>
+static void BM_Lookup(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        Shared<Table>::m_Table.clear();
+        for (uint32_t Key = 0; Key < KeyCount; ++Key)
+        {
+            typename Table::value_type Value = { Key, Key };
+            Shared<Table>::m_Table.insert(Value);
+        }
+    }
+    uint32_t State = static_cast<uint32_t>(state.thread_index()) + 1;
+    uint32_t Keys[BatchSize];
+    uint32_t Values[BatchSize];
+    bool Found[BatchSize];
+    uint32_t Batches = 0;
+    while (state.KeepRunning())
+    {
+        Table& T = Shared<Table>::m_Table;
+        for (uint32_t i = 0; i < BatchSize; ++i)
+        {
+            Keys[i] = NextKey(State);
+        }
+        if (Batched)
+        {
+            benchmark::DoNotOptimize(T.find_many(Keys, BatchSize, Values, Found));
+        }
+        else
+        {
+            for (uint32_t i = 0; i < BatchSize; ++i)
+            {
+                benchmark::DoNotOptimize(Found[i] = T.find(Keys[i], Values[i]));
+            }
+        }
+        if (0 == (++Batches % 16))
+        {
+            typename Table::value_type Value = { Keys[0], Batches };
+            T.insert_or_assign(Value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+
+static void AllCores(benchmark::internal::Benchmark* Benchmark)
+{
+    const int Cores = benchmark::CPUInfo::Get().num_cpus;
+    Benchmark->DenseThreadRange(1, (Cores > 1) ? Cores : 1)->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_Lookup, ShardedTable, true)->Apply(AllCores);
+BENCHMARK_TEMPLATE(BM_Lookup, ShardedTable, false)->Apply(AllCores);
+BENCHMARK_TEMPLATE(BM_Lookup, LockedTable, true)->Apply(AllCores);
+BENCHMARK_TEMPLATE(BM_Lookup, LockedTable, false)->Apply(AllCores);
+
+BENCHMARK_MAIN();
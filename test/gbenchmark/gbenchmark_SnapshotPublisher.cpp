@@ -0,0 +1,113 @@
+/*
+ * gbenchmark_SnapshotPublisher.cpp
+ *
+ *  Reader throughput on a lookup table while thread 0 keeps rewriting it: left-right publication
+ *  (ccc::SnapshotPublisher) versus a table guarded by a mutex. Each read sums a few entries of a
+ *  consistent state, each write rewrites a block of entries.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+
+#include <ccc/snapshot_publisher.h>
+#include <ccc/static_vector.h>
+
+typedef ccc::StaticVector<unsigned int, unsigned int, 4096> Table;
+
+struct RewriteBlock
+{
+    unsigned int m_Generation;
+
+    void operator()(Table& Values) const
+    {
+        if (Values.empty())
+        {
+            Values.resize(Values.max_size());
+        }
+        const unsigned int First = (m_Generation * 64) % Values.size();
+        for (unsigned int i = First; i < First + 64; ++i)
+        {
+            Values[i] = m_Generation;
+        }
+    }
+};
+
+static unsigned int SumEntries(const Table& Values, unsigned int Seed)
+{
+    unsigned int Sum = 0;
+    for (unsigned int i = 0; i < 16; ++i)
+    {
+        Sum += Values[(Seed + i * 257) % Values.size()];
+    }
+    return Sum;
+}
+
+static ccc::SnapshotPublisher<Table>* Publisher = 0;
+
+static void BM_SnapshotPublisher(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        Publisher = new ccc::SnapshotPublisher<Table>();
+        RewriteBlock Write = { 0 };
+        Publisher->write(Write);
+    }
+    unsigned int Seed = static_cast<unsigned int>(state.thread_index());
+    unsigned int Generation = 1;
+    while (state.KeepRunning())
+    {
+        if (state.thread_index() == 0)
+        {
+            RewriteBlock Write = { Generation++ };
+            Publisher->write(Write);
+        }
+        else
+        {
+            ccc::SnapshotPublisher<Table>::ReadView View(*Publisher);
+            benchmark::DoNotOptimize(SumEntries(*View, Seed++));
+        }
+    }
+    if (state.thread_index() == 0)
+    {
+        delete Publisher;
+    }
+}
+
+static Table* LockedTable = 0;
+static std::mutex TableMutex;
+
+static void BM_Mutex(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        LockedTable = new Table();
+        RewriteBlock Write = { 0 };
+        Write(*LockedTable);
+    }
+    unsigned int Seed = static_cast<unsigned int>(state.thread_index());
+    unsigned int Generation = 1;
+    while (state.KeepRunning())
+    {
+        if (state.thread_index() == 0)
+        {
+            RewriteBlock Write = { Generation++ };
+            std::lock_guard<std::mutex> Lock(TableMutex);
+            Write(*LockedTable);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> Lock(TableMutex);
+            benchmark::DoNotOptimize(SumEntries(*LockedTable, Seed++));
+        }
+    }
+    if (state.thread_index() == 0)
+    {
+        delete LockedTable;
+    }
+}
+
+BENCHMARK(BM_SnapshotPublisher)->ThreadRange(2, 8)->UseRealTime();
+BENCHMARK(BM_Mutex)->ThreadRange(2, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
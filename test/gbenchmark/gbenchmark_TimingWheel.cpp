@@ -0,0 +1,98 @@
+/*
+ * gbenchmark_TimingWheel.cpp
+ *
+ *  Timer service with 10^6 outstanding timers: each tick expires the due timers and reschedules
+ *  them with a random delay.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include <ccc/fixed_timing_wheel.h>
+#include <ccc/pod_priority_queue.h>
+
+static const unsigned int Timers = 1000000;
+static const unsigned long Horizon = 1 << 20; // about one timer expires per tick
+
+typedef ccc::FixedTimingWheel<unsigned int, unsigned int> Wheel;
+typedef ccc::FixedTimingWheel<unsigned int, unsigned int, unsigned long, 10, 3> Wheel10;
+
+template <typename TWheel>
+static void BM_TimingWheelTick(benchmark::State& state)
+{
+    TWheel w(Timers);
+    std::srand(42);
+    for (unsigned int i = 0; i < Timers; ++i)
+    {
+        w.schedule(1 + std::rand() % Horizon, i);
+    }
+    unsigned int Expired[64];
+    unsigned long Now = 0;
+    std::size_t Items = 0;
+    while (state.KeepRunning())
+    {
+        ++Now;
+        unsigned int Count;
+        while ((Count = w.advance(Now, Expired, 64)) > 0)
+        {
+            for (unsigned int i = 0; i < Count; ++i)
+            {
+                w.schedule(Now + 1 + std::rand() % Horizon, Expired[i]);
+            }
+            Items += Count;
+        }
+    }
+    state.SetItemsProcessed(Items);
+}
+BENCHMARK_TEMPLATE(BM_TimingWheelTick, Wheel);
+BENCHMARK_TEMPLATE(BM_TimingWheelTick, Wheel10);
+
+template <typename TQueue>
+static void BM_HeapTick(benchmark::State& state)
+{
+    std::vector<TQueue> Storage(1);
+    TQueue& q = Storage.front();
+    std::srand(42);
+    for (unsigned int i = 0; i < Timers; ++i)
+    {
+        q.push(1 + std::rand() % Horizon);
+    }
+    unsigned long Now = 0;
+    std::size_t Items = 0;
+    while (state.KeepRunning())
+    {
+        ++Now;
+        while (q.top() <= Now)
+        {
+            q.pop();
+            q.push(Now + 1 + std::rand() % Horizon);
+            ++Items;
+        }
+    }
+    state.SetItemsProcessed(Items);
+}
+typedef std::priority_queue<unsigned long, std::vector<unsigned long>, std::greater<unsigned long> > StdQueue;
+typedef ccc::PodPriorityQueue<unsigned long, unsigned int, Timers, std::greater<unsigned long>, 4> PodQueue;
+BENCHMARK_TEMPLATE(BM_HeapTick, StdQueue);
+BENCHMARK_TEMPLATE(BM_HeapTick, PodQueue);
+
+static void BM_TimingWheelScheduleCancel(benchmark::State& state)
+{
+    Wheel w(Timers + 1);
+    std::srand(42);
+    for (unsigned int i = 0; i < Timers; ++i)
+    {
+        w.schedule(1 + std::rand() % Horizon, i);
+    }
+    while (state.KeepRunning())
+    {
+        w.cancel(w.schedule(1 + std::rand() % Horizon, 0));
+    }
+}
+BENCHMARK(BM_TimingWheelScheduleCancel);
+
+BENCHMARK_MAIN();
@@ -11,6 +11,8 @@
 #include <ccc/static_vector.h>
 #include <ccc/fixed_vector.h>
 
+#include <ccc/test/container_benchmarks.h>
+
 template<typename T, typename TSize, TSize Capacity, typename TVector>
 struct VectorFactory
 {
@@ -62,12 +64,14 @@ struct VectorFactory<T, TSize, Capacity, ccc::FixedVector<T, TSize> >
 template <typename TVector>
 static void BM_InitializeVector(benchmark::State& state)
 {
+    ccc_test::LoopCounters Counters;
     while (state.KeepRunning())
     {
         TVector v = VectorFactory<int, unsigned int, 10, TVector>::Construct();
         v.push_back(42);
         v.push_back(43);
     }
+    Counters.report(state, state.iterations());
 }
 
 typedef ccc::StaticVector<int, unsigned int, 10> StaticVector;
@@ -77,6 +81,7 @@ BENCHMARK_TEMPLATE(BM_InitializeVector, ccc::FixedVector<int, unsigned int>);
 
 static void BM_StaticVector(benchmark::State& state)
 {
+    ccc_test::LoopCounters Counters;
     while (state.KeepRunning())
     {
         ccc::StaticVector<int, unsigned int, 10> v;
@@ -84,12 +89,14 @@ static void BM_StaticVector(benchmark::State& state)
         v.push_back(43);
         benchmark::DoNotOptimize(v);
     }
+    Counters.report(state, state.iterations());
 }
 
 BENCHMARK(BM_StaticVector);
 
 static void BM_FixedVector(benchmark::State& state)
 {
+    ccc_test::LoopCounters Counters;
     while (state.KeepRunning())
     {
         ccc::FixedVector<int, unsigned int> v(10);
@@ -97,12 +104,14 @@ static void BM_FixedVector(benchmark::State& state)
         v.push_back(43);
         benchmark::DoNotOptimize(v);
     }
+    Counters.report(state, state.iterations());
 }
 
 BENCHMARK(BM_FixedVector);
 
 static void BM_Array(benchmark::State& state)
 {
+    ccc_test::LoopCounters Counters;
     while (state.KeepRunning())
     {
         int a[10];
@@ -116,12 +125,14 @@ static void BM_Array(benchmark::State& state)
         benchmark::DoNotOptimize(a[e]);
         benchmark::DoNotOptimize(e);
     }
+    Counters.report(state, state.iterations());
 }
 
 BENCHMARK(BM_Array);
 
 static void BM_StdVector(benchmark::State& state)
 {
+    ccc_test::LoopCounters Counters;
     while (state.KeepRunning())
     {
         std::vector<int> v;
@@ -130,8 +141,63 @@ static void BM_StdVector(benchmark::State& state)
         v.push_back(43);
         benchmark::DoNotOptimize(v);
     }
+    Counters.report(state, state.iterations());
 }
 
 BENCHMARK(BM_StdVector);
 
-BENCHMARK_MAIN()
+// Operations across element sizes and counts, see ccc/test/container_benchmarks.h. The capacity of a
+// StaticVector is a template argument, so there is one type per element count; the other vectors
+// reserve exactly the element count.
+
+using namespace ccc_test;
+
+#define REGISTER_VECTOR_BENCHMARKS(Container, Counts) \
+    BENCHMARK_TEMPLATE(BM_PushBackPopBack, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_InsertEraseFront, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_InsertEraseMiddle, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_InsertEraseBack, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_Iterate, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_RandomAccess, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_Copy, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_Swap, Container)->Apply(Counts); \
+    BENCHMARK_TEMPLATE(BM_Clear, Container)->Apply(Counts)
+
+#define REGISTER_VECTORS(Bytes) \
+    typedef std::vector<Payload<Bytes> > StdVector_##Bytes##B; \
+    typedef ccc::FixedVector<Payload<Bytes>, uint32_t> FixedVector_##Bytes##B; \
+    REGISTER_VECTOR_BENCHMARKS(StdVector_##Bytes##B, ElementCounts<Bytes>); \
+    REGISTER_VECTOR_BENCHMARKS(FixedVector_##Bytes##B, ElementCounts<Bytes>)
+
+#define REGISTER_STATIC_VECTOR(Bytes, Count) \
+    typedef ccc::StaticVector<Payload<Bytes>, uint32_t, Count> StaticVector_##Bytes##B_##Count; \
+    REGISTER_VECTOR_BENCHMARKS(StaticVector_##Bytes##B_##Count, ElementCount<Count>)
+
+REGISTER_VECTORS(4);
+REGISTER_STATIC_VECTOR(4, 16);
+REGISTER_STATIC_VECTOR(4, 256);
+REGISTER_STATIC_VECTOR(4, 4096);
+REGISTER_STATIC_VECTOR(4, 65536);
+REGISTER_STATIC_VECTOR(4, 1048576);
+
+REGISTER_VECTORS(16);
+REGISTER_STATIC_VECTOR(16, 16);
+REGISTER_STATIC_VECTOR(16, 256);
+REGISTER_STATIC_VECTOR(16, 4096);
+REGISTER_STATIC_VECTOR(16, 65536);
+REGISTER_STATIC_VECTOR(16, 1048576);
+
+REGISTER_VECTORS(64);
+REGISTER_STATIC_VECTOR(64, 16);
+REGISTER_STATIC_VECTOR(64, 256);
+REGISTER_STATIC_VECTOR(64, 4096);
+REGISTER_STATIC_VECTOR(64, 65536);
+REGISTER_STATIC_VECTOR(64, 1048576);
+
+REGISTER_VECTORS(256);
+REGISTER_STATIC_VECTOR(256, 16);
+REGISTER_STATIC_VECTOR(256, 256);
+REGISTER_STATIC_VECTOR(256, 4096);
+REGISTER_STATIC_VECTOR(256, 65536);
+
+BENCHMARK_MAIN();
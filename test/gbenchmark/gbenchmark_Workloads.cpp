@@ -0,0 +1,509 @@
+/*
+ * gbenchmark_Workloads.cpp
+ *
+ *  Replays the synthetic traces of ccc/test/workload_traces.h: a limit order book on lists of
+ *  orders with a map of price levels and an index of order ids, a timer service, and a packet queue
+ *  between a bursty producer and a consumer. The same algorithm runs on the ccc containers and on
+ *  their std:: counterparts. Each iteration replays the whole trace on new containers, whose
+ *  construction and destruction are not timed.
+ *
+ *  Items are trace operations, so items_per_second is the throughput. Every operation is also timed
+ *  on its own, and the percentiles of these latencies are reported as in gbenchmark_Latency.cpp.
+ *  The argument selects the preset of the trace (see the label); CCC_WORKLOAD_SEED changes the
+ *  seed of all traces.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <vector>
+#if __cplusplus >= 201103L
+#include <unordered_map>
+#endif
+
+#include <ccc/fixed_deque.h>
+#include <ccc/fixed_flat_map.h>
+#include <ccc/fixed_hash_map.h>
+#include <ccc/fixed_list.h>
+#include <ccc/fixed_timing_wheel.h>
+#include <ccc/test/container_benchmarks.h>
+#include <ccc/test/workload_traces.h>
+
+using namespace ccc_test;
+
+/**
+ * Creates map entries: aggregates for the ccc maps, pairs for the std:: maps.
+ */
+template <class Map>
+struct Entry
+{
+    static typename Map::value_type Make(const typename Map::key_type& Key, const typename Map::mapped_type& Value)
+    {
+        typename Map::value_type Result;
+        Result.first = Key;
+        Result.second = Value;
+        return Result;
+    }
+};
+
+template <class K, class T, class Compare>
+struct Entry<std::map<K, T, Compare> >
+{
+    static std::pair<const K, T> Make(const K& Key, const T& Value)
+    {
+        return std::pair<const K, T>(Key, Value);
+    }
+};
+
+#if __cplusplus >= 201103L
+template <class K, class T>
+struct Entry<std::unordered_map<K, T> >
+{
+    static std::pair<const K, T> Make(const K& Key, const T& Value)
+    {
+        return std::pair<const K, T>(Key, Value);
+    }
+};
+#endif
+
+// Limit order book:
+
+struct Order
+{
+    uint32_t m_Id;
+    int32_t m_Price;
+    uint32_t m_Quantity;
+    uint32_t m_Side;
+};
+
+/**
+ * First and last order of a price level.
+ */
+template <class Iterator>
+struct PriceLevel
+{
+    Iterator m_First;
+    Iterator m_Last;
+};
+
+/**
+ * The orders of one side in price-time priority, best price first, and their price levels, keyed by
+ * price in the same order.
+ */
+template <class Orders, class Levels>
+struct BookSide
+{
+    typedef typename Orders::iterator iterator;
+    typedef PriceLevel<iterator> Level;
+
+    Orders* m_Orders;
+    Levels* m_Levels;
+
+    iterator add(const Order& Value)
+    {
+        typename Levels::iterator Found = m_Levels->find(Value.m_Price);
+        if (Found != m_Levels->end())
+        {
+            iterator Position = Found->second.m_Last;
+            Found->second.m_Last = m_Orders->insert(++Position, Value);
+            return Found->second.m_Last;
+        }
+        typename Levels::iterator Worse = m_Levels->upper_bound(Value.m_Price);
+        Level New;
+        New.m_First = m_Orders->insert((Worse == m_Levels->end()) ? m_Orders->end() : Worse->second.m_First, Value);
+        New.m_Last = New.m_First;
+        m_Levels->insert(Entry<Levels>::Make(Value.m_Price, New));
+        return New.m_First;
+    }
+
+    void remove(iterator Position)
+    {
+        typename Levels::iterator Found = m_Levels->find(Position->m_Price);
+        Level& Bounds = Found->second;
+        if (Bounds.m_First == Bounds.m_Last)
+        {
+            m_Levels->erase(Found);
+        }
+        else if (Bounds.m_First == Position)
+        {
+            ++Bounds.m_First;
+        }
+        else if (Bounds.m_Last == Position)
+        {
+            --Bounds.m_Last;
+        }
+        m_Orders->erase(Position);
+    }
+};
+
+/**
+ * Orders (a list per side), price levels (an ordered map per side) and the index from order id to
+ * order (a hash map). Executions are market orders, which fill the best orders of a side until
+ * their quantity is exhausted.
+ */
+template <class Orders, class BidLevels, class AskLevels, class Index>
+struct OrderBook
+{
+    typedef BookSide<Orders, BidLevels> bid_side_type;
+    typedef BookSide<Orders, AskLevels> ask_side_type;
+    typedef typename Orders::iterator iterator;
+
+    bid_side_type m_Bids;
+    ask_side_type m_Asks;
+    Index* m_Index;
+    uint64_t m_Filled;
+
+    void add(const OrderBookOperation& Operation)
+    {
+        Order Value;
+        Value.m_Id = Operation.m_Id;
+        Value.m_Price = Operation.m_Price;
+        Value.m_Quantity = Operation.m_Quantity;
+        Value.m_Side = Operation.m_Side;
+        const iterator Position = (OrderBid == Value.m_Side) ? m_Bids.add(Value) : m_Asks.add(Value);
+        m_Index->insert(Entry<Index>::Make(Value.m_Id, Position));
+    }
+
+    void cancel(uint32_t Id)
+    {
+        typename Index::iterator Found = m_Index->find(Id);
+        if (Found != m_Index->end())
+        {
+            remove(Found->second);
+            m_Index->erase(Found);
+        }
+    }
+
+    void execute(OrderSide Side, uint32_t Quantity)
+    {
+        Orders& Resting = *((OrderBid == Side) ? m_Bids.m_Orders : m_Asks.m_Orders);
+        while ((0 != Quantity) and not Resting.empty())
+        {
+            const iterator Best = Resting.begin();
+            const uint32_t Fill = std::min(Quantity, Best->m_Quantity);
+            Quantity -= Fill;
+            Best->m_Quantity -= Fill;
+            m_Filled += Fill;
+            if (0 == Best->m_Quantity)
+            {
+                m_Index->erase(Best->m_Id);
+                remove(Best);
+            }
+        }
+    }
+
+    void remove(iterator Position)
+    {
+        if (OrderBid == Position->m_Side)
+        {
+            m_Bids.remove(Position);
+        }
+        else
+        {
+            m_Asks.remove(Position);
+        }
+    }
+};
+
+template <class Orders, class BidLevels, class AskLevels, class Index>
+struct OrderBookContainers
+{
+    typedef OrderBook<Orders, BidLevels, AskLevels, Index> book_type;
+
+    OrderBookContainers(std::size_t MaxOrders)
+            : m_BidOrders(Factory<Orders>::Create(MaxOrders)),
+              m_AskOrders(Factory<Orders>::Create(MaxOrders)),
+              m_BidLevels(MapTraits<BidLevels>::Create(MaxOrders)),
+              m_AskLevels(MapTraits<AskLevels>::Create(MaxOrders)),
+              m_Index(MapTraits<Index>::Create(MaxOrders))
+    {
+        m_Book.m_Bids.m_Orders = m_BidOrders;
+        m_Book.m_Bids.m_Levels = m_BidLevels;
+        m_Book.m_Asks.m_Orders = m_AskOrders;
+        m_Book.m_Asks.m_Levels = m_AskLevels;
+        m_Book.m_Index = m_Index;
+        m_Book.m_Filled = 0;
+    }
+
+    ~OrderBookContainers()
+    {
+        delete m_Index;
+        delete m_AskLevels;
+        delete m_BidLevels;
+        delete m_AskOrders;
+        delete m_BidOrders;
+    }
+
+    Orders* m_BidOrders;
+    Orders* m_AskOrders;
+    BidLevels* m_BidLevels;
+    AskLevels* m_AskLevels;
+    Index* m_Index;
+    book_type m_Book;
+};
+
+template <class Containers>
+static void BM_OrderBook(benchmark::State& state)
+{
+    const OrderBookConfig Config = order_book_preset(state.range(0));
+    const std::vector<OrderBookOperation> Trace = generate_order_book_trace(Config);
+    LatencyHistogram Histogram;
+    uint64_t Filled = 0;
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        Containers* c = new Containers(Config.m_MaxOrders);
+        state.ResumeTiming();
+        for (std::size_t i = 0; i < Trace.size(); ++i)
+        {
+            const OrderBookOperation& Operation = Trace[i];
+            const uint64_t Start = CycleClock::now();
+            switch (Operation.m_Type)
+            {
+            case OrderAdd:
+                c->m_Book.add(Operation);
+                break;
+            case OrderCancel:
+                c->m_Book.cancel(Operation.m_Id);
+                break;
+            default:
+                c->m_Book.execute(static_cast<OrderSide>(Operation.m_Side), Operation.m_Quantity);
+                break;
+            }
+            Histogram.record(CycleClock::now() - Start);
+        }
+        state.PauseTiming();
+        Filled = c->m_Book.m_Filled;
+        delete c;
+        state.ResumeTiming();
+    }
+    Counters.report(state, state.iterations() * Trace.size());
+    ReportLatencies(state, Histogram);
+    state.counters["filled"] = Filled; // equal for all implementations of the same trace
+    state.SetItemsProcessed(state.iterations() * Trace.size());
+    state.SetLabel(Config.m_Name);
+}
+
+// Timers:
+
+template <class Wheel>
+struct WheelTimers
+{
+    WheelTimers(const TimerConfig& Config)
+            : m_Wheel(Config.m_MaxTimers), m_Handles(Config.m_Operations), m_Expired(0)
+    {
+    }
+
+    void schedule(uint32_t Id, uint64_t Deadline)
+    {
+        m_Handles[Id] = m_Wheel.schedule(Deadline, Id);
+    }
+
+    void cancel(uint32_t Id)
+    {
+        m_Wheel.cancel(m_Handles[Id]);
+    }
+
+    void advance(uint64_t Now)
+    {
+        uint32_t Buffer[64];
+        uint32_t Count;
+        while ((Count = m_Wheel.advance(Now, Buffer, 64)) > 0)
+        {
+            m_Expired += Count;
+        }
+    }
+
+    Wheel m_Wheel;
+    std::vector<typename Wheel::handle_type> m_Handles;
+    uint64_t m_Expired;
+};
+
+/**
+ * Timers in an ordered multimap by deadline, which is how timer services are commonly written with
+ * the standard library.
+ */
+struct MultimapTimers
+{
+    typedef std::multimap<uint64_t, uint32_t> map_type;
+
+    MultimapTimers(const TimerConfig& Config)
+            : m_Handles(Config.m_Operations), m_Pending(Config.m_Operations, false), m_Expired(0)
+    {
+    }
+
+    void schedule(uint32_t Id, uint64_t Deadline)
+    {
+        m_Handles[Id] = m_Timers.insert(std::make_pair(Deadline, Id));
+        m_Pending[Id] = true;
+    }
+
+    void cancel(uint32_t Id)
+    {
+        if (m_Pending[Id])
+        {
+            m_Timers.erase(m_Handles[Id]);
+            m_Pending[Id] = false;
+        }
+    }
+
+    void advance(uint64_t Now)
+    {
+        while ((not m_Timers.empty()) and (m_Timers.begin()->first <= Now))
+        {
+            m_Pending[m_Timers.begin()->second] = false;
+            m_Timers.erase(m_Timers.begin());
+            ++m_Expired;
+        }
+    }
+
+    map_type m_Timers;
+    std::vector<map_type::iterator> m_Handles;
+    std::vector<bool> m_Pending;
+    uint64_t m_Expired;
+};
+
+template <class Timers>
+static void BM_Timers(benchmark::State& state)
+{
+    const TimerConfig Config = timer_preset(state.range(0));
+    const std::vector<TimerOperation> Trace = generate_timer_trace(Config);
+    LatencyHistogram Histogram;
+    uint64_t Expired = 0;
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        Timers* t = new Timers(Config);
+        state.ResumeTiming();
+        for (std::size_t i = 0; i < Trace.size(); ++i)
+        {
+            const TimerOperation& Operation = Trace[i];
+            const uint64_t Start = CycleClock::now();
+            switch (Operation.m_Type)
+            {
+            case TimerSchedule:
+                t->schedule(Operation.m_Id, Operation.m_Ticks);
+                break;
+            case TimerCancel:
+                t->cancel(Operation.m_Id);
+                break;
+            default:
+                t->advance(Operation.m_Ticks);
+                break;
+            }
+            Histogram.record(CycleClock::now() - Start);
+        }
+        state.PauseTiming();
+        Expired = t->m_Expired;
+        delete t;
+        state.ResumeTiming();
+    }
+    Counters.report(state, state.iterations() * Trace.size());
+    ReportLatencies(state, Histogram);
+    state.counters["expired"] = Expired;
+    state.SetItemsProcessed(state.iterations() * Trace.size());
+    state.SetLabel(Config.m_Name);
+}
+
+// Packet queue:
+
+typedef Payload<64> Packet;
+
+template <class Queue>
+static void BM_PacketQueue(benchmark::State& state)
+{
+    const PacketQueueConfig Config = packet_queue_preset(state.range(0));
+    const std::vector<PacketOperation> Trace = generate_packet_queue_trace(Config);
+    const std::size_t Capacity = Config.m_Capacity;
+    LatencyHistogram Histogram;
+    uint64_t Dropped = 0;
+    uint64_t Checksum = 0;
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        Queue* q = Factory<Queue>::Create(Capacity); // std::deque grows block by block
+        state.ResumeTiming();
+        uint32_t Sequence = 0;
+        Dropped = 0;
+        for (std::size_t i = 0; i < Trace.size(); ++i)
+        {
+            const PacketOperation& Operation = Trace[i];
+            const uint64_t Start = CycleClock::now();
+            if (PacketProduce == Operation.m_Type)
+            {
+                for (uint32_t Count = 0; Count < Operation.m_Count; ++Count)
+                {
+                    if (q->size() < Capacity)
+                    {
+                        q->push_back(MakeValue<Packet>(Sequence++));
+                    }
+                    else
+                    {
+                        ++Dropped;
+                    }
+                }
+            }
+            else
+            {
+                for (uint32_t Count = 0; (Count < Operation.m_Count) and not q->empty(); ++Count)
+                {
+                    Checksum += q->front().m_Key;
+                    q->pop_front();
+                }
+            }
+            Histogram.record(CycleClock::now() - Start);
+        }
+        state.PauseTiming();
+        delete q;
+        state.ResumeTiming();
+    }
+    benchmark::DoNotOptimize(Checksum);
+    Counters.report(state, state.iterations() * Trace.size());
+    ReportLatencies(state, Histogram);
+    state.counters["dropped"] = Dropped;
+    state.SetItemsProcessed(state.iterations() * Trace.size());
+    state.SetLabel(Config.m_Name);
+}
+
+static void Presets(benchmark::internal::Benchmark* Benchmark)
+{
+    Benchmark->Arg(0)->Arg(1);
+}
+
+typedef std::list<Order> StdOrders;
+typedef PriceLevel<StdOrders::iterator> StdLevel;
+#if __cplusplus >= 201103L
+typedef std::unordered_map<uint32_t, StdOrders::iterator> StdIndex;
+#else
+typedef std::map<uint32_t, StdOrders::iterator> StdIndex;
+#endif
+typedef OrderBookContainers<StdOrders, std::map<int32_t, StdLevel, std::greater<int32_t> >, std::map<int32_t, StdLevel>, StdIndex>
+        StdOrderBook;
+
+typedef ccc::FixedList<Order, uint32_t> FixedOrders;
+typedef PriceLevel<FixedOrders::iterator> FixedLevel;
+typedef OrderBookContainers<FixedOrders, ccc::FixedFlatMap<int32_t, FixedLevel, uint32_t, std::greater<int32_t> >,
+        ccc::FixedFlatMap<int32_t, FixedLevel, uint32_t>, ccc::FixedHashMap<uint32_t, FixedOrders::iterator, uint32_t> > FixedOrderBook;
+
+BENCHMARK_TEMPLATE(BM_OrderBook, StdOrderBook)->Apply(Presets);
+BENCHMARK_TEMPLATE(BM_OrderBook, FixedOrderBook)->Apply(Presets);
+
+typedef ccc::FixedTimingWheel<uint32_t, uint32_t, uint64_t> FixedWheel;
+
+BENCHMARK_TEMPLATE(BM_Timers, MultimapTimers)->Apply(Presets);
+BENCHMARK_TEMPLATE(BM_Timers, WheelTimers<FixedWheel>)->Apply(Presets);
+
+typedef std::deque<Packet> StdPacketQueue;
+typedef ccc::FixedDeque<Packet, uint32_t> FixedPacketQueue;
+
+BENCHMARK_TEMPLATE(BM_PacketQueue, StdPacketQueue)->Apply(Presets);
+BENCHMARK_TEMPLATE(BM_PacketQueue, FixedPacketQueue)->Apply(Presets);
+
+BENCHMARK_MAIN();
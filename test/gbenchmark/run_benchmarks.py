@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""
+run_benchmarks.py
+
+Runs gbenchmark executables with a fixed number of repetitions, pinned to a set of CPUs, and stores
+the results of each executable as <output-dir>/<executable name>.json, the format read by
+compare_benchmarks.py.
+
+    run_benchmarks.py --output-dir results [--repetitions 10] [--cpus 0] [--filter REGEX] EXECUTABLE...
+
+Pinning uses taskset (Linux); without it the benchmarks run unpinned and a warning is printed. The
+multithreaded benchmarks need as many CPUs as threads, e.g. --cpus 0-3. --perf-counters sets
+CCC_BENCHMARK_PERF_COUNTERS, so that the container benchmarks also report hardware events per item
+(cycles, instructions, L1D/LLC and branch misses) where perf_event_open is permitted.
+"""
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("executables", nargs="+", help="gbenchmark executables")
+    parser.add_argument("--output-dir", required=True, help="directory of the JSON results")
+    parser.add_argument("--repetitions", type=int, default=10,
+                        help="repetitions of each benchmark, the samples of the statistical test (default: 10)")
+    parser.add_argument("--cpus", default="0",
+                        help="CPU list passed to taskset, empty to disable pinning (default: 0)")
+    parser.add_argument("--filter", default=None, help="regular expression selecting benchmarks")
+    parser.add_argument("--min-time", default=None, help="minimum time per repetition in seconds")
+    parser.add_argument("--perf-counters", action="store_true", help="report hardware performance counters")
+    return parser.parse_args()
+
+
+def benchmark_command(executable, output, arguments):
+    command = [
+        executable,
+        "--benchmark_repetitions=%d" % arguments.repetitions,
+        "--benchmark_out=%s" % output,
+        "--benchmark_out_format=json",
+    ]
+    if arguments.filter:
+        command.append("--benchmark_filter=%s" % arguments.filter)
+    if arguments.min_time:
+        command.append("--benchmark_min_time=%s" % arguments.min_time)
+    if arguments.cpus:
+        taskset = shutil.which("taskset")
+        if taskset:
+            command = [taskset, "-c", arguments.cpus] + command
+        else:
+            print("warning: taskset not found, running %s unpinned" % executable, file=sys.stderr)
+    return command
+
+
+def main():
+    arguments = parse_arguments()
+    if arguments.repetitions < 5:
+        print("warning: fewer than 5 repetitions are too few for the comparison", file=sys.stderr)
+    os.makedirs(arguments.output_dir, exist_ok=True)
+    environment = dict(os.environ)
+    if arguments.perf_counters:
+        environment["CCC_BENCHMARK_PERF_COUNTERS"] = "1"
+    failed = []
+    for executable in arguments.executables:
+        name = os.path.splitext(os.path.basename(executable))[0]
+        output = os.path.join(arguments.output_dir, name + ".json")
+        command = benchmark_command(executable, output, arguments)
+        print(" ".join(command), flush=True)
+        if 0 != subprocess.call(command, env=environment):
+            failed.append(name)
+    if failed:
+        print("failed: %s" % ", ".join(failed), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,422 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks Installs the counting operator new and delete for the whole test executable; the other
+ * tests are not affected apart from being counted.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <ccc/stats.h>
+#include <ccc/test/allocation_hooks.h>
+
+#include <ccc/dirty_tracking.h>
+#include <ccc/consistent_vector.h>
+#include <ccc/consistent_deque.h>
+#include <ccc/consistent_list.h>
+#include <ccc/static_vector.h>
+#include <ccc/static_deque.h>
+#include <ccc/static_list.h>
+#include <ccc/pod_flat_map.h>
+#include <ccc/pod_hash_map.h>
+#include <ccc/pod_slot_map.h>
+#include <ccc/pod_priority_queue.h>
+#include <ccc/pod_timing_wheel.h>
+#include <ccc/pod_object_pool.h>
+#include <ccc/fixed_vector.h>
+#include <ccc/fixed_deque.h>
+#include <ccc/fixed_list.h>
+#include <ccc/fixed_flat_map.h>
+#include <ccc/fixed_hash_map.h>
+#include <ccc/fixed_slot_map.h>
+#include <ccc/fixed_timing_wheel.h>
+#include <ccc/fixed_object_pool.h>
+
+using ccc::stats::AllocationScope;
+
+TEST(Allocations, HooksCountNewAndDelete)
+{
+    ASSERT_TRUE(ccc::stats::hooks_installed());
+    uint64_t Allocations, Deallocations, Bytes, Peak;
+    {
+        AllocationScope Scope;
+        // volatile, otherwise the compiler may elide the pairs of new and delete
+        int* volatile Small = new int(1);
+        char* volatile Large = new char[1000];
+        delete Small;
+        delete[] Large;
+        Allocations = Scope.allocations();
+        Deallocations = Scope.deallocations();
+        Bytes = Scope.allocated_bytes();
+        Peak = Scope.peak_bytes();
+    }
+    EXPECT_EQ(2u, Allocations);
+    EXPECT_EQ(2u, Deallocations);
+    EXPECT_EQ(sizeof(int) + 1000u, Bytes);
+    EXPECT_EQ(sizeof(int) + 1000u, Peak);
+}
+
+TEST(Allocations, NestedScopes)
+{
+    uint64_t InnerPeak, OuterPeak, OuterAllocations;
+    {
+        AllocationScope Outer;
+        char* volatile a = new char[500];
+        delete[] a;
+        {
+            AllocationScope Inner;
+            char* volatile b = new char[100];
+            delete[] b;
+            InnerPeak = Inner.peak_bytes();
+        }
+        OuterPeak = Outer.peak_bytes();
+        OuterAllocations = Outer.allocations();
+    }
+    EXPECT_EQ(100u, InnerPeak);
+    EXPECT_EQ(500u, OuterPeak);
+    EXPECT_EQ(2u, OuterAllocations);
+}
+
+// Containers with static storage never allocate:
+
+struct Value
+{
+    int m_Key;
+    int m_Payload;
+};
+
+bool operator<(const Value& lhs, const Value& rhs)
+{
+    return lhs.m_Key < rhs.m_Key;
+}
+
+template <class Sequence>
+void ModifySequence(Sequence& c)
+{
+    for (int i = 0; i < 50; ++i)
+    {
+        Value v = { i, i };
+        c.push_back(v);
+    }
+    Value v = { -1, -1 };
+    c.insert(c.begin(), v);
+    c.erase(c.begin());
+    Sequence Copy(c);
+    Copy.pop_back();
+    c = Copy;
+    c.swap(Copy);
+    c.clear();
+}
+
+TEST(Allocations, StaticVectorNeverAllocates)
+{
+    typedef ccc::StaticVector<Value, uint32_t, 100> Container;
+    uint64_t Allocations;
+    {
+        AllocationScope Scope;
+        Container c;
+        ModifySequence(c);
+        c.resize(20);
+        Allocations = Scope.allocations();
+    }
+    EXPECT_EQ(0u, Allocations);
+}
+
+TEST(Allocations, StaticDequeNeverAllocates)
+{
+    typedef ccc::StaticDeque<Value, uint32_t, 100> Container;
+    uint64_t Allocations;
+    {
+        AllocationScope Scope;
+        Container c;
+        ModifySequence(c);
+        Value v = { 1, 1 };
+        c.push_front(v);
+        c.pop_front();
+        Allocations = Scope.allocations();
+    }
+    EXPECT_EQ(0u, Allocations);
+}
+
+TEST(Allocations, StaticListNeverAllocates)
+{
+    typedef ccc::StaticList<Value, uint32_t, 100> Container;
+    uint64_t Allocations;
+    {
+        AllocationScope Scope;
+        Container c;
+        ModifySequence(c);
+        Value v = { 1, 1 };
+        c.push_front(v);
+        c.pop_front();
+        Allocations = Scope.allocations();
+    }
+    EXPECT_EQ(0u, Allocations);
+}
+
+TEST(Allocations, ConsistentVectorNeverAllocates)
+{
+    typedef ccc::ConsistentVector<Value, uint32_t, 100> Container;
+    uint64_t Allocations;
+    {
+        AllocationScope Scope;
+        Container c = Container();
+        ModifySequence(c);
+        c.resize(20);
+        Allocations = Scope.allocations();
+    }
+    EXPECT_EQ(0u, Allocations);
+}
+
+TEST(Allocations, ConsistentDequeNeverAllocates)
+{
+    typedef ccc::ConsistentDeque<Value, uint32_t, 100> Container;
+    uint64_t Allocations;
+    {
+        AllocationScope Scope;
+        Container c = Container();
+        ModifySequence(c);
+        Value v = { 1, 1 };
+        c.push_front(v);
+        c.pop_front();
+        Allocations = Scope.allocations();
+    }
+    EXPECT_EQ(0u, Allocations);
+}
+
+TEST(Allocations, ConsistentListNeverAllocates)
+{
+    typedef ccc::ConsistentList<Value, uint32_t, 100> Container;
+    uint64_t Allocations;
+    {
+        AllocationScope Scope;
+        Container c;
+        ModifySequence(c);
+        Value v = { 1, 1 };
+        c.push_front(v);
+        c.pop_front();
+        Allocations = Scope.allocations();
+    }
+    EXPECT_EQ(0u, Allocations);
+}
+
+TEST(Allocations, PodAssociativeContainersNeverAllocate)
+{
+    typedef ccc::PodFlatMap<int, int, uint32_t, 100> FlatMap;
+    typedef ccc::PodHashMap<int, int, uint32_t, 128> HashMap;
+    typedef ccc::PodSlotMap<int, uint32_t, 100> SlotMap;
+    uint64_t Allocations;
+    {
+        AllocationScope Scope;
+        FlatMap f = FlatMap();
+        HashMap h = HashMap();
+        SlotMap s = SlotMap();
+        for (int i = 0; i < 50; ++i)
+        {
+            FlatMap::value_type FlatValue = { 49 - i, i };
+            f.insert(FlatValue);
+            HashMap::value_type HashValue = { i, i };
+            h.insert(HashValue);
+            s.insert(i);
+        }
+        f.erase(7);
+        h.erase(7);
+        s.erase(s.begin());
+        FlatMap FlatCopy(f);
+        HashMap HashCopy(h);
+        f.swap(FlatCopy);
+        h.swap(HashCopy);
+        const bool FlatFound = f.find(8) != f.end();
+        const bool HashFound = h.find(8) != h.end();
+        Allocations = Scope.allocations();
+        EXPECT_TRUE(FlatFound);
+        EXPECT_TRUE(HashFound);
+    }
+    EXPECT_EQ(0u, Allocations);
+}
+
+TEST(Allocations, PodQueuesAndPoolsNeverAllocate)
+{
+    typedef ccc::PodPriorityQueue<int, uint32_t, 100> Queue;
+    typedef ccc::PodTimingWheel<int, uint32_t, 100> Wheel;
+    typedef ccc::PodObjectPool<Value, uint32_t, 100> Pool;
+    // the wheel and the pool are too large for the stack of some platforms
+    Wheel* w = new Wheel();
+    Pool* p = new Pool();
+    uint64_t Allocations;
+    {
+        AllocationScope Scope;
+        Queue q = Queue();
+        for (int i = 0; i < 50; ++i)
+        {
+            q.push((i * 37) % 50);
+            w->schedule(i, i);
+        }
+        q.pop();
+        int Expired[100];
+        w->advance(25, Expired, 100);
+        Value v = { 1, 2 };
+        p->destroy(p->create(v));
+        Allocations = Scope.allocations();
+    }
+    EXPECT_EQ(0u, Allocations);
+    delete p;
+    delete w;
+}
+
+TEST(Allocations, DirtyTrackedStaticContainerNeverAllocates)
+{
+    typedef ccc::StaticVector<int, uint32_t, 1000> Vector;
+    uint64_t Allocations;
+    {
+        AllocationScope Scope;
+        ccc::DirtyTracked<Vector, 16> Tracked;
+        for (int i = 0; i < 100; ++i)
+        {
+            Tracked.push_back(i);
+        }
+        Tracked.set(50, -1);
+        char Patch[1024];
+        ASSERT_GE(sizeof(Patch), Tracked.patch_size());
+        Tracked.make_patch(Patch);
+        Allocations = Scope.allocations();
+    }
+    EXPECT_EQ(0u, Allocations);
+}
+
+// Containers with fixed capacity allocate in the constructor only:
+
+struct FixedAllocations
+{
+    uint64_t m_Construction;
+    uint64_t m_Modification;
+    uint64_t m_Deallocations;
+};
+
+template <class Sequence>
+FixedAllocations CountFixedSequence()
+{
+    FixedAllocations Result;
+    AllocationScope Scope;
+    {
+        Sequence c(100);
+        Result.m_Construction = Scope.allocations();
+        Sequence Copy(c);
+        const uint64_t Copied = Scope.allocations();
+        for (int i = 0; i < 50; ++i)
+        {
+            Value v = { i, i };
+            c.push_back(v);
+        }
+        Value v = { -1, -1 };
+        c.insert(c.begin(), v);
+        c.erase(c.begin());
+        Copy = c; // same capacity
+        c.clear();
+        Result.m_Modification = Scope.allocations() - Copied;
+    }
+    Result.m_Deallocations = Scope.deallocations();
+    return Result;
+}
+
+TEST(Allocations, FixedVectorAllocatesOnceInConstructor)
+{
+    FixedAllocations Counts = CountFixedSequence<ccc::FixedVector<Value, uint32_t> >();
+    EXPECT_EQ(1u, Counts.m_Construction);
+    EXPECT_EQ(0u, Counts.m_Modification);
+    EXPECT_EQ(2u, Counts.m_Deallocations);
+}
+
+TEST(Allocations, FixedDequeAllocatesOnceInConstructor)
+{
+    FixedAllocations Counts = CountFixedSequence<ccc::FixedDeque<Value, uint32_t> >();
+    EXPECT_EQ(1u, Counts.m_Construction);
+    EXPECT_EQ(0u, Counts.m_Modification);
+    EXPECT_EQ(2u, Counts.m_Deallocations);
+}
+
+TEST(Allocations, FixedListAllocatesThriceInConstructor)
+{
+    // nodes, values and the stack of deallocated nodes
+    FixedAllocations Counts = CountFixedSequence<ccc::FixedList<Value, uint32_t> >();
+    EXPECT_EQ(3u, Counts.m_Construction);
+    EXPECT_EQ(0u, Counts.m_Modification);
+    EXPECT_EQ(6u, Counts.m_Deallocations);
+}
+
+TEST(Allocations, FixedAssociativeContainersAllocateInConstructor)
+{
+    typedef ccc::FixedFlatMap<int, int, uint32_t> FlatMap;
+    typedef ccc::FixedFlatMap<int, int, uint32_t, std::less<int>, 8, true> EytzingerFlatMap;
+    typedef ccc::FixedHashMap<int, int, uint32_t> HashMap;
+    typedef ccc::FixedSlotMap<int, uint32_t> SlotMap;
+    uint64_t Flat, Eytzinger, Hash, Slot, Modification;
+    {
+        AllocationScope Scope;
+        FlatMap f(100);
+        Flat = Scope.allocations();
+        EytzingerFlatMap e(100);
+        Eytzinger = Scope.allocations() - Flat;
+        HashMap h(128);
+        Hash = Scope.allocations() - Flat - Eytzinger;
+        SlotMap s(100);
+        Slot = Scope.allocations() - Flat - Eytzinger - Hash;
+        for (int i = 0; i < 50; ++i)
+        {
+            FlatMap::value_type FlatValue = { 49 - i, i };
+            f.insert(FlatValue);
+            EytzingerFlatMap::value_type EytzingerValue = { 49 - i, i };
+            e.insert(EytzingerValue);
+            HashMap::value_type HashValue = { i, i };
+            h.insert(HashValue);
+            s.insert(i);
+        }
+        e.rebuild_layout();
+        f.erase(7);
+        h.erase(7);
+        s.erase(s.begin());
+        Modification = Scope.allocations() - Flat - Eytzinger - Hash - Slot;
+    }
+    EXPECT_EQ(1u, Flat);
+    EXPECT_EQ(3u, Eytzinger); // values, keys and indices of the layout
+    EXPECT_EQ(2u, Hash); // flags and buckets
+    EXPECT_EQ(4u, Slot); // values, owners, slots and deallocated slots
+    EXPECT_EQ(0u, Modification);
+}
+
+TEST(Allocations, FixedQueuesAndPoolsAllocateInConstructor)
+{
+    typedef ccc::FixedTimingWheel<int, uint32_t> Wheel;
+    typedef ccc::FixedObjectPool<Value, uint32_t> Pool;
+    uint64_t WheelAllocations, PoolAllocations, Modification;
+    {
+        AllocationScope Scope;
+        Wheel w(100);
+        WheelAllocations = Scope.allocations();
+        Pool p(100);
+        PoolAllocations = Scope.allocations() - WheelAllocations;
+        for (int i = 0; i < 50; ++i)
+        {
+            w.schedule(i, i);
+        }
+        int Expired[100];
+        w.advance(25, Expired, 100);
+        Value v = { 1, 2 };
+        p.destroy(p.create(v));
+        Modification = Scope.allocations() - WheelAllocations - PoolAllocations;
+    }
+    EXPECT_EQ(4u, WheelAllocations); // nodes, buckets, level sizes and deallocated nodes
+    EXPECT_EQ(2u, PoolAllocations); // links and values
+    EXPECT_EQ(0u, Modification);
+}
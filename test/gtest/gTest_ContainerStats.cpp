@@ -0,0 +1,207 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks Built into its own executable with CCC_CONTAINER_STATS=1, since the setting has to be the
+ * same for all translation units of a program.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <new>
+
+#include <ccc/pod_vector.h>
+#include <ccc/pod_deque.h>
+#include <ccc/pod_list.h>
+#include <ccc/pod_flat_map.h>
+#include <ccc/pod_hash_map.h>
+#include <ccc/fixed_vector.h>
+
+#if !CCC_CONTAINER_STATS
+#error "gTest_ContainerStats.cpp has to be compiled with CCC_CONTAINER_STATS=1"
+#endif
+
+using ccc::stats::ContainerStats;
+using ccc::stats::container_stats;
+
+// distinct element types, so that no other test touches the statistics of these containers
+
+struct VectorElement
+{
+    int m_Value;
+};
+
+struct DequeElement
+{
+    int m_Value;
+};
+
+struct ListElement
+{
+    int m_Value;
+};
+
+typedef ccc::PodVector<VectorElement, uint32_t, 10> StatsVector;
+typedef ccc::PodDeque<DequeElement, uint32_t, 10> StatsDeque;
+typedef ccc::PodList<ListElement, uint32_t, 10> StatsList;
+typedef ccc::PodFlatMap<int, VectorElement, uint32_t, 4> StatsFlatMap;
+typedef ccc::PodHashMap<int, DequeElement, uint32_t, 4> StatsHashMap;
+
+TEST(ContainerStats, CountsOperationsAndHighWaterMark)
+{
+    StatsVector v = StatsVector();
+    VectorElement e = { 1 };
+    for (int i = 0; i < 7; ++i)
+    {
+        v.push_back(e);
+    }
+    v.pop_back();
+    v.erase(v.begin());
+    v.insert(v.begin(), e);
+    v.clear();
+    v.assign(3, e);
+
+    const ContainerStats& Stats = container_stats<StatsVector>();
+    EXPECT_EQ(10u, Stats.m_Capacity);
+    EXPECT_EQ(7u, Stats.m_HighWaterMark);
+    EXPECT_EQ(0u, Stats.m_OverflowAttempts);
+    EXPECT_EQ(8u, Stats.m_Operations[ccc::stats::ContainerInsert]);
+    EXPECT_EQ(2u, Stats.m_Operations[ccc::stats::ContainerErase]);
+    EXPECT_EQ(2u, Stats.m_Operations[ccc::stats::ContainerClear]); // assign clears first
+    EXPECT_EQ(1u, Stats.m_Operations[ccc::stats::ContainerAssign]);
+}
+
+TEST(ContainerStats, OccupancyHistogram)
+{
+    StatsDeque d = StatsDeque();
+    DequeElement e = { 1 };
+    for (int i = 0; i < 10; ++i)
+    {
+        d.push_back(e);
+    }
+
+    // sizes 1 to 10 of capacity 10 fall into the buckets 1 to 10
+    const ContainerStats& Stats = container_stats<StatsDeque>();
+    EXPECT_EQ(0u, Stats.m_Occupancy[0]);
+    for (unsigned int i = 1; i < ccc::stats::OccupancyBucketCount; ++i)
+    {
+        EXPECT_EQ(1u, Stats.m_Occupancy[i]) << "bucket " << i;
+    }
+    EXPECT_EQ(10u, Stats.m_HighWaterMark);
+}
+
+TEST(ContainerStats, CountsOverflowAttempts)
+{
+    StatsList l = StatsList();
+    ListElement e = { 1 };
+    for (int i = 0; i < 10; ++i)
+    {
+        l.push_front(e);
+    }
+    EXPECT_THROW(l.push_back(e), std::bad_alloc);
+    EXPECT_THROW(l.insert(l.begin(), e), std::bad_alloc);
+
+    StatsFlatMap f = StatsFlatMap();
+    StatsHashMap h = StatsHashMap();
+    for (int i = 0; i < 4; ++i)
+    {
+        StatsFlatMap::value_type FlatValue = { i, { i } };
+        f.insert(FlatValue);
+        StatsHashMap::value_type HashValue = { i, { i } };
+        h.insert(HashValue);
+    }
+    StatsFlatMap::value_type FlatValue = { 4, { 4 } };
+    EXPECT_THROW(f.insert(FlatValue), std::bad_alloc);
+    StatsHashMap::value_type HashValue = { 4, { 4 } };
+    EXPECT_THROW(h.insert(HashValue), std::bad_alloc);
+    h.erase(0);
+
+    EXPECT_EQ(2u, container_stats<StatsList>().m_OverflowAttempts);
+    EXPECT_EQ(10u, container_stats<StatsList>().m_HighWaterMark);
+    EXPECT_EQ(1u, container_stats<StatsFlatMap>().m_OverflowAttempts);
+    EXPECT_EQ(4u, container_stats<StatsFlatMap>().m_Operations[ccc::stats::ContainerInsert]);
+    EXPECT_EQ(1u, container_stats<StatsHashMap>().m_OverflowAttempts);
+    EXPECT_EQ(1u, container_stats<StatsHashMap>().m_Operations[ccc::stats::ContainerErase]);
+    EXPECT_EQ(4u, container_stats<StatsHashMap>().m_HighWaterMark);
+}
+
+TEST(ContainerStats, FlatMapSubscriptCountsInsertsAndOverflows)
+{
+    typedef ccc::PodFlatMap<int, ListElement, uint32_t, 2> FlatMap;
+    FlatMap f = FlatMap();
+    f[1].m_Value = 1;
+    f[2].m_Value = 2;
+    f[1].m_Value = 3; // found, no insert
+    EXPECT_THROW(f[3], std::bad_alloc);
+    EXPECT_EQ(2u, f.size());
+    EXPECT_EQ(3, f.at(1).m_Value);
+
+    EXPECT_EQ(1u, container_stats<FlatMap>().m_OverflowAttempts);
+    EXPECT_EQ(2u, container_stats<FlatMap>().m_Operations[ccc::stats::ContainerInsert]);
+}
+
+TEST(ContainerStats, EmptyRangeErasesAreNotCounted)
+{
+    typedef ccc::PodVector<ListElement, uint32_t, 5> Vector;
+    typedef ccc::PodDeque<VectorElement, uint32_t, 5> Deque;
+    Vector v = Vector();
+    Deque d = Deque();
+    for (int i = 0; i < 3; ++i)
+    {
+        ListElement VectorValue = { i };
+        v.push_back(VectorValue);
+        VectorElement DequeValue = { i };
+        d.push_back(DequeValue);
+    }
+    v.erase(v.begin() + 1, v.begin() + 1);
+    d.erase(d.begin() + 1, d.begin() + 1);
+    EXPECT_EQ(0u, container_stats<Vector>().m_Operations[ccc::stats::ContainerErase]);
+    EXPECT_EQ(0u, container_stats<Deque>().m_Operations[ccc::stats::ContainerErase]);
+
+    v.erase(v.begin(), v.begin() + 2);
+    d.erase(d.begin(), d.begin() + 2);
+    EXPECT_EQ(1u, v.size());
+    EXPECT_EQ(1u, d.size());
+    EXPECT_EQ(1u, container_stats<Vector>().m_Operations[ccc::stats::ContainerErase]);
+    EXPECT_EQ(1u, container_stats<Deque>().m_Operations[ccc::stats::ContainerErase]);
+}
+
+TEST(ContainerStats, RuntimeCapacity)
+{
+    typedef ccc::FixedVector<ListElement, uint32_t> Vector;
+    typedef ccc::PodVector<ListElement, uint32_t, 0, 8, false, false, true> Base;
+    Vector Small(4);
+    Vector Large(20);
+    ListElement e = { 1 };
+    Small.push_back(e);
+    Large.push_back(e);
+    Large.push_back(e);
+    EXPECT_EQ(20u, container_stats<Base>().m_Capacity);
+    EXPECT_EQ(2u, container_stats<Base>().m_HighWaterMark);
+}
+
+TEST(ContainerStats, DumpListsRegisteredContainers)
+{
+    typedef ccc::PodVector<VectorElement, uint32_t, 12> Vector; // sizes 1 and 2 are in the buckets 0 and 1
+    Vector v = Vector();
+    VectorElement e = { 1 };
+    v.push_back(e);
+    v.push_back(e);
+    v.pop_back();
+
+    std::ostringstream Out;
+    ccc::stats::dump_container_stats(Out);
+    const std::string Dump = Out.str();
+    const std::string Line = std::string(typeid(Vector).name())
+            + " capacity=12 high_water_mark=2 overflows=0 inserts=2 erases=1 clears=0 assigns=0 occupancy=2,1,0,0,0,0,0,0,0,0,0\n";
+    EXPECT_NE(std::string::npos, Dump.find(Line)) << Dump;
+}
@@ -0,0 +1,142 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include <ccc/dirty_tracking.h>
+#include <ccc/pod_vector.h>
+#include <ccc/static_vector.h>
+#include <ccc/fixed_vector.h>
+
+#include "gTest_Container.h"
+
+template <class Tracked>
+std::vector<char> MakePatch(Tracked& Source)
+{
+    std::vector<char> Patch(Source.patch_size());
+    EXPECT_EQ(&Patch[0] + Patch.size(), Source.make_patch(&Patch[0]));
+    return Patch;
+}
+
+template <class Container>
+void ApplyPatch(Container& Target, const std::vector<char>& Patch)
+{
+    EXPECT_EQ(&Patch[0] + Patch.size(), ccc::apply_patch(Target, &Patch[0], &Patch[0] + Patch.size()));
+}
+
+TEST(DirtyTracking, PatchContainsOnlyDirtyBlocks)
+{
+    typedef ccc::StaticVector<int, uint32_t, 100000> Vector;
+    ccc::DirtyTracked<Vector, 16>* Source = new ccc::DirtyTracked<Vector, 16>();
+    Vector* Peer = new Vector();
+    Source->resize(100000);
+    ApplyPatch(*Peer, MakePatch(*Source));
+    EXPECT_EQ(100000, Peer->size());
+
+    EXPECT_EQ(sizeof(ccc::DirtyPatchHeader), Source->patch_size());
+    (*Source)[5] = 1;
+    Source->set(6, 2);
+    (*Source)[50000] = 3;
+    Source->modify()[99999] = 4;
+    Source->mark_dirty(99999);
+    EXPECT_TRUE(Source->is_dirty(15));
+    EXPECT_FALSE(Source->is_dirty(16));
+
+    std::vector<char> Patch = MakePatch(*Source);
+    EXPECT_EQ(sizeof(ccc::DirtyPatchHeader) + 3 * sizeof(ccc::DirtyPatchRun) + 3 * 16 * sizeof(int), Patch.size());
+    EXPECT_FALSE(Source->is_dirty(5));
+    ApplyPatch(*Peer, Patch);
+    EXPECT_EQ(1, (*Peer)[5]);
+    EXPECT_EQ(2, (*Peer)[6]);
+    EXPECT_EQ(3, (*Peer)[50000]);
+    EXPECT_EQ(4, (*Peer)[99999]);
+    delete Source;
+    delete Peer;
+}
+
+TEST(DirtyTracking, WrappedPodVectorStartsEmpty)
+{
+    typedef ccc::DirtyTracked<ccc::PodVector<int, uint32_t, 16>, 4> Tracked;
+    union
+    {
+        uint64_t m_Align;
+        char m_Bytes[sizeof(Tracked)];
+    } Memory;
+    std::memset(Memory.m_Bytes, 0x5a, sizeof(Memory.m_Bytes));
+    Tracked* Source = new (Memory.m_Bytes) Tracked();
+    EXPECT_TRUE(Source->empty());
+    EXPECT_EQ(0, Source->size());
+    EXPECT_FALSE(Source->is_dirty(0));
+    Source->~Tracked();
+}
+
+TEST(DirtyTracking, ModifiersAreReplicated)
+{
+    typedef ccc::FixedVector<tPOD, unsigned int> Vector;
+    ccc::DirtyTracked<Vector, 4> Source(50);
+    Vector Peer(50);
+    for (int i = 0; i < 30; ++i)
+    {
+        tPOD Value = { i, i * 0.5 };
+        Source.push_back(Value);
+    }
+    ApplyPatch(Peer, MakePatch(Source));
+
+    tPOD Inserted = { -1, -1.0 };
+    Source.insert(10, Inserted);
+    Source.erase(5);
+    Source.erase(20, 25);
+    Source.pop_back();
+    EXPECT_FALSE(Source.is_dirty(0)); // blocks in front of the first modification stay clean
+    std::vector<char> Patch = MakePatch(Source);
+    EXPECT_LT(Patch.size(), sizeof(ccc::DirtyPatchHeader) + sizeof(ccc::DirtyPatchRun) + 30 * sizeof(tPOD));
+    ApplyPatch(Peer, Patch);
+
+    ASSERT_EQ(Source.size(), Peer.size());
+    for (unsigned int i = 0; i < Peer.size(); ++i)
+    {
+        EXPECT_EQ(Source[i].x, Peer[i].x);
+        EXPECT_EQ(Source[i].y, Peer[i].y);
+    }
+
+    Source.clear();
+    ApplyPatch(Peer, MakePatch(Source));
+    EXPECT_TRUE(Peer.empty());
+}
+
+TEST(DirtyTracking, ArraysAndInvalidPatches)
+{
+    typedef ccc::PODArray<int, uint32_t, 300> Array;
+    ccc::DirtyTracked<Array> Source;
+    Array Peer;
+    for (unsigned int i = 0; i < Source.size(); ++i)
+    {
+        Source.set(i, 0);
+        Peer[i] = 0;
+    }
+    Source.clear_dirty();
+    Source[299] = 7;
+    std::vector<char> Patch = MakePatch(Source);
+    EXPECT_EQ(sizeof(ccc::DirtyPatchHeader) + sizeof(ccc::DirtyPatchRun) + (300 - 256) * sizeof(int), Patch.size());
+    ApplyPatch(Peer, Patch);
+    EXPECT_EQ(7, Peer[299]);
+
+    ccc::PODArray<int, uint32_t, 200> SmallerPeer;
+    EXPECT_THROW(ccc::apply_patch(SmallerPeer, &Patch[0], &Patch[0] + Patch.size()), std::runtime_error);
+    EXPECT_THROW(ccc::apply_patch(Peer, &Patch[0], &Patch[0] + Patch.size() - 1), std::runtime_error);
+    ccc::StaticVector<int, uint32_t, 100> SmallVector;
+    EXPECT_THROW(ccc::apply_patch(SmallVector, &Patch[0], &Patch[0] + Patch.size()), std::bad_alloc);
+}
@@ -0,0 +1,76 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+// instantiates all members of the common configurations, which checks that they compile
+#define CCC_INSTANTIATE_COMMON_TEMPLATES
+#include <ccc/extern_templates.h>
+
+#include "gtest/gtest.h"
+
+struct ExternPoint
+{
+    int x;
+    int y;
+};
+
+inline bool operator==(const ExternPoint& lhs, const ExternPoint& rhs)
+{
+    return (lhs.x == rhs.x) and (lhs.y == rhs.y);
+}
+
+inline bool operator<(const ExternPoint& lhs, const ExternPoint& rhs)
+{
+    return (lhs.x < rhs.x) or ((lhs.x == rhs.x) and (lhs.y < rhs.y));
+}
+
+CCC_DEFINE_FIXED_VECTOR(ExternPoint, uint16_t);
+CCC_DEFINE_FIXED_DEQUE(ExternPoint, uint16_t);
+CCC_DEFINE_FIXED_LIST(ExternPoint, uint16_t);
+CCC_DEFINE_FIXED_FLAT_MAP(int, ExternPoint, uint16_t);
+CCC_DEFINE_FIXED_HASH_MAP(int, ExternPoint, uint16_t);
+
+TEST(ExternTemplates, CommonConfigurations)
+{
+    ccc::FixedVector<uint64_t> v(4);
+    v.push_back(1);
+    ccc::FixedDeque<double> d(4);
+    d.push_front(2.0);
+    ccc::FixedList<int32_t> l(4);
+    l.push_back(3);
+    ccc::FixedFlatMap<uint32_t, uint32_t> f(4);
+    f[4] = 4;
+    ccc::FixedHashMap<uint64_t, uint64_t> h(8);
+    h[5] = 5;
+    EXPECT_EQ(15.0, v[0] + d[0] + l.front() + f[4] + h[5]);
+}
+
+TEST(ExternTemplates, UserConfigurations)
+{
+    const ExternPoint Point = { 1, 2 };
+    ccc::FixedVector<ExternPoint, uint16_t> v(2);
+    v.push_back(Point);
+    ccc::FixedDeque<ExternPoint, uint16_t> d(2);
+    d.push_back(Point);
+    ccc::FixedList<ExternPoint, uint16_t> l(2);
+    l.push_back(Point);
+    ccc::FixedFlatMap<int, ExternPoint, uint16_t> f(2);
+    f[1] = Point;
+    ccc::FixedHashMap<int, ExternPoint, uint16_t> h(4);
+    h[1] = Point;
+    EXPECT_EQ(Point, v[0]);
+    EXPECT_EQ(Point, d[0]);
+    EXPECT_EQ(Point, l.front());
+    EXPECT_EQ(Point, f[1]);
+    EXPECT_EQ(Point, h[1]);
+}
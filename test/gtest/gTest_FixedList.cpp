@@ -8,6 +8,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include <ccc/fixed_list.h>
 #include <ccc/test/consistent_integers.h>
 
@@ -16,3 +18,22 @@ TEST(FixedList, experimental)
     typedef ccc::FixedList<int, uint64_t> FixedContainer;
     FixedContainer c(10);
 }
+
+TEST(FixedList, Assignment)
+{
+    typedef ccc::FixedList<int, uint32_t> FixedContainer;
+    FixedContainer a(10);
+    for (int i = 0; i < 7; ++i)
+    {
+        a.push_back(i);
+    }
+    FixedContainer b(10);
+    b.push_back(42);
+    b = a;
+    EXPECT_TRUE(std::equal(a.begin(), a.end(), b.begin()));
+    EXPECT_EQ(7u, b.size());
+    FixedContainer c(3);
+    c = a;
+    EXPECT_EQ(10u, c.max_size());
+    EXPECT_TRUE(std::equal(a.begin(), a.end(), c.begin()));
+}
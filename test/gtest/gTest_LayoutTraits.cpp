@@ -0,0 +1,104 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <ccc/layout_traits.h>
+#include <ccc/layout_header.h>
+#include <ccc/pod_hash_map.h>
+
+#include "gTest_Container.h"
+
+typedef ccc::StaticVector<int, uint32_t, 100> IntVector;
+typedef ccc::StaticDeque<int, uint32_t, 100> IntDeque;
+typedef ccc::StaticList<int, uint32_t, 100> IntList;
+
+// the traits are integral constants
+static_assert(ccc::layout_traits<IntVector>::size == sizeof(IntVector), "size");
+static_assert(ccc::layout_traits<IntVector>::capacity == 100, "capacity");
+static_assert(ccc::layout_traits<IntVector>::end_offset == 0, "m_End leads the vector");
+static_assert(ccc::layout_traits<IntDeque>::begin_offset < ccc::layout_traits<IntDeque>::end_offset, "m_Begin precedes m_End");
+static_assert(ccc::layout_traits<IntList>::nodes_offset < ccc::layout_traits<IntList>::values_offset, "m_Nodes precede m_Values");
+static_assert(ccc::layout_traits<IntVector>::fingerprint != ccc::layout_traits<IntDeque>::fingerprint, "fingerprint");
+
+TEST(LayoutTraits, OffsetsMatchMembers)
+{
+    IntVector Vector;
+    const ccc::PodVector<int, uint32_t, 100>& PodVector = Vector;
+    const char* Base = reinterpret_cast<const char*>(&Vector);
+    EXPECT_EQ(reinterpret_cast<const char*>(&PodVector.m_End) - Base, +ccc::layout_traits<IntVector>::end_offset);
+    EXPECT_EQ(reinterpret_cast<const char*>(&PodVector.m_Storage) - Base, +ccc::layout_traits<IntVector>::storage_offset);
+    EXPECT_EQ(sizeof(PodVector.m_Storage), +ccc::layout_traits<IntVector>::storage_size);
+
+    IntList List;
+    const ccc::PodList<int, uint32_t, 100>& PodList = List;
+    Base = reinterpret_cast<const char*>(&List);
+    EXPECT_EQ(reinterpret_cast<const char*>(&PodList.m_Size) - Base, +ccc::layout_traits<IntList>::size_offset);
+    EXPECT_EQ(reinterpret_cast<const char*>(&PodList.m_Nodes) - Base, +ccc::layout_traits<IntList>::nodes_offset);
+    EXPECT_EQ(reinterpret_cast<const char*>(&PodList.m_Values) - Base, +ccc::layout_traits<IntList>::values_offset);
+    EXPECT_EQ(reinterpret_cast<const char*>(&PodList.m_Deallocated) - Base, +ccc::layout_traits<IntList>::deallocated_offset);
+}
+
+TEST(LayoutTraits, DerivedContainersShareTheLayoutOfTheirBase)
+{
+    typedef ccc::PodVector<int, uint32_t, 100> Pod;
+    typedef ccc::ConsistentVector<int, uint32_t, 100> Consistent;
+    EXPECT_EQ(+ccc::layout_traits<Pod>::fingerprint, +ccc::layout_traits<Consistent>::fingerprint);
+    EXPECT_EQ(+ccc::layout_traits<Pod>::fingerprint, +ccc::layout_traits<IntVector>::fingerprint);
+    EXPECT_EQ(+ccc::layout_traits<ccc::FixedDeque<int> >::fingerprint,
+            +(ccc::layout_traits<ccc::ConsistentDeque<int, unsigned int, 0, 8, false, false, true> >::fingerprint));
+}
+
+// value types of equal size and alignment (e.g. int and float) share a layout and thus a fingerprint
+TEST(LayoutTraits, FingerprintDistinguishesInstantiations)
+{
+    std::vector<uint64_t> Fingerprints;
+    Fingerprints.push_back(+ccc::layout_traits<IntVector>::fingerprint);
+    Fingerprints.push_back(+ccc::layout_traits<IntDeque>::fingerprint);
+    Fingerprints.push_back(+ccc::layout_traits<IntList>::fingerprint);
+    Fingerprints.push_back(+ccc::layout_traits<ccc::StaticVector<int, uint32_t, 101> >::fingerprint);
+    Fingerprints.push_back(+ccc::layout_traits<ccc::StaticVector<int, uint64_t, 100> >::fingerprint);
+    Fingerprints.push_back(+ccc::layout_traits<ccc::StaticVector<short, uint32_t, 100> >::fingerprint);
+    Fingerprints.push_back(+ccc::layout_traits<ccc::StaticVector<int, uint32_t, 100, 16> >::fingerprint);
+    Fingerprints.push_back(+ccc::layout_traits<ccc::FixedVector<int> >::fingerprint);
+    Fingerprints.push_back(+ccc::layout_traits<ccc::FixedList<int> >::fingerprint);
+    for (std::size_t i = 0; i < Fingerprints.size(); ++i)
+    {
+        for (std::size_t j = i + 1; j < Fingerprints.size(); ++j)
+        {
+            EXPECT_NE(Fingerprints[i], Fingerprints[j]) << i << " vs " << j;
+        }
+    }
+}
+
+TEST(LayoutTraits, OtherContainersFallBackToThePrimaryTemplate)
+{
+    typedef ccc::PodHashMap<int, int, uint32_t, 64> HashMap;
+    EXPECT_EQ(0u, +ccc::layout_traits<HashMap>::family);
+    EXPECT_EQ(0u, +ccc::layout_traits<HashMap>::capacity);
+    EXPECT_FALSE(+ccc::layout_traits<HashMap>::static_storage);
+    EXPECT_EQ(sizeof(HashMap), +ccc::layout_traits<HashMap>::size);
+    EXPECT_EQ(+ccc::layout_traits<HashMap>::basic_fingerprint, +ccc::layout_traits<HashMap>::fingerprint);
+}
+
+TEST(LayoutTraits, HeaderCarriesFingerprint)
+{
+    ccc::LayoutHeader Header = ccc::make_layout_header<IntDeque>("test", 100, 0, sizeof(IntDeque));
+    EXPECT_EQ(+ccc::layout_traits<IntDeque>::fingerprint, Header.m_Fingerprint);
+    EXPECT_NO_THROW(ccc::validate_layout_header<IntDeque>(Header, "test"));
+
+    ++Header.m_Fingerprint;
+    EXPECT_THROW(ccc::validate_layout_header<IntDeque>(Header, "test"), std::runtime_error);
+}
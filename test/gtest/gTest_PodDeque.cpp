@@ -90,3 +90,41 @@ TEST(PodDeque, ModuloOperation)
     EXPECT_EQ(9, C_uint8_t::modulo(-11, 10));
     EXPECT_EQ(1, C_uint8_t::modulo(11, 10));
 }
+
+struct DequePoint
+{
+    int x;
+    int y;
+};
+
+TEST(PodDeque, MemberAccessThroughIterators)
+{
+    ccc::PodDeque<DequePoint, uint32_t, 10> c = ccc::PodDeque<DequePoint, uint32_t, 10>();
+    DequePoint Value = { 1, 2 };
+    c.push_front(Value);
+    c.begin()->y = 3;
+    const ccc::PodDeque<DequePoint, uint32_t, 10>& Const = c;
+    EXPECT_EQ(1, Const.begin()->x);
+    EXPECT_EQ(3, Const.begin()->y);
+}
+
+TEST(PodDeque, InsertAtLogicalIndex)
+{
+    ccc::PodDeque<int, uint32_t, 10> c = ccc::PodDeque<int, uint32_t, 10>();
+    for (int i = 0; i < 8; ++i)
+    {
+        c.push_back(i);
+    }
+    for (int i = 0; i < 6; ++i) // wrap around the physical end
+    {
+        c.pop_front();
+        c.push_back(8 + i);
+    }
+    EXPECT_EQ(42, *c.insert(3u, 42));
+    const int Expected[] = { 6, 7, 8, 42, 9, 10, 11, 12, 13 };
+    ASSERT_EQ(9u, c.size());
+    for (uint32_t i = 0; i < 9; ++i)
+    {
+        EXPECT_EQ(Expected[i], c[i]);
+    }
+}
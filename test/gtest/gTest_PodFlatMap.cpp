@@ -0,0 +1,197 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include <ccc/pod_flat_map.h>
+#include <ccc/fixed_flat_map.h>
+
+#include "gTest_Container.h"
+
+#if (__cplusplus >= 201103L)
+#include <type_traits>
+#endif
+
+typedef ccc::PodFlatMap<int, double, uint16_t, 100> MapOfDoubles;
+typedef ccc::PodFlatMap<int, tPOD, uint16_t, 100, std::less<int>, 16, true> EytzingerMapOfPODs;
+
+#if (__cplusplus >= 201103L)
+TEST(PodFlatMap, TypeTraits_Cpp11)
+{
+    EXPECT_TRUE(std::is_pod<MapOfDoubles>::value);
+    EXPECT_TRUE(std::is_pod<EytzingerMapOfPODs>::value);
+}
+#endif
+
+template <class FlatMap, class T>
+void ExpectEqualMaps(const FlatMap& Actual, const std::map<int, T>& Expected)
+{
+    ASSERT_EQ(Expected.size(), Actual.size());
+    typename FlatMap::const_iterator Position = Actual.begin();
+    for (typename std::map<int, T>::const_iterator it = Expected.begin(); it != Expected.end(); ++it, ++Position)
+    {
+        EXPECT_EQ(it->first, Position->first);
+        EXPECT_EQ(it->second, Position->second);
+    }
+}
+
+template <class FlatMap, class T>
+void ExpectEqualLookups(const FlatMap& Actual, const std::map<int, T>& Expected, int Lowest, int Highest)
+{
+    for (int Key = Lowest; Key <= Highest; ++Key)
+    {
+        EXPECT_EQ(std::distance(Expected.begin(), Expected.lower_bound(Key)),
+                std::distance(Actual.begin(), Actual.lower_bound(Key))) << Key;
+        EXPECT_EQ(std::distance(Expected.begin(), Expected.upper_bound(Key)),
+                std::distance(Actual.begin(), Actual.upper_bound(Key))) << Key;
+        EXPECT_EQ(Expected.count(Key), Actual.count(Key)) << Key;
+    }
+}
+
+TEST(PodFlatMap, SubscriptAndAt)
+{
+    MapOfDoubles c = MapOfDoubles();
+    std::map<int, double> Expected;
+    std::srand(11);
+    for (int i = 0; i < 90; ++i)
+    {
+        int Key = std::rand() % 120;
+        c[Key] += i;
+        Expected[Key] += i;
+    }
+    ExpectEqualMaps(c, Expected);
+    ExpectEqualLookups(c, Expected, -1, 121);
+    EXPECT_EQ(Expected.begin()->second, c.at(Expected.begin()->first));
+    EXPECT_THROW(c.at(-1), std::out_of_range);
+    const MapOfDoubles& ConstRef = c;
+    EXPECT_THROW(ConstRef.at(200), std::out_of_range);
+}
+
+TEST(PodFlatMap, InsertErase)
+{
+    MapOfDoubles c = MapOfDoubles();
+    MapOfDoubles::value_type Value = { 5, 0.5 };
+    EXPECT_TRUE(c.insert(Value).second);
+    Value.second = 1.5;
+    std::pair<MapOfDoubles::iterator, bool> Result = c.insert(Value);
+    EXPECT_FALSE(Result.second);
+    EXPECT_EQ(0.5, Result.first->second);
+    Value.first = 3;
+    EXPECT_EQ(c.begin(), c.insert(Value).first);
+    EXPECT_EQ(1, c.erase(5));
+    EXPECT_EQ(0, c.erase(5));
+    EXPECT_EQ(c.end(), c.erase(c.begin()));
+    EXPECT_TRUE(c.empty());
+}
+
+TEST(PodFlatMap, EytzingerLayout)
+{
+    EytzingerMapOfPODs c = EytzingerMapOfPODs();
+    std::map<int, tPOD> Expected;
+    for (int Size = 1; Size <= 100; ++Size)
+    {
+        tPOD Value = { Size, 0.5 * Size };
+        c[3 * Size] = Value;
+        Expected[3 * Size] = Value;
+        c.rebuild_layout();
+        ASSERT_TRUE(c.m_Layout.valid());
+        ExpectEqualLookups(c, Expected, 0, 3 * Size + 1);
+    }
+    // modifying mapped values keeps the layout
+    c.find(30)->second.x = -1;
+    Expected[30].x = -1;
+    c.at(60).x = -2;
+    Expected[60].x = -2;
+    EXPECT_TRUE(c.m_Layout.valid());
+    ExpectEqualMaps(c, Expected);
+}
+
+TEST(PodFlatMap, InsertSortedRange)
+{
+    EytzingerMapOfPODs c = EytzingerMapOfPODs();
+    std::map<int, tPOD> Expected;
+    std::vector<EytzingerMapOfPODs::value_type> Values;
+    for (int i = 0; i < 20; ++i)
+    {
+        EytzingerMapOfPODs::value_type Value = { 2 * i, { i, 0.25 * i } };
+        Values.push_back(Value);
+        Expected.insert(std::make_pair(Value.first, Value.second));
+    }
+    c.insert_sorted_range(Values.begin(), Values.end());
+    c.rebuild_layout();
+    for (int i = 0; i < 20; ++i)
+    {
+        // existing keys keep their mapped values
+        Values[i].first = 3 * i;
+        Values[i].second.x = 100 + i;
+        Expected.insert(std::make_pair(Values[i].first, Values[i].second));
+    }
+    c.insert_sorted_range(Values.begin(), Values.end());
+    ExpectEqualMaps(c, Expected);
+    c.rebuild_layout();
+    ExpectEqualLookups(c, Expected, -1, 60);
+}
+
+TEST(PodFlatMap, InsertSortedRangeKeepsTheFirstOfEqualKeys)
+{
+    EytzingerMapOfPODs c = EytzingerMapOfPODs();
+    EytzingerMapOfPODs::value_type Contained = { 4, { -1, 0.0 } };
+    c.insert(Contained);
+    std::map<int, tPOD> Expected;
+    Expected.insert(std::make_pair(Contained.first, Contained.second));
+    std::vector<EytzingerMapOfPODs::value_type> Values;
+    for (int i = 0; i < 12; ++i)
+    {
+        // keys 0, 0, 0, 1, 1, 1, ..., each three times with distinct mapped values
+        EytzingerMapOfPODs::value_type Value = { i / 3, { i, 0.0 } };
+        Values.push_back(Value);
+    }
+    EytzingerMapOfPODs::value_type Duplicate = { 4, { 100, 0.0 } };
+    Values.push_back(Duplicate);
+    Values.push_back(Duplicate);
+    for (std::size_t i = 0; i < Values.size(); ++i)
+    {
+        Expected.insert(std::make_pair(Values[i].first, Values[i].second));
+    }
+    c.insert_sorted_range(Values.begin(), Values.end());
+    ExpectEqualMaps(c, Expected);
+    EXPECT_EQ(0, c.find(0)->second.x);
+    EXPECT_EQ(9, c.find(3)->second.x);
+    EXPECT_EQ(-1, c.find(4)->second.x);
+}
+
+TEST(PodFlatMap, FixedFlatMap)
+{
+    typedef ccc::FixedFlatMap<int, double, unsigned int, std::less<int>, 8, true> FixedMap;
+    FixedMap c(40);
+    std::map<int, double> Expected;
+    for (int Key = 0; Key < 40; ++Key)
+    {
+        c[Key * 5] = Key;
+        Expected[Key * 5] = Key;
+    }
+    EXPECT_THROW(c[1], std::bad_alloc);
+    c.rebuild_layout();
+    ExpectEqualLookups(c, Expected, -1, 200);
+
+    FixedMap Copy(c);
+    ExpectEqualMaps(Copy, Expected);
+    FixedMap Other(5);
+    Other = c;
+    EXPECT_EQ(40, Other.max_size());
+    ExpectEqualMaps(Other, Expected);
+}
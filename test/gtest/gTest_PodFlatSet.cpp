@@ -0,0 +1,201 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#include <cstdlib>
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <vector>
+
+#include <ccc/pod_flat_set.h>
+#include <ccc/fixed_flat_set.h>
+
+#include "gTest_Container.h"
+
+#if (__cplusplus >= 201103L)
+#include <type_traits>
+#endif
+
+typedef ccc::PodFlatSet<int, uint16_t, 100> SetOfInts;
+typedef ccc::PodFlatSet<int, uint16_t, 100, std::less<int>, 8, true> EytzingerSetOfInts;
+typedef ccc::PodFlatSet<int, uint16_t, 100, std::greater<int> > DescendingSetOfInts;
+
+#if (__cplusplus >= 201103L)
+TEST(PodFlatSet, TypeTraits_Cpp11)
+{
+    EXPECT_TRUE(std::is_pod<SetOfInts>::value);
+    EXPECT_TRUE(std::is_pod<EytzingerSetOfInts>::value);
+}
+#endif
+
+template <class FlatSet, class Compare>
+void ExpectEqualSets(const FlatSet& Actual, const std::set<int, Compare>& Expected)
+{
+    ASSERT_EQ(Expected.size(), Actual.size());
+    EXPECT_TRUE(std::equal(Expected.begin(), Expected.end(), Actual.begin()));
+}
+
+template <class FlatSet, class Compare>
+void ExpectEqualLookups(const FlatSet& Actual, const std::set<int, Compare>& Expected, int Lowest, int Highest)
+{
+    for (int Key = Lowest; Key <= Highest; ++Key)
+    {
+        typename std::set<int, Compare>::const_iterator Lower = Expected.lower_bound(Key);
+        typename std::set<int, Compare>::const_iterator Upper = Expected.upper_bound(Key);
+        EXPECT_EQ(std::distance(Expected.begin(), Lower), std::distance(Actual.begin(), Actual.lower_bound(Key))) << Key;
+        EXPECT_EQ(std::distance(Expected.begin(), Upper), std::distance(Actual.begin(), Actual.upper_bound(Key))) << Key;
+        EXPECT_EQ(Expected.count(Key), Actual.count(Key)) << Key;
+        EXPECT_EQ(Expected.count(Key) == 0, Actual.find(Key) == Actual.end()) << Key;
+    }
+}
+
+TEST(PodFlatSet, InsertFindErase)
+{
+    SetOfInts c = SetOfInts();
+    std::set<int> Expected;
+    std::srand(7);
+    for (int i = 0; i < 80; ++i)
+    {
+        int Key = std::rand() % 120;
+        std::pair<SetOfInts::iterator, bool> Result = c.insert(Key);
+        EXPECT_EQ(Expected.insert(Key).second, Result.second);
+        EXPECT_EQ(Key, *Result.first);
+    }
+    ExpectEqualSets(c, Expected);
+    ExpectEqualLookups(c, Expected, -1, 121);
+
+    for (int Key = 0; Key < 120; Key += 3)
+    {
+        EXPECT_EQ(Expected.erase(Key), c.erase(Key));
+    }
+    ExpectEqualSets(c, Expected);
+    ExpectEqualLookups(c, Expected, -1, 121);
+}
+
+TEST(PodFlatSet, EmptySet)
+{
+    EytzingerSetOfInts c = EytzingerSetOfInts();
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(c.end(), c.find(1));
+    EXPECT_EQ(c.end(), c.lower_bound(1));
+    c.rebuild_layout();
+    EXPECT_EQ(c.end(), c.find(1));
+    EXPECT_EQ(c.end(), c.lower_bound(1));
+}
+
+TEST(PodFlatSet, EytzingerLayout)
+{
+    EytzingerSetOfInts c = EytzingerSetOfInts();
+    std::set<int> Expected;
+    // test all tree shapes from a single node up to several complete levels
+    for (int Size = 1; Size <= 100; ++Size)
+    {
+        c.insert(2 * Size);
+        Expected.insert(2 * Size);
+        c.rebuild_layout();
+        ASSERT_TRUE(c.m_Layout.valid());
+        ExpectEqualLookups(c, Expected, 0, 2 * Size + 1);
+    }
+    c.erase(10);
+    Expected.erase(10);
+    EXPECT_FALSE(c.m_Layout.valid());
+    ExpectEqualLookups(c, Expected, 0, 201);
+}
+
+TEST(PodFlatSet, InsertSortedRange)
+{
+    EytzingerSetOfInts c = EytzingerSetOfInts();
+    std::set<int> Expected;
+    int Evens[] = { 0, 2, 4, 6, 8, 10, 12, 14 };
+    int Mixed[] = { -3, 1, 1, 4, 5, 9, 14, 15, 20 };
+    c.insert_sorted_range(Evens, Evens + 8);
+    Expected.insert(Evens, Evens + 8);
+    ExpectEqualSets(c, Expected);
+    c.rebuild_layout();
+    c.insert_sorted_range(Mixed, Mixed + 9);
+    Expected.insert(Mixed, Mixed + 9);
+    ExpectEqualSets(c, Expected);
+    c.rebuild_layout();
+    ExpectEqualLookups(c, Expected, -5, 22);
+    c.insert_sorted_range(Mixed, Mixed);
+    ExpectEqualSets(c, Expected);
+}
+
+TEST(PodFlatSet, InsertSortedRangeExceedingCapacity)
+{
+    SetOfInts c = SetOfInts();
+    std::vector<int> Keys(101);
+    for (int i = 0; i < 101; ++i)
+    {
+        Keys[i] = i;
+    }
+    EXPECT_THROW(c.insert_sorted_range(Keys.begin(), Keys.end()), std::bad_alloc);
+    EXPECT_TRUE(c.empty());
+    c.insert_sorted_range(Keys.begin(), Keys.end() - 1);
+    EXPECT_EQ(100, c.size());
+}
+
+TEST(PodFlatSet, CustomCompare)
+{
+    DescendingSetOfInts c = DescendingSetOfInts();
+    std::set<int, std::greater<int> > Expected;
+    int Keys[] = { 9, 7, 7, 3, 1 };
+    c.insert_sorted_range(Keys, Keys + 5);
+    Expected.insert(Keys, Keys + 5);
+    c.insert(5);
+    Expected.insert(5);
+    ExpectEqualSets(c, Expected);
+    ExpectEqualLookups(c, Expected, 0, 10);
+}
+
+TEST(PodFlatSet, Swap)
+{
+    EytzingerSetOfInts a = EytzingerSetOfInts();
+    EytzingerSetOfInts b = EytzingerSetOfInts();
+    a.insert(1);
+    a.insert(2);
+    a.rebuild_layout();
+    b.insert(3);
+    a.swap(b);
+    EXPECT_EQ(1, a.size());
+    EXPECT_FALSE(a.m_Layout.valid());
+    EXPECT_TRUE(b.m_Layout.valid());
+    EXPECT_EQ(b.begin() + 1, b.find(2));
+    EXPECT_EQ(a.begin(), a.find(3));
+}
+
+TEST(PodFlatSet, FixedFlatSet)
+{
+    typedef ccc::FixedFlatSet<int, unsigned int, std::less<int>, 8, true> FixedSet;
+    FixedSet c(50);
+    std::set<int> Expected;
+    EXPECT_EQ(50, c.max_size());
+    for (int Key = 49; Key >= 0; --Key)
+    {
+        c.insert(Key * 2);
+        Expected.insert(Key * 2);
+    }
+    EXPECT_THROW(c.insert_sorted_range(Expected.begin(), ++Expected.begin()), std::bad_alloc);
+    c.rebuild_layout();
+    ExpectEqualLookups(c, Expected, -1, 101);
+
+    FixedSet Copy(c);
+    EXPECT_FALSE(Copy.m_Layout.valid());
+    ExpectEqualSets(Copy, Expected);
+    FixedSet Other(10);
+    Other = c;
+    EXPECT_EQ(50, Other.max_size());
+    Other.rebuild_layout();
+    ExpectEqualLookups(Other, Expected, -1, 101);
+}
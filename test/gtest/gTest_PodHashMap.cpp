@@ -0,0 +1,246 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#include <cstdlib>
+#include <map>
+
+#include <ccc/pod_hash_map.h>
+#include <ccc/fixed_hash_map.h>
+
+#include "gTest_Container.h"
+
+#if (__cplusplus >= 201103L)
+#include <type_traits>
+#endif
+
+typedef ccc::PodHashMap<int, double, uint16_t, 128> HashMapOfDoubles;
+typedef ccc::PodHashMap<int, tPOD, uint32_t, 100> HashMapOfPODs;
+
+/**
+ * Maps all keys to the same bucket, so every key lengthens the same probe sequence.
+ */
+struct CollidingHash
+{
+    uint64_t operator()(int) const
+    {
+        return 0;
+    }
+};
+
+/**
+ * Maps key k to bucket k % 10 of a map with 10 buckets.
+ */
+struct BucketHash
+{
+    uint64_t operator()(int Key) const
+    {
+        return ((static_cast<uint64_t>(Key % 10) << 32) + 9) / 10;
+    }
+};
+
+#if (__cplusplus >= 201103L)
+TEST(PodHashMap, TypeTraits_Cpp11)
+{
+    EXPECT_TRUE(std::is_pod<HashMapOfDoubles>::value);
+    EXPECT_TRUE(std::is_pod<HashMapOfPODs>::value);
+}
+#endif
+
+template <class HashMap, class T>
+void ExpectEqualMaps(const HashMap& Actual, const std::map<int, T>& Expected)
+{
+    ASSERT_EQ(Expected.size(), Actual.size());
+    std::size_t Visited = 0;
+    for (typename HashMap::const_iterator Position = Actual.begin(); Position != Actual.end(); ++Position, ++Visited)
+    {
+        typename std::map<int, T>::const_iterator it = Expected.find(Position->first);
+        ASSERT_TRUE(it != Expected.end()) << Position->first;
+        EXPECT_EQ(it->second, Position->second);
+    }
+    EXPECT_EQ(Expected.size(), Visited);
+    for (typename std::map<int, T>::const_iterator it = Expected.begin(); it != Expected.end(); ++it)
+    {
+        EXPECT_EQ(1, Actual.count(it->first)) << it->first;
+    }
+}
+
+TEST(PodHashMap, SubscriptAndAt)
+{
+    HashMapOfDoubles c = HashMapOfDoubles();
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(128, c.max_size());
+    EXPECT_EQ(c.end(), c.begin());
+    std::map<int, double> Expected;
+    std::srand(11);
+    for (int i = 0; i < 90; ++i)
+    {
+        int Key = std::rand() % 120;
+        c[Key] += i;
+        Expected[Key] += i;
+    }
+    ExpectEqualMaps(c, Expected);
+    EXPECT_EQ(Expected.begin()->second, c.at(Expected.begin()->first));
+    EXPECT_THROW(c.at(-1), std::out_of_range);
+    const HashMapOfDoubles& ConstRef = c;
+    EXPECT_THROW(ConstRef.at(200), std::out_of_range);
+    EXPECT_EQ(ConstRef.end(), ConstRef.find(200));
+}
+
+TEST(PodHashMap, InsertErase)
+{
+    HashMapOfDoubles c = HashMapOfDoubles();
+    HashMapOfDoubles::value_type Value = { 5, 0.5 };
+    EXPECT_TRUE(c.insert(Value).second);
+    Value.second = 1.5;
+    std::pair<HashMapOfDoubles::iterator, bool> Result = c.insert(Value);
+    EXPECT_FALSE(Result.second);
+    EXPECT_EQ(0.5, Result.first->second);
+    EXPECT_EQ(1, c.erase(5));
+    EXPECT_EQ(0, c.erase(5));
+    Value.first = 7;
+    c.insert(Value);
+    c.erase(c.find(7));
+    EXPECT_TRUE(c.empty());
+}
+
+TEST(PodHashMap, RandomOperations)
+{
+    HashMapOfPODs c = HashMapOfPODs();
+    std::map<int, tPOD> Expected;
+    std::srand(17);
+    for (int i = 0; i < 5000; ++i)
+    {
+        int Key = std::rand() % 150;
+        if ((std::rand() % 2) and (Expected.size() < 90))
+        {
+            tPOD Value = { i, 0.5 * i };
+            c[Key] = Value;
+            Expected[Key] = Value;
+        }
+        else
+        {
+            ASSERT_EQ(Expected.erase(Key), c.erase(Key));
+        }
+    }
+    ExpectEqualMaps(c, Expected);
+    c.clear();
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(c.end(), c.begin());
+}
+
+TEST(PodHashMap, ProbeSequencesSurviveErasing)
+{
+    // keys 0, 10, 20 share bucket 0 and key 9 wraps around from the last bucket
+    typedef ccc::PodHashMap<int, int, uint8_t, 10, BucketHash> SmallMap;
+    SmallMap c = SmallMap();
+    const int Keys[] = { 9, 19, 0, 10, 1, 20 };
+    for (int i = 0; i < 6; ++i)
+    {
+        ASSERT_EQ(Keys[i] % 10, c.bucket(Keys[i]));
+        c[Keys[i]] = i;
+    }
+    EXPECT_EQ(9, c.find(9).m_Bucket);
+    EXPECT_EQ(0, c.find(19).m_Bucket);
+    EXPECT_EQ(4, c.find(20).m_Bucket);
+
+    EXPECT_EQ(1, c.erase(19));
+    EXPECT_EQ(0, c.find(0).m_Bucket);
+    EXPECT_EQ(1, c.find(10).m_Bucket);
+    EXPECT_EQ(2, c.find(1).m_Bucket);
+    EXPECT_EQ(3, c.find(20).m_Bucket);
+    EXPECT_EQ(1, c.erase(9));
+    EXPECT_EQ(1, c.erase(0));
+    for (int i = 3; i < 6; ++i)
+    {
+        EXPECT_EQ(i, c.at(Keys[i]));
+    }
+    EXPECT_EQ(3, c.size());
+}
+
+TEST(PodHashMap, FullMap)
+{
+    typedef ccc::PodHashMap<int, int, uint8_t, 16, CollidingHash> CollidingMap;
+    CollidingMap c = CollidingMap();
+    for (int i = 0; i < 16; ++i)
+    {
+        c[i] = i;
+    }
+    CollidingMap::value_type Value = { 16, 16 };
+    EXPECT_THROW(c.insert(Value), std::bad_alloc);
+    Value.first = 3;
+    EXPECT_FALSE(c.insert(Value).second);
+    EXPECT_EQ(0, c.count(16));
+    for (int i = 0; i < 16; i += 2)
+    {
+        EXPECT_EQ(1, c.erase(i));
+    }
+    for (int i = 1; i < 16; i += 2)
+    {
+        EXPECT_EQ(i, c.at(i));
+    }
+}
+
+/**
+ * Key without padding bytes, as required by ccc::pod_hash.
+ */
+struct Coordinates
+{
+    int x;
+    int y;
+
+    bool operator==(const Coordinates& rhs) const
+    {
+        return (this->x == rhs.x) && (this->y == rhs.y);
+    }
+};
+
+TEST(PodHashMap, StructKeys)
+{
+    typedef ccc::PodHashMap<Coordinates, int, uint32_t, 64> MapOfCoordinates;
+    MapOfCoordinates c = MapOfCoordinates();
+    for (int i = 0; i < 40; ++i)
+    {
+        Coordinates Key = { i, -i };
+        c[Key] = i;
+    }
+    for (int i = 0; i < 40; ++i)
+    {
+        Coordinates Key = { i, -i };
+        EXPECT_EQ(i, c.at(Key));
+    }
+    Coordinates Missing = { 1, 1 };
+    EXPECT_EQ(0, c.count(Missing));
+}
+
+TEST(FixedHashMap, CopyAndAssign)
+{
+    typedef ccc::FixedHashMap<int, double> Map;
+    Map c(50);
+    EXPECT_EQ(50, c.max_size());
+    EXPECT_TRUE(c.empty());
+    std::map<int, double> Expected;
+    for (int i = 0; i < 30; ++i)
+    {
+        c[3 * i] = 0.5 * i;
+        Expected[3 * i] = 0.5 * i;
+    }
+    Map Copy(c);
+    ExpectEqualMaps(Copy, Expected);
+
+    Map Other(10);
+    Other[1] = 1;
+    Other = c;
+    EXPECT_EQ(50, Other.max_size());
+    ExpectEqualMaps(Other, Expected);
+}
@@ -60,3 +60,20 @@ typedef ::testing::Types<
         RefPair<ccc::PodList<ccc_test::Pod<16, 1>, uint8_t, 10, 1>, std::list<ccc_test::Pod<16, 1> > >
 > RefPairTypes;
 INSTANTIATE_TYPED_TEST_CASE_P(PodList, TestOfSequenceContainer, RefPairTypes);
+
+struct ListPoint
+{
+    int x;
+    int y;
+};
+
+TEST(PodList, MemberAccessThroughIterators)
+{
+    ccc::PodList<ListPoint, uint32_t, 10> c = ccc::PodList<ListPoint, uint32_t, 10>();
+    ListPoint Value = { 1, 2 };
+    c.push_front(Value);
+    c.begin()->y = 3;
+    const ccc::PodList<ListPoint, uint32_t, 10>& Const = c;
+    EXPECT_EQ(1, Const.begin()->x);
+    EXPECT_EQ(3, Const.begin()->y);
+}
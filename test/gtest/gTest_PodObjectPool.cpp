@@ -0,0 +1,217 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include <ccc/pod_object_pool.h>
+#include <ccc/fixed_object_pool.h>
+
+#include "gTest_Container.h"
+
+namespace
+{
+
+struct Order
+{
+    int m_Id;
+    int m_Owner;
+    double m_Price;
+};
+
+typedef ccc::PodObjectPool<Order, uint32_t, 100> OrderPool;
+
+}
+
+TEST(PodObjectPool, ZeroInitializedPoolIsEmpty)
+{
+    OrderPool* Pool = new OrderPool();
+    EXPECT_EQ(100u, Pool->max_size());
+    std::set<Order*> Allocated;
+    for (int i = 0; i < 100; ++i)
+    {
+        Order* Object = Pool->allocate();
+        EXPECT_EQ(static_cast<uint32_t>(i), Pool->slot(Object));
+        EXPECT_EQ(Object, Pool->address(Pool->slot(Object)));
+        Allocated.insert(Object);
+    }
+    EXPECT_EQ(100u, Allocated.size());
+    EXPECT_THROW(Pool->allocate(), std::bad_alloc);
+    delete Pool;
+}
+
+TEST(PodObjectPool, DeallocatedSlotsAreReused)
+{
+    OrderPool* Pool = new OrderPool();
+    std::vector<Order*> Objects;
+    for (int i = 0; i < 100; ++i)
+    {
+        Order Value = { i, 0, 0.5 * i };
+        Objects.push_back(Pool->create(Value));
+    }
+    Pool->destroy(Objects[10]);
+    Pool->deallocate(Objects[20]);
+    // last in, first out
+    EXPECT_EQ(Objects[20], Pool->allocate());
+    EXPECT_EQ(Objects[10], Pool->allocate());
+    EXPECT_THROW(Pool->allocate(), std::bad_alloc);
+    EXPECT_EQ(99, Objects[99]->m_Id);
+    delete Pool;
+}
+
+TEST(PodObjectPool, Slots)
+{
+    OrderPool* Pool = new OrderPool();
+    uint32_t Slots[150];
+    EXPECT_EQ(60u, Pool->allocate_slots(Slots, 60));
+    Pool->deallocate_slots(Slots + 10, 20);
+    EXPECT_EQ(60u, Pool->allocate_slots(Slots + 60, 90));
+    std::sort(Slots, Slots + 120);
+    EXPECT_EQ(Slots + 100, std::unique(Slots, Slots + 120));
+    EXPECT_EQ(0u, Pool->allocate_slots(Slots, 1));
+    delete Pool;
+}
+
+TEST(ObjectPoolCache, RefillsAndFlushesInBatches)
+{
+    OrderPool* Pool = new OrderPool();
+    std::vector<Order*> Objects;
+    {
+        ccc::ObjectPoolCache<OrderPool, 8> Cache(*Pool);
+        Objects.push_back(Cache.allocate());
+        EXPECT_EQ(3u, Cache.cached());
+        for (int i = 0; i < 95; ++i)
+        {
+            Objects.push_back(Cache.allocate());
+        }
+        EXPECT_EQ(0u, Cache.cached());
+        EXPECT_EQ(96u, Pool->m_Unused);
+        // the rest of the pool is taken by another cache
+        ccc::ObjectPoolCache<OrderPool, 8> Other(*Pool);
+        Objects.push_back(Other.allocate());
+        EXPECT_EQ(3u, Other.cached());
+        EXPECT_THROW(Cache.allocate(), std::bad_alloc);
+
+        for (std::size_t i = 0; i < 9; ++i)
+        {
+            Cache.deallocate(Objects[i]);
+        }
+        EXPECT_EQ(5u, Cache.cached());
+        Order Value = { 7, 0, 0.0 };
+        Order* Object = Other.create(Value);
+        EXPECT_EQ(7, Object->m_Id);
+        Cache.destroy(Object);
+    }
+    // the destructors returned all cached slots
+    uint32_t Slots[100];
+    EXPECT_EQ(100u - 97u + 9u, Pool->allocate_slots(Slots, 100));
+    delete Pool;
+}
+
+TEST(FixedObjectPool, Allocate)
+{
+    ccc::FixedObjectPool<Order> Pool(3);
+    EXPECT_EQ(3u, Pool.max_size());
+    Order* First = Pool.allocate();
+    Pool.allocate();
+    Pool.allocate();
+    EXPECT_THROW(Pool.allocate(), std::bad_alloc);
+    Pool.deallocate(First);
+    EXPECT_EQ(First, Pool.allocate());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <pthread.h>
+
+namespace
+{
+
+typedef ccc::PodObjectPool<Order, uint32_t, 1000> SharedOrderPool;
+
+struct Worker
+{
+    SharedOrderPool* m_Pool;
+    int m_Id;
+    int m_Corrupted;
+};
+
+/**
+ * Allocates batches of orders, stamps them and checks that no other thread wrote to them before
+ * freeing them again; half of the batches through a cache and half directly.
+ */
+static void* AllocateAndFree(void* Argument)
+{
+    Worker& W = *static_cast<Worker*>(Argument);
+    ccc::ObjectPoolCache<SharedOrderPool> Cache(*W.m_Pool);
+    std::vector<Order*> Orders;
+    for (int Round = 0; Round < 2000; ++Round)
+    {
+        const bool Cached = (0 == Round % 2);
+        for (int i = 0; i < 50; ++i)
+        {
+            Order* Object = Cached ? Cache.allocate() : W.m_Pool->allocate();
+            Object->m_Id = Round * 100 + i;
+            Object->m_Owner = W.m_Id;
+            Orders.push_back(Object);
+        }
+        for (int i = 0; i < 50; ++i)
+        {
+            if ((Orders[i]->m_Id != Round * 100 + i) or (Orders[i]->m_Owner != W.m_Id))
+            {
+                ++W.m_Corrupted;
+            }
+            if (Cached)
+            {
+                Cache.deallocate(Orders[i]);
+            }
+            else
+            {
+                W.m_Pool->deallocate(Orders[i]);
+            }
+        }
+        Orders.clear();
+    }
+    return 0;
+}
+
+}
+
+TEST(PodObjectPool, ConcurrentAllocateAndFree)
+{
+    SharedOrderPool* Pool = new SharedOrderPool();
+    pthread_t Threads[4];
+    Worker Workers[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        Worker W = { Pool, i, 0 };
+        Workers[i] = W;
+        ASSERT_EQ(0, pthread_create(&Threads[i], 0, AllocateAndFree, &Workers[i]));
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        pthread_join(Threads[i], 0);
+        EXPECT_EQ(0, Workers[i].m_Corrupted);
+    }
+    // all slots are free again and none is handed out twice
+    std::vector<uint32_t> Slots(1001);
+    ASSERT_EQ(1000u, Pool->allocate_slots(&Slots[0], 1001));
+    Slots.pop_back();
+    std::sort(Slots.begin(), Slots.end());
+    EXPECT_TRUE(Slots.end() == std::unique(Slots.begin(), Slots.end()));
+    delete Pool;
+}
+
+#endif
@@ -0,0 +1,199 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <set>
+#include <vector>
+
+#include <ccc/pod_priority_queue.h>
+
+#include "gTest_Container.h"
+
+#if (__cplusplus >= 201103L)
+#include <type_traits>
+#endif
+
+typedef ccc::PodPriorityQueue<int, uint16_t, 200> BinaryHeap;
+typedef ccc::PodPriorityQueue<int, uint16_t, 200, std::greater<int>, 4> QuaternaryMinHeap;
+typedef ccc::PodPriorityQueue<int, uint16_t, 200, std::less<int>, 8> OctonaryHeap;
+typedef ccc::PodIndexedPriorityQueue<int, uint16_t, 200, std::greater<int>, 4> IndexedMinHeap;
+
+#if (__cplusplus >= 201103L)
+TEST(PodPriorityQueue, TypeTraits_Cpp11)
+{
+    EXPECT_TRUE(std::is_pod<BinaryHeap>::value);
+    EXPECT_TRUE(std::is_pod<IndexedMinHeap>::value);
+}
+#endif
+
+template <typename TQueue>
+class PodPriorityQueueTest : public ::testing::Test
+{
+};
+
+typedef ::testing::Types<BinaryHeap, QuaternaryMinHeap, OctonaryHeap> QueueImplementations;
+TYPED_TEST_CASE(PodPriorityQueueTest, QueueImplementations);
+
+TYPED_TEST(PodPriorityQueueTest, PushPop)
+{
+    typedef typename TypeParam::value_compare Compare;
+    TypeParam q = TypeParam();
+    std::priority_queue<int, std::vector<int>, Compare> Expected;
+    std::srand(3);
+    for (int i = 0; i < 1000; ++i)
+    {
+        if ((q.size() < q.max_size()) and (q.empty() or (std::rand() % 3 != 0)))
+        {
+            int Value = std::rand() % 100;
+            q.push(Value);
+            Expected.push(Value);
+        }
+        else
+        {
+            q.pop();
+            Expected.pop();
+        }
+        ASSERT_EQ(Expected.size(), q.size());
+        if (not q.empty())
+        {
+            ASSERT_EQ(Expected.top(), q.top());
+        }
+    }
+    // pushing an element of the queue itself
+    q.pop();
+    Expected.pop();
+    q.push(q.top());
+    Expected.push(Expected.top());
+    EXPECT_EQ(Expected.top(), q.top());
+    EXPECT_EQ(Expected.size(), q.size());
+}
+
+TYPED_TEST(PodPriorityQueueTest, ReplaceTop)
+{
+    typedef typename TypeParam::value_compare Compare;
+    TypeParam q = TypeParam();
+    std::priority_queue<int, std::vector<int>, Compare> Expected;
+    for (int i = 0; i < 50; ++i)
+    {
+        q.push(i * 7 % 50);
+        Expected.push(i * 7 % 50);
+    }
+    for (int i = 0; i < 200; ++i)
+    {
+        int Value = std::rand() % 100;
+        q.replace_top(Value);
+        Expected.pop();
+        Expected.push(Value);
+        ASSERT_EQ(Expected.top(), q.top());
+    }
+}
+
+TYPED_TEST(PodPriorityQueueTest, Heapify)
+{
+    typedef typename TypeParam::value_compare Compare;
+    std::vector<int> Values;
+    for (int i = 0; i < 150; ++i)
+    {
+        Values.push_back(std::rand() % 1000);
+    }
+    TypeParam q = TypeParam();
+    q.push(-1);
+    q.heapify(Values.begin(), Values.end());
+    std::priority_queue<int, std::vector<int>, Compare> Expected(Values.begin(), Values.end());
+    ASSERT_EQ(Expected.size(), q.size());
+    while (not q.empty())
+    {
+        ASSERT_EQ(Expected.top(), q.top());
+        q.pop();
+        Expected.pop();
+    }
+    Values.resize(201);
+    EXPECT_THROW(q.heapify(Values.begin(), Values.end()), std::bad_alloc);
+}
+
+TEST(PodPriorityQueue, Capacity)
+{
+    BinaryHeap q = BinaryHeap();
+    for (int i = 0; i < 200; ++i)
+    {
+        q.push(i);
+    }
+    EXPECT_THROW(q.push(0), std::bad_alloc);
+    q.clear();
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(PodIndexedPriorityQueue, UpdateAndErase)
+{
+    typedef IndexedMinHeap::handle_type Handle;
+    IndexedMinHeap q = IndexedMinHeap();
+    std::multiset<int> Expected;
+    std::vector<Handle> Handles;
+    std::vector<int> Values;
+    std::srand(5);
+    for (int i = 0; i < 150; ++i)
+    {
+        Values.push_back(std::rand() % 1000);
+        Handles.push_back(q.push(Values.back()));
+        Expected.insert(Values.back());
+    }
+    for (int i = 0; i < 150; ++i)
+    {
+        ASSERT_TRUE(q.contains(Handles[i]));
+        ASSERT_EQ(Values[i], q[Handles[i]]);
+    }
+    // decrease and increase keys
+    for (int i = 0; i < 150; i += 2)
+    {
+        int Value = std::rand() % 1000;
+        Expected.erase(Expected.find(Values[i]));
+        Expected.insert(Value);
+        Values[i] = Value;
+        q.update(Handles[i], Value);
+        ASSERT_EQ(*Expected.begin(), q.top());
+    }
+    for (int i = 1; i < 150; i += 3)
+    {
+        Expected.erase(Expected.find(Values[i]));
+        EXPECT_TRUE(q.erase(Handles[i]));
+        EXPECT_FALSE(q.erase(Handles[i]));
+        EXPECT_THROW(q.at(Handles[i]), std::out_of_range);
+    }
+    ASSERT_EQ(Expected.size(), q.size());
+    while (not q.empty())
+    {
+        Handle Top = q.top_handle();
+        ASSERT_EQ(*Expected.begin(), q.top());
+        ASSERT_EQ(q.top(), q.at(Top));
+        Expected.erase(Expected.begin());
+        q.pop();
+        EXPECT_FALSE(q.contains(Top));
+    }
+}
+
+TEST(PodIndexedPriorityQueue, RecyclesHandles)
+{
+    IndexedMinHeap q = IndexedMinHeap();
+    for (int i = 0; i < 200; ++i)
+    {
+        q.push(i);
+    }
+    EXPECT_THROW(q.push(0), std::bad_alloc);
+    q.pop();
+    EXPECT_EQ(0, q.push(-5));
+    EXPECT_EQ(0, q.top_handle());
+    EXPECT_EQ(-5, q.top());
+}
@@ -0,0 +1,168 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include <ccc/pod_slot_map.h>
+#include <ccc/fixed_slot_map.h>
+
+#include "gTest_Container.h"
+
+#if (__cplusplus >= 201103L)
+#include <type_traits>
+#endif
+
+typedef ccc::PodSlotMap<int, uint16_t, 10> ContainerOfInts;
+typedef ccc::PodSlotMap<tPOD, uint16_t, 10> ContainerOfPODs;
+
+#if (__cplusplus >= 201103L)
+TEST(PodSlotMap, TypeTraits_Cpp11)
+{
+    EXPECT_TRUE(std::is_pod<ContainerOfInts>::value);
+    EXPECT_TRUE(std::is_pod<ContainerOfPODs>::value);
+}
+#endif
+
+template<> uint64_t TestOfStaticContainer<ContainerOfInts>::m_Capacity = 10;
+template<> uint64_t TestOfStaticContainer<ContainerOfPODs>::m_Capacity = 10;
+
+typedef ::testing::Types<ContainerOfInts, ContainerOfPODs> ContainerImplementations;
+INSTANTIATE_TYPED_TEST_CASE_P(PodSlotMap, TestOfContainer, ContainerImplementations);
+INSTANTIATE_TYPED_TEST_CASE_P(PodSlotMap, TestOfPODContainer, ContainerImplementations);
+INSTANTIATE_TYPED_TEST_CASE_P(PodSlotMap, TestOfStaticContainer, ContainerImplementations);
+
+TEST(PodSlotMap, InsertErase)
+{
+    typedef ContainerOfInts::handle_type Handle;
+    ContainerOfInts c = ContainerOfInts();
+    Handle h1 = c.insert(1);
+    Handle h2 = c.insert(2);
+    Handle h3 = c.insert(3);
+    EXPECT_EQ(3, c.size());
+    EXPECT_EQ(2, c[h2]);
+    EXPECT_TRUE(c.erase(h1));
+    EXPECT_FALSE(c.erase(h1));
+    EXPECT_FALSE(c.contains(h1));
+    EXPECT_EQ(c.end(), c.find(h1));
+    EXPECT_THROW(c.at(h1), std::out_of_range);
+    EXPECT_EQ(2, c.at(h2));
+    EXPECT_EQ(3, c.at(h3));
+    // the slot of h1 is reused, but h1 stays stale
+    Handle h4 = c.insert(4);
+    EXPECT_EQ(h1.m_Slot, h4.m_Slot);
+    EXPECT_NE(h1, h4);
+    EXPECT_FALSE(c.contains(h1));
+    EXPECT_EQ(4, c[h4]);
+    // the values are packed densely
+    int Sum = 0;
+    for (ContainerOfInts::const_iterator it = c.begin(); it != c.end(); ++it)
+    {
+        Sum += *it;
+        EXPECT_EQ(*it, c[c.handle(it)]);
+    }
+    EXPECT_EQ(9, Sum);
+}
+
+TEST(PodSlotMap, Capacity)
+{
+    ContainerOfInts c = ContainerOfInts();
+    for (int i = 0; i < 10; ++i)
+    {
+        c.insert(i);
+    }
+    EXPECT_THROW(c.insert(10), std::bad_alloc);
+    ContainerOfInts::handle_type h = c.handle(c.begin());
+    c.clear();
+    EXPECT_TRUE(c.empty());
+    EXPECT_FALSE(c.contains(h));
+    EXPECT_NE(h, c.insert(0));
+}
+
+TEST(PodSlotMap, EraseWhileIterating)
+{
+    ContainerOfInts c = ContainerOfInts();
+    for (int i = 0; i < 10; ++i)
+    {
+        c.insert(i);
+    }
+    for (ContainerOfInts::iterator it = c.begin(); it != c.end();)
+    {
+        if (*it % 2)
+        {
+            it = c.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    EXPECT_EQ(5, c.size());
+    for (ContainerOfInts::iterator it = c.begin(); it != c.end(); ++it)
+    {
+        EXPECT_EQ(0, *it % 2);
+        EXPECT_EQ(*it, c[c.handle(it)]);
+    }
+}
+
+template <typename ContainerType>
+void CompareWithReference(ContainerType& c)
+{
+    typedef typename ContainerType::handle_type Handle;
+    std::vector<std::pair<Handle, int> > Reference;
+    std::vector<Handle> Erased;
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (Reference.empty() or ((std::rand() % 2) and (c.size() < c.max_size())))
+        {
+            int Value = std::rand();
+            Reference.push_back(std::make_pair(c.insert(Value), Value));
+        }
+        else
+        {
+            std::size_t Erase = static_cast<std::size_t>(std::rand()) % Reference.size();
+            EXPECT_TRUE(c.erase(Reference[Erase].first));
+            Erased.push_back(Reference[Erase].first);
+            Reference.erase(Reference.begin() + Erase);
+        }
+        ASSERT_EQ(Reference.size(), c.size());
+    }
+    for (std::size_t i = 0; i < Reference.size(); ++i)
+    {
+        EXPECT_EQ(Reference[i].second, c.at(Reference[i].first));
+    }
+    for (std::size_t i = 0; i < Erased.size(); ++i)
+    {
+        EXPECT_FALSE(c.contains(Erased[i]));
+    }
+}
+
+TEST(PodSlotMap, CompareWithReference)
+{
+    ccc::PodSlotMap<int, uint32_t, 64> c = ccc::PodSlotMap<int, uint32_t, 64>();
+    CompareWithReference(c);
+}
+
+TEST(FixedSlotMap, CompareWithReference)
+{
+    ccc::FixedSlotMap<int, uint32_t> c(64);
+    CompareWithReference(c);
+    ccc::FixedSlotMap<int, uint32_t> d(c);
+    EXPECT_EQ(c.size(), d.size());
+    for (ccc::FixedSlotMap<int, uint32_t>::iterator it = c.begin(); it != c.end(); ++it)
+    {
+        EXPECT_EQ(*it, d.at(c.handle(it)));
+    }
+}
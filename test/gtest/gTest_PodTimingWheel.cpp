@@ -0,0 +1,167 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#include <cstdlib>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include <ccc/pod_timing_wheel.h>
+#include <ccc/fixed_timing_wheel.h>
+
+#include "gTest_Container.h"
+
+#if (__cplusplus >= 201103L)
+#include <type_traits>
+#endif
+
+typedef ccc::PodTimingWheel<int, uint16_t, 500> DefaultWheel;
+// 3 levels of 4 slots cover 64 ticks, so the test exercises cascading and out-of-range deadlines
+typedef ccc::PodTimingWheel<int, uint16_t, 500, unsigned long, 2, 3> SmallWheel;
+
+#if (__cplusplus >= 201103L)
+TEST(PodTimingWheel, TypeTraits_Cpp11)
+{
+    EXPECT_TRUE(std::is_pod<DefaultWheel>::value);
+    EXPECT_TRUE(std::is_pod<SmallWheel>::value);
+}
+#endif
+
+template <typename TWheel>
+void RunRandomSchedule(TWheel& Wheel, unsigned long MaxDelay, unsigned long MaxStep)
+{
+    typedef typename TWheel::handle_type Handle;
+    std::map<int, unsigned long> Pending; // value -> deadline
+    std::map<int, Handle> Handles;
+    std::srand(17);
+    int NextValue = 0;
+    for (int Round = 0; Round < 2000; ++Round)
+    {
+        int Action = std::rand() % 4;
+        if ((Action < 2) and (Wheel.size() < Wheel.max_size()))
+        {
+            unsigned long Deadline = Wheel.now() + std::rand() % MaxDelay;
+            Handles[NextValue] = Wheel.schedule(Deadline, NextValue);
+            Pending[NextValue] = Deadline;
+            ++NextValue;
+        }
+        else if ((Action == 2) and not Pending.empty())
+        {
+            typename std::map<int, unsigned long>::iterator Cancelled = Pending.begin();
+            std::advance(Cancelled, std::rand() % Pending.size());
+            ASSERT_TRUE(Wheel.cancel(Handles[Cancelled->first]));
+            ASSERT_FALSE(Wheel.cancel(Handles[Cancelled->first]));
+            Pending.erase(Cancelled);
+        }
+        else
+        {
+            unsigned long Now = Wheel.now() + std::rand() % MaxStep;
+            std::vector<int> Expired;
+            while (Wheel.advance(Now, std::back_inserter(Expired), 3) == 3)
+            {
+            }
+            ASSERT_EQ(Now, Wheel.now());
+            std::vector<int> Expected;
+            for (typename std::map<int, unsigned long>::iterator it = Pending.begin(); it != Pending.end();)
+            {
+                if (it->second <= Now)
+                {
+                    Expected.push_back(it->first);
+                    Pending.erase(it++);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            std::sort(Expired.begin(), Expired.end());
+            ASSERT_EQ(Expected, Expired) << "at tick " << Now;
+            for (std::size_t i = 0; i < Expired.size(); ++i)
+            {
+                ASSERT_FALSE(Wheel.contains(Handles[Expired[i]]));
+            }
+        }
+        ASSERT_EQ(Pending.size(), Wheel.size());
+    }
+}
+
+TEST(PodTimingWheel, RandomScheduleNearDeadlines)
+{
+    std::vector<SmallWheel> Storage(1);
+    RunRandomSchedule(Storage.front(), 60, 8);
+}
+
+TEST(PodTimingWheel, RandomScheduleBeyondRange)
+{
+    std::vector<SmallWheel> Storage(1);
+    RunRandomSchedule(Storage.front(), 1000, 100);
+}
+
+TEST(PodTimingWheel, RandomScheduleDefaultWheel)
+{
+    std::vector<DefaultWheel> Storage(1);
+    RunRandomSchedule(Storage.front(), 100000, 3000);
+}
+
+TEST(PodTimingWheel, HandlesAndPastDeadlines)
+{
+    SmallWheel w = SmallWheel();
+    std::vector<int> Expired;
+    EXPECT_EQ(0, w.advance(100, std::back_inserter(Expired), 10));
+    EXPECT_EQ(100, w.now());
+    SmallWheel::handle_type Past = w.schedule(50, 1);
+    SmallWheel::handle_type Future = w.schedule(5000, 2);
+    EXPECT_EQ(100, w.deadline(Past));
+    EXPECT_EQ(5000, w.deadline(Future));
+    EXPECT_EQ(2, w.at(Future));
+    w[Future] = 3;
+    EXPECT_EQ(1, w.advance(100, std::back_inserter(Expired), 10));
+    EXPECT_EQ(1, Expired.back());
+    EXPECT_FALSE(w.contains(Past));
+    EXPECT_THROW(w.at(Past), std::out_of_range);
+    EXPECT_EQ(0, w.advance(4999, std::back_inserter(Expired), 10));
+    EXPECT_EQ(1, w.advance(5000, std::back_inserter(Expired), 10));
+    EXPECT_EQ(3, Expired.back());
+    EXPECT_TRUE(w.empty());
+}
+
+TEST(PodTimingWheel, Clear)
+{
+    SmallWheel w = SmallWheel();
+    std::vector<SmallWheel::handle_type> Handles;
+    for (int i = 0; i < 500; ++i)
+    {
+        Handles.push_back(w.schedule(i, i));
+    }
+    EXPECT_THROW(w.schedule(0, 0), std::bad_alloc);
+    w.clear();
+    EXPECT_TRUE(w.empty());
+    for (int i = 0; i < 500; ++i)
+    {
+        EXPECT_FALSE(w.contains(Handles[i]));
+    }
+    std::vector<int> Expired;
+    EXPECT_EQ(0, w.advance(1000, std::back_inserter(Expired), 1000));
+    w.schedule(1001, 7);
+    EXPECT_EQ(1, w.advance(2000, std::back_inserter(Expired), 1000));
+}
+
+TEST(PodTimingWheel, FixedTimingWheel)
+{
+    ccc::FixedTimingWheel<int, unsigned int, unsigned long, 4, 4> w(1000, 42);
+    EXPECT_EQ(1000, w.max_size());
+    EXPECT_EQ(42, w.now());
+    RunRandomSchedule(w, 5000, 200);
+}
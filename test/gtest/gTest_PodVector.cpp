@@ -113,6 +113,17 @@ typedef ccc::PodVector<ccc_test::Pod<4, 1>, uint8_t, 2, 1> PodVector_4_1_1_2_1;
 typedef ccc::PodVector<ccc_test::Pod<8, 1>, uint8_t, 2, 1> PodVector_8_1_1_2_1;
 typedef ccc::PodVector<ccc_test::Pod<16, 1>, uint8_t, 2, 1> PodVector_16_1_1_2_1;
 
+TEST(PodVector, NoStatisticsByDefault)
+{
+    ccc::PodVector<int, uint8_t, 4> v = ccc::PodVector<int, uint8_t, 4>();
+    v.push_back(1);
+    v.clear();
+    EXPECT_EQ(0, CCC_CONTAINER_STATS);
+#ifdef CCC_ATOMIC_H_
+    ADD_FAILURE() << "the statistics hooks pulled in ccc/atomic.h although they are off";
+#endif
+}
+
 TEST(PodVector, ConsistentSize)
 {
     EXPECT_EQ(3, sizeof(PodVector_1_1_1_2_1));
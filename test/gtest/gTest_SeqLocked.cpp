@@ -0,0 +1,267 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <sstream>
+#include <string>
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <ccc/seq_locked.h>
+#include <ccc/shm.h>
+#include <ccc/static_vector.h>
+
+#include "gTest_Container.h"
+
+namespace
+{
+
+struct Quote
+{
+    int m_Price;
+    int m_Volume;
+};
+
+typedef ccc::StaticVector<Quote, uint8_t, 32> Quotes;
+typedef ccc::SeqLocked<Quotes> LockedQuotes;
+
+/**
+ * Keeps the invariant that quote i has price Generation + i and volume 2 * (Generation + i).
+ */
+struct Requote
+{
+    int m_Generation;
+    uint8_t m_Size;
+
+    Requote(int Generation, uint8_t Size)
+            : m_Generation(Generation), m_Size(Size)
+    {
+    }
+
+    void operator()(Quotes& Values) const
+    {
+        Values.clear();
+        for (uint8_t i = 0; i < m_Size; ++i)
+        {
+            Quote Value = { m_Generation + i, 2 * (m_Generation + i) };
+            Values.push_back(Value);
+        }
+    }
+};
+
+static bool IsConsistent(const Quotes& Values)
+{
+    for (uint8_t i = 0; i < Values.size(); ++i)
+    {
+        if ((Values[i].m_Price != Values[0].m_Price + i) || (Values[i].m_Volume != 2 * Values[i].m_Price))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct CountQuotes
+{
+    int* m_Count;
+
+    void operator()(const Quotes& Values) const
+    {
+        *m_Count = Values.size();
+    }
+};
+
+}
+
+TEST(SeqLocked, WritesAreVisibleToReaders)
+{
+    LockedQuotes Locked;
+    EXPECT_EQ(0u, Locked.sequence());
+    EXPECT_EQ(32u, Locked.max_size());
+
+    Locked.write(Requote(10, 5));
+    EXPECT_EQ(2u, Locked.sequence());
+
+    const Quotes Copy = Locked.read_copy();
+    ASSERT_EQ(5u, Copy.size());
+    EXPECT_EQ(10, Copy[0].m_Price);
+    EXPECT_EQ(28, Copy[4].m_Volume);
+    EXPECT_TRUE(IsConsistent(Copy));
+
+    int Count = 0;
+    CountQuotes Reader = { &Count };
+    Locked.read(Reader);
+    EXPECT_EQ(5, Count);
+}
+
+TEST(SeqLocked, SequenceIsOnItsOwnCacheLine)
+{
+    EXPECT_LE(64u + sizeof(Quotes), sizeof(LockedQuotes));
+}
+
+namespace
+{
+
+struct SharedState
+{
+    LockedQuotes m_Locked;
+    volatile int m_Stop;
+    volatile int m_Violations;
+    volatile int m_Reads;
+};
+
+static void* ReadContinuously(void* Argument)
+{
+    SharedState& State = *static_cast<SharedState*>(Argument);
+    Quotes Copy;
+    while (0 == ccc::atomic_load(State.m_Stop))
+    {
+        State.m_Locked.read_copy(Copy);
+        if (!IsConsistent(Copy))
+        {
+            ccc::atomic_fetch_add(State.m_Violations, 1);
+        }
+        ccc::atomic_fetch_add(State.m_Reads, 1);
+    }
+    return 0;
+}
+
+}
+
+TEST(SeqLocked, ReadersNeverSeePartialWrites)
+{
+    SharedState* State = new SharedState();
+    State->m_Stop = 0;
+    State->m_Violations = 0;
+    State->m_Reads = 0;
+    State->m_Locked.write(Requote(0, 32));
+
+    pthread_t Readers[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(0, pthread_create(&Readers[i], 0, ReadContinuously, State));
+    }
+    for (int Generation = 1; Generation <= 20000; ++Generation)
+    {
+        State->m_Locked.write(Requote(Generation * 7, static_cast<uint8_t>(1 + Generation % 32)));
+    }
+    for (unsigned int Iteration = 0; ccc::atomic_load(State->m_Reads) < 100; ++Iteration)
+    {
+        ccc::spin_wait(Iteration);
+    }
+    ccc::atomic_store(State->m_Stop, 1);
+    for (int i = 0; i < 3; ++i)
+    {
+        pthread_join(Readers[i], 0);
+    }
+    EXPECT_EQ(0, State->m_Violations);
+    EXPECT_EQ(2u * 20001u, State->m_Locked.sequence());
+    delete State;
+}
+
+namespace
+{
+
+typedef ccc::StaticVector<uint64_t, uint8_t, 16> Pair;
+
+struct SharedPair
+{
+    ccc::SeqLocked<Pair> m_Locked;
+    volatile int m_Stop;
+    volatile int m_Torn;
+    volatile int m_Reads;
+};
+
+/**
+ * The writer keeps the first and the last element equal; a copy that was not completed before the
+ * sequence was checked again would combine the elements of different writes.
+ */
+struct WritePair
+{
+    uint64_t m_Value;
+
+    void operator()(Pair& Values) const
+    {
+        Values.resize(Values.max_size(), 0);
+        Values.front() = m_Value;
+        Values.back() = m_Value;
+    }
+};
+
+static void* ReadPairs(void* Argument)
+{
+    SharedPair& State = *static_cast<SharedPair*>(Argument);
+    Pair Copy;
+    while (0 == ccc::atomic_load(State.m_Stop))
+    {
+        State.m_Locked.read_copy(Copy);
+        if (Copy.front() != Copy.back())
+        {
+            ccc::atomic_fetch_add(State.m_Torn, 1);
+        }
+        ccc::atomic_fetch_add(State.m_Reads, 1);
+    }
+    return 0;
+}
+
+}
+
+TEST(SeqLocked, CopyCompletesBeforeTheRecheck)
+{
+    SharedPair* State = new SharedPair();
+    State->m_Stop = 0;
+    State->m_Torn = 0;
+    State->m_Reads = 0;
+    WritePair First = { 0 };
+    State->m_Locked.write(First);
+
+    pthread_t Readers[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(0, pthread_create(&Readers[i], 0, ReadPairs, State));
+    }
+    for (uint64_t Value = 1; (Value <= 200000) or (ccc::atomic_load(State->m_Reads) < 1000); ++Value)
+    {
+        WritePair Write = { Value };
+        State->m_Locked.write(Write);
+    }
+    ccc::atomic_store(State->m_Stop, 1);
+    for (int i = 0; i < 3; ++i)
+    {
+        pthread_join(Readers[i], 0);
+    }
+    EXPECT_EQ(0, State->m_Torn);
+    delete State;
+}
+
+TEST(SeqLocked, WorksInSharedMemory)
+{
+    std::ostringstream Name;
+    Name << "/ccctl_gtest_" << ::getpid() << "_seqlocked";
+    {
+        ccc::SharedContainer<LockedQuotes> Writer(Name.str(), ccc::SharedMemoryMode::Create);
+        Writer->write(Requote(3, 7));
+
+        ccc::SharedContainer<LockedQuotes> Reader(Name.str(), ccc::SharedMemoryMode::Attach);
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(Reader.get()) % 64);
+        const Quotes Copy = Reader->read_copy();
+        ASSERT_EQ(7u, Copy.size());
+        EXPECT_EQ(9, Copy[6].m_Price);
+    }
+    EXPECT_TRUE(ccc::SharedContainer<LockedQuotes>::remove(Name.str()));
+}
+
+#endif
@@ -0,0 +1,180 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <ccc/serialization.h>
+#include <ccc/static_vector.h>
+#include <ccc/static_deque.h>
+#include <ccc/static_list.h>
+#include <ccc/fixed_vector.h>
+#include <ccc/fixed_deque.h>
+#include <ccc/fixed_list.h>
+
+#include "gTest_Container.h"
+
+template <class Container>
+std::vector<char> Serialize(const Container& C)
+{
+    std::vector<char> Buffer(ccc::serialized_size(C));
+    EXPECT_EQ(&Buffer[0] + Buffer.size(), ccc::serialize(C, &Buffer[0]));
+    return Buffer;
+}
+
+TEST(Serialization, VectorWritesOnlyLiveElements)
+{
+    typedef ccc::StaticVector<int, uint32_t, 100000> Vector;
+    Vector* Source = new Vector();
+    for (int i = 0; i < 10; ++i)
+    {
+        Source->push_back(i * 3);
+    }
+    std::vector<char> Buffer = Serialize(*Source);
+    EXPECT_EQ(sizeof(ccc::SerializationHeader) + 10 * sizeof(int), Buffer.size());
+
+    Vector* Target = new Vector();
+    Target->push_back(42);
+    EXPECT_EQ(&Buffer[0] + Buffer.size(), ccc::deserialize(*Target, &Buffer[0], &Buffer[0] + Buffer.size()));
+    EXPECT_EQ(std::vector<int>(Source->begin(), Source->end()), std::vector<int>(Target->begin(), Target->end()));
+    delete Source;
+    delete Target;
+}
+
+TEST(Serialization, DequeWritesBothSegmentsInOrder)
+{
+    ccc::StaticDeque<tPOD, uint16_t, 8> Source;
+    for (int i = 0; i < 6; ++i)
+    {
+        tPOD Value = { i, i * 0.5 };
+        Source.push_back(Value);
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        Source.pop_front();
+    }
+    for (int i = 6; i < 11; ++i)
+    {
+        tPOD Value = { i, i * 0.5 };
+        Source.push_back(Value); // wraps around
+    }
+    ASSERT_EQ(7, Source.size());
+
+    std::vector<char> Buffer = Serialize(Source);
+    EXPECT_EQ(sizeof(ccc::SerializationHeader) + 7 * sizeof(tPOD), Buffer.size());
+    ccc::FixedDeque<tPOD, unsigned int> Target(8);
+    ccc::deserialize(Target, &Buffer[0], &Buffer[0] + Buffer.size());
+    ASSERT_EQ(7, Target.size());
+    for (int i = 0; i < 7; ++i)
+    {
+        EXPECT_EQ(i + 4, Target[i].x);
+        EXPECT_EQ((i + 4) * 0.5, Target[i].y);
+    }
+    Target.push_front(Target.back()); // the deserialized deque is fully usable
+    EXPECT_EQ(10, Target.front().x);
+}
+
+TEST(Serialization, ListIsWrittenInListOrderAndRebuiltContiguously)
+{
+    ccc::StaticList<int, uint32_t, 20> Source;
+    for (int i = 0; i < 10; ++i)
+    {
+        Source.push_back(i);
+    }
+    Source.pop_front();
+    Source.pop_front();
+    Source.push_front(-1);
+    Source.push_back(10);
+    std::vector<int> Expected(Source.begin(), Source.end());
+
+    ccc::SerializationHeader Header;
+    struct iovec Iovecs[8];
+    EXPECT_EQ(3, ccc::serialize_iovec(Source, Header, Iovecs, 8)); // header, -1 reusing node 2 followed by 2..9, 10
+
+    std::vector<char> Buffer = Serialize(Source);
+    ccc::FixedList<int, unsigned int> Target(20);
+    Target.push_back(7);
+    ccc::deserialize(Target, &Buffer[0], &Buffer[0] + Buffer.size());
+    EXPECT_EQ(Expected, std::vector<int>(Target.begin(), Target.end()));
+    EXPECT_EQ(2, ccc::serialize_iovec(Target, Header, Iovecs, 8));
+
+    Target.pop_back();
+    Target.push_front(-2);
+    Expected.pop_back();
+    Expected.insert(Expected.begin(), -2);
+    EXPECT_EQ(Expected, std::vector<int>(Target.begin(), Target.end()));
+}
+
+TEST(Serialization, IovecsCanBeSentWithWritev)
+{
+    int Sockets[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, Sockets));
+
+    ccc::StaticDeque<int, uint32_t, 16> Source;
+    for (int i = 0; i < 12; ++i)
+    {
+        Source.push_back(i);
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+        Source.pop_front();
+        Source.push_back(12 + i);
+    }
+    ccc::SerializationHeader Header;
+    struct iovec Iovecs[3];
+    EXPECT_EQ(3, ccc::serialize_iovec(Source, Header, Iovecs, 1)); // counts beyond the size of Out
+    const std::size_t Count = ccc::serialize_iovec(Source, Header, Iovecs, 3);
+    ASSERT_EQ(3, Count);
+    const ssize_t Size = static_cast<ssize_t>(ccc::serialized_size(Source));
+    ASSERT_EQ(Size, ::writev(Sockets[0], Iovecs, static_cast<int>(Count)));
+
+    std::vector<char> Buffer(static_cast<std::size_t>(Size));
+    ASSERT_EQ(Size, ::read(Sockets[1], &Buffer[0], Buffer.size()));
+    ccc::FixedVector<int, unsigned int> Target(16);
+    ccc::deserialize(Target, &Buffer[0], &Buffer[0] + Buffer.size());
+    ASSERT_EQ(12, Target.size());
+    for (int i = 0; i < 12; ++i)
+    {
+        EXPECT_EQ(i + 10, Target[i]);
+    }
+    ::close(Sockets[0]);
+    ::close(Sockets[1]);
+}
+
+TEST(Serialization, RejectsInvalidInput)
+{
+    ccc::StaticVector<int, uint32_t, 10> Source;
+    for (int i = 0; i < 10; ++i)
+    {
+        Source.push_back(i);
+    }
+    std::vector<char> Buffer = Serialize(Source);
+
+    ccc::StaticVector<int, uint32_t, 9> Smaller;
+    EXPECT_THROW(ccc::deserialize(Smaller, &Buffer[0], &Buffer[0] + Buffer.size()), std::bad_alloc);
+    ccc::StaticVector<int, uint32_t, 10> Target;
+    EXPECT_THROW(ccc::deserialize(Target, &Buffer[0], &Buffer[0] + Buffer.size() - 1), std::runtime_error);
+    EXPECT_THROW(ccc::deserialize(Target, &Buffer[0], &Buffer[0] + 4), std::runtime_error);
+    ccc::StaticVector<short, uint32_t, 10> OtherValues;
+    EXPECT_THROW(ccc::deserialize(OtherValues, &Buffer[0], &Buffer[0] + Buffer.size()), std::runtime_error);
+    EXPECT_NO_THROW(ccc::deserialize(Target, &Buffer[0], &Buffer[0] + Buffer.size()));
+    EXPECT_EQ(std::vector<int>(Source.begin(), Source.end()), std::vector<int>(Target.begin(), Target.end()));
+}
+
+#endif
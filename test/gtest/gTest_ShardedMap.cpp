@@ -0,0 +1,195 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <vector>
+
+#include <pthread.h>
+
+#include <ccc/sharded_map.h>
+
+#include "gTest_Container.h"
+
+typedef ccc::PodHashMap<int, int, uint32_t, 512> Shard;
+typedef ccc::ShardedMap<Shard, 8> Map;
+
+/**
+ * Cleared map with static storage, which keeps the shards 64 byte aligned.
+ */
+static Map& SharedMap()
+{
+    static Map Instance;
+    Instance.clear();
+    return Instance;
+}
+
+TEST(ShardedMap, SingleElements)
+{
+    Map* c = &SharedMap();
+    EXPECT_EQ(0u, c->size());
+    Map::value_type Value = { 5, 50 };
+    EXPECT_TRUE(c->insert(Value));
+    Value.second = 51;
+    EXPECT_FALSE(c->insert(Value));
+    int Found = 0;
+    EXPECT_TRUE(c->find(5, Found));
+    EXPECT_EQ(50, Found);
+    EXPECT_FALSE(c->insert_or_assign(Value));
+    EXPECT_TRUE(c->find(5, Found));
+    EXPECT_EQ(51, Found);
+    EXPECT_FALSE(c->find(6, Found));
+    EXPECT_EQ(1u, c->size());
+    EXPECT_EQ(1, c->erase(5));
+    EXPECT_EQ(0, c->erase(5));
+    EXPECT_EQ(0u, c->size());
+}
+
+TEST(ShardedMap, KeysSpreadOverShards)
+{
+    Map* c = &SharedMap();
+    std::vector<int> PerShard(Map::shard_count);
+    for (int Key = 0; Key < 1000; ++Key)
+    {
+        ++PerShard[c->shard(Key)];
+    }
+    for (unsigned int i = 0; i < Map::shard_count; ++i)
+    {
+        EXPECT_LT(80, PerShard[i]);
+        EXPECT_GT(170, PerShard[i]);
+    }
+}
+
+TEST(ShardedMap, ShardsStartOnCacheLines)
+{
+    EXPECT_EQ(0u, CCC_ALIGNOF(Map) % 64);
+    EXPECT_EQ(0u, sizeof(Map) % 64);
+    // the lock and the map of a shard are padded to the next multiple of 64 bytes, not beyond
+    typedef ccc::PodHashMap<int, int, uint32_t, 8> SmallShard;
+    const std::size_t LockedSize = CCC_ALIGNOF(SmallShard) + sizeof(SmallShard);
+    EXPECT_EQ((LockedSize + 63) / 64 * 64, sizeof(ccc::ShardedMap<SmallShard, 1>));
+    EXPECT_EQ((LockedSize + 63) / 64 * 64 * 3, sizeof(ccc::ShardedMap<SmallShard, 3>));
+}
+
+TEST(ShardedMap, Batches)
+{
+    Map* c = &SharedMap();
+    // more elements than fit into one batch, including duplicates
+    std::vector<Map::value_type> Elements;
+    for (int i = 0; i < 300; ++i)
+    {
+        Map::value_type Value = { (i * 7) % 250, i };
+        Elements.push_back(Value);
+    }
+    EXPECT_EQ(250, c->insert_many(&Elements[0], Elements.size()));
+    EXPECT_EQ(250u, c->size());
+
+    std::vector<int> Keys;
+    for (int Key = -50; Key < 300; ++Key)
+    {
+        Keys.push_back(Key);
+    }
+    std::vector<int> Values(Keys.size(), -1);
+    bool Found[350];
+    EXPECT_EQ(250, c->find_many(&Keys[0], Keys.size(), &Values[0], Found));
+    for (std::size_t i = 0; i < Keys.size(); ++i)
+    {
+        const bool Contained = (Keys[i] >= 0) and (Keys[i] < 250);
+        ASSERT_EQ(Contained, Found[i]) << Keys[i];
+        if (Contained)
+        {
+            // the first element of a key was inserted
+            int First = 0;
+            while ((First * 7) % 250 != Keys[i])
+            {
+                ++First;
+            }
+            EXPECT_EQ(First, Values[i]) << Keys[i];
+        }
+        else
+        {
+            EXPECT_EQ(-1, Values[i]);
+        }
+    }
+    c->clear();
+    EXPECT_EQ(0u, c->size());
+}
+
+namespace
+{
+
+struct Worker
+{
+    Map* m_Map;
+    int m_Id;
+    int m_Mismatches;
+};
+
+static void* InsertAndFind(void* Argument)
+{
+    Worker& W = *static_cast<Worker*>(Argument);
+    std::vector<Map::value_type> Elements;
+    std::vector<int> Keys;
+    for (int i = 0; i < 400; ++i)
+    {
+        Map::value_type Value = { W.m_Id * 1000 + i, W.m_Id };
+        Elements.push_back(Value);
+        Keys.push_back(Value.first);
+    }
+    for (int Round = 0; Round < 20; ++Round)
+    {
+        W.m_Map->insert_many(&Elements[0], Elements.size());
+        std::vector<int> Values(Keys.size());
+        bool Found[400];
+        if (W.m_Map->find_many(&Keys[0], Keys.size(), &Values[0], Found) != 400)
+        {
+            ++W.m_Mismatches;
+        }
+        for (int i = 0; i < 400; i += 2)
+        {
+            W.m_Map->erase(Keys[i]);
+        }
+    }
+    return 0;
+}
+
+}
+
+TEST(ShardedMap, ConcurrentInsertFindErase)
+{
+    Map* c = &SharedMap();
+    pthread_t Threads[4];
+    Worker Workers[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        Worker W = { c, i, 0 };
+        Workers[i] = W;
+        ASSERT_EQ(0, pthread_create(&Threads[i], 0, InsertAndFind, &Workers[i]));
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        pthread_join(Threads[i], 0);
+        EXPECT_EQ(0, Workers[i].m_Mismatches);
+    }
+    EXPECT_EQ(4u * 200u, c->size());
+    for (int i = 0; i < 4; ++i)
+    {
+        int Value = -1;
+        EXPECT_TRUE(c->find(i * 1000 + 1, Value));
+        EXPECT_EQ(i, Value);
+        EXPECT_FALSE(c->find(i * 1000, Value));
+    }
+}
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <sstream>
+#include <string>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <ccc/shm.h>
+#include <ccc/consistent_deque.h>
+#include <ccc/consistent_vector.h>
+
+#include "gTest_Container.h"
+
+typedef ccc::ConsistentDeque<int, uint32_t, 100> SharedDeque;
+
+static std::string UniqueRegionName(const char* Suffix)
+{
+    std::ostringstream Name;
+    Name << "/ccctl_gtest_" << ::getpid() << "_" << Suffix;
+    return Name.str();
+}
+
+/**
+ * Removes the region when the test ends, also if an assertion failed.
+ */
+struct RegionGuard
+{
+    std::string m_Name;
+
+    explicit RegionGuard(const std::string& Name)
+            : m_Name(Name)
+    {
+    }
+
+    ~RegionGuard()
+    {
+        ccc::SharedContainer<SharedDeque>::remove(m_Name);
+    }
+};
+
+/**
+ * Container whose construction fails.
+ */
+struct UnconstructibleVector : ccc::ConsistentVector<int, uint32_t, 10>
+{
+    UnconstructibleVector()
+    {
+        throw std::runtime_error("UnconstructibleVector");
+    }
+};
+
+TEST(SharedMemory, FailedCreationRemovesRegion)
+{
+    const std::string Name = UniqueRegionName("unconstructible");
+    RegionGuard Guard(Name);
+    EXPECT_THROW(ccc::SharedContainer<UnconstructibleVector> Failed(Name, ccc::SharedMemoryMode::Create), std::runtime_error);
+    EXPECT_FALSE(ccc::SharedContainer<UnconstructibleVector>::remove(Name));
+    // the name is free again
+    ccc::SharedContainer<SharedDeque> Created(Name, ccc::SharedMemoryMode::Create);
+    EXPECT_EQ(0u, Created->size());
+}
+
+TEST(SharedMemory, ForkedProcessesExchangeDeque)
+{
+    const std::string Name = UniqueRegionName("deque");
+    RegionGuard Guard(Name);
+    ccc::SharedContainer<SharedDeque> Parent(Name, ccc::SharedMemoryMode::Create);
+    for (int i = 1; i <= 50; ++i)
+    {
+        Parent->push_back(i);
+    }
+
+    pid_t Child = ::fork();
+    ASSERT_LE(0, Child);
+    if (0 == Child)
+    {
+        // The child reads the values of the parent and answers with their squares. It must not
+        // return into the test framework, so it reports by its exit code.
+        int ExitCode = 0;
+        try
+        {
+            ccc::SharedContainer<SharedDeque> Attached(Name, ccc::SharedMemoryMode::Attach);
+            for (int i = 1; i <= 50; ++i)
+            {
+                if (Attached->front() != i)
+                {
+                    ExitCode = 2;
+                }
+                Attached->pop_front();
+                Attached->push_back(i * i);
+            }
+        }
+        catch (...)
+        {
+            ExitCode = 1;
+        }
+        ::_exit(ExitCode);
+    }
+
+    int Status = 0;
+    ASSERT_EQ(Child, ::waitpid(Child, &Status, 0));
+    ASSERT_TRUE(WIFEXITED(Status));
+    ASSERT_EQ(0, WEXITSTATUS(Status));
+    ASSERT_EQ(50, Parent->size());
+    for (int i = 1; i <= 50; ++i)
+    {
+        EXPECT_EQ(i * i, (*Parent)[i - 1]);
+    }
+}
+
+TEST(SharedMemory, HeaderDescribesContainer)
+{
+    const std::string Name = UniqueRegionName("header");
+    RegionGuard Guard(Name);
+    ccc::SharedContainer<SharedDeque> Region(Name, ccc::SharedMemoryMode::Create);
+    const ccc::LayoutHeader& Header = Region.header().m_Layout;
+    EXPECT_EQ(CCC_LAYOUT_VERSION, Header.m_LayoutVersion);
+    EXPECT_EQ(sizeof(uint32_t), Header.m_SizeTypeSize);
+    EXPECT_EQ(sizeof(SharedDeque), Header.m_ContainerSize);
+    EXPECT_EQ(sizeof(int), Header.m_ValueSize);
+    EXPECT_EQ(100, Header.m_Capacity);
+    EXPECT_EQ(0, Header.m_PayloadOffset % 64);
+    EXPECT_TRUE(Region->empty());
+}
+
+TEST(SharedMemory, RejectsMismatchingLayout)
+{
+    const std::string Name = UniqueRegionName("mismatch");
+    RegionGuard Guard(Name);
+    ccc::SharedContainer<SharedDeque> Region(Name, ccc::SharedMemoryMode::Create);
+    EXPECT_THROW(ccc::SharedContainer<SharedDeque>(Name, ccc::SharedMemoryMode::Create), std::runtime_error);
+
+    typedef ccc::ConsistentDeque<int, uint64_t, 100> WiderSizeType;
+    typedef ccc::ConsistentDeque<int, uint32_t, 101> OtherCapacity;
+    typedef ccc::ConsistentDeque<double, uint32_t, 100> OtherValueType;
+    typedef ccc::ConsistentVector<int, uint32_t, 100> OtherContainer;
+    EXPECT_THROW(ccc::SharedContainer<WiderSizeType>(Name, ccc::SharedMemoryMode::Attach), std::runtime_error);
+    EXPECT_THROW(ccc::SharedContainer<OtherCapacity>(Name, ccc::SharedMemoryMode::Attach), std::runtime_error);
+    EXPECT_THROW(ccc::SharedContainer<OtherValueType>(Name, ccc::SharedMemoryMode::Attach), std::runtime_error);
+    EXPECT_THROW(ccc::SharedContainer<OtherContainer>(Name, ccc::SharedMemoryMode::Attach), std::runtime_error);
+    EXPECT_NO_THROW(ccc::SharedContainer<SharedDeque>(Name, ccc::SharedMemoryMode::Attach));
+
+    ccc::SharedContainer<SharedDeque>::remove(Name);
+    EXPECT_THROW(ccc::SharedContainer<SharedDeque>(Name, ccc::SharedMemoryMode::Attach), std::runtime_error);
+}
+
+#endif
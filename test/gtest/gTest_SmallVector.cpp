@@ -0,0 +1,133 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#include <vector>
+
+#include <ccc/small_vector.h>
+
+#include "gTest_Container.h"
+#include "gTest_SequenceContainer.h"
+#include <ccc/test/consistent_types.h>
+
+typedef ccc::SmallVector<int, 4, uint16_t> ContainerOfInts;
+typedef ccc::SmallVector<tPOD, 4, uint16_t> ContainerOfPODs;
+typedef ccc::SmallVector<cNoPOD, 4, uint16_t> ContainerOfNonPODs;
+
+typedef ::testing::Types<ContainerOfInts, ContainerOfPODs, ContainerOfNonPODs> ContainerImplementations;
+INSTANTIATE_TYPED_TEST_CASE_P(SmallVector, TestOfContainer, ContainerImplementations);
+INSTANTIATE_TYPED_TEST_CASE_P(SmallVector, TestOfRegularContainer, ContainerImplementations);
+
+typedef ::testing::Types<
+        // spilling to the free store:
+        RefPair<ccc::SmallVector<int, 2, uint16_t>, std::vector<int> >,
+        RefPair<ccc::SmallVector<tPOD, 4, uint16_t>, std::vector<tPOD> >,
+        RefPair<ccc::SmallVector<cNoPOD, 4, uint16_t>, std::vector<cNoPOD> >,
+        RefPair<ccc::SmallVector<ccc_test::Pod<1, 1>, 1, uint8_t, 1>, std::vector<ccc_test::Pod<1, 1> > >,
+        RefPair<ccc::SmallVector<ccc_test::Pod<8, 8>, 4, uint8_t, 8>, std::vector<ccc_test::Pod<8, 8> > >,
+        RefPair<ccc::SmallVector<ccc_test::Pod<8, 8>, 4, uint8_t, 8, true>, std::vector<ccc_test::Pod<8, 8> > >,
+        // staying in the static storage:
+        RefPair<ccc::SmallVector<int, 16, uint16_t>, std::vector<int> >,
+        RefPair<ccc::SmallVector<cNoPOD, 16, uint16_t>, std::vector<cNoPOD> >
+> RefPairTypes;
+INSTANTIATE_TYPED_TEST_CASE_P(SmallVector, TestOfSequenceContainer, RefPairTypes);
+
+TEST(SmallVector, Spill)
+{
+    typedef ccc::SmallVector<int, 3, uint16_t> Container;
+    Container c;
+    EXPECT_TRUE(c.is_small());
+    EXPECT_EQ(3, c.capacity());
+    for (int i = 0; i < 3; ++i)
+    {
+        c.push_back(i);
+    }
+    EXPECT_TRUE(c.is_small());
+    EXPECT_EQ(3, c.capacity());
+    c.push_back(3);
+    EXPECT_FALSE(c.is_small());
+    EXPECT_EQ(6, c.capacity());
+    for (int i = 4; i < 100; ++i)
+    {
+        c.push_back(i);
+    }
+    EXPECT_EQ(100, c.size());
+    EXPECT_EQ(192, c.capacity());
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(i, c[i]);
+    }
+    c.erase(c.begin() + 2, c.end());
+    c.shrink_to_fit();
+    EXPECT_TRUE(c.is_small());
+    EXPECT_EQ(2, c.size());
+    EXPECT_EQ(0, c[0]);
+    EXPECT_EQ(1, c[1]);
+}
+
+TEST(SmallVector, PushBackOwnElement)
+{
+    typedef ccc::SmallVector<int, 2, uint16_t> Container;
+    Container c;
+    c.push_back(7);
+    c.push_back(8);
+    c.push_back(c.front()); // spills while referring to the static storage
+    c.insert(c.begin(), c.back());
+    EXPECT_EQ(4, c.size());
+    EXPECT_EQ(7, c[0]);
+    EXPECT_EQ(7, c[1]);
+    EXPECT_EQ(8, c[2]);
+    EXPECT_EQ(7, c[3]);
+}
+
+TEST(SmallVector, Swap)
+{
+    typedef ccc::SmallVector<int, 2, uint16_t> Container;
+    Container Small;
+    Container Large;
+    Small.push_back(1);
+    for (int i = 0; i < 5; ++i)
+    {
+        Large.push_back(i);
+    }
+    Small.swap(Large);
+    EXPECT_EQ(5, Small.size());
+    EXPECT_EQ(1, Large.size());
+    EXPECT_EQ(4, Small.back());
+    EXPECT_EQ(1, Large.front());
+}
+
+TEST(SmallVector, DestroyElements)
+{
+    typedef cUniqueID<false> U;
+    U::NextID = 0;
+    U::CurrentIDs = std::set<uint64_t>();
+    typedef ccc::SmallVector<U, 2, uint64_t> Container;
+    {
+        Container c;
+        EXPECT_EQ(0, U::CurrentIDs.size());
+        c.push_back(U());
+        c.push_back(U());
+        EXPECT_EQ(2, U::CurrentIDs.size()) << PrintContent(U::CurrentIDs);
+        c.push_back(U());
+        c.push_back(U());
+        c.push_back(U());
+        EXPECT_EQ(5, U::CurrentIDs.size()) << PrintContent(U::CurrentIDs);
+        c.erase(c.begin(), c.begin() + 2);
+        EXPECT_EQ(3, U::CurrentIDs.size()) << PrintContent(U::CurrentIDs);
+        c.resize(1);
+        c.shrink_to_fit();
+        EXPECT_EQ(1, U::CurrentIDs.size()) << PrintContent(U::CurrentIDs);
+    }
+    EXPECT_TRUE(U::CurrentIDs.empty()) << PrintContent(U::CurrentIDs);
+}
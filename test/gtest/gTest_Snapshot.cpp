@@ -0,0 +1,209 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdlib>
+#include <string>
+
+#include <unistd.h>
+
+#include <ccc/snapshot.h>
+#include <ccc/dynamic_array.h>
+#include <ccc/fixed_array.h>
+#include <ccc/fixed_flat_map.h>
+#include <ccc/fixed_hash_map.h>
+#include <ccc/fixed_object_pool.h>
+#include <ccc/fixed_slot_map.h>
+#include <ccc/fixed_timing_wheel.h>
+#include <ccc/pod_array.h>
+#include <ccc/pod_vector.h>
+#include <ccc/pod_deque.h>
+#include <ccc/pod_list.h>
+#include <ccc/small_vector.h>
+#include <ccc/static_vector.h>
+
+#include "gTest_Container.h"
+
+/**
+ * Temporary file, which is removed when the test ends.
+ */
+struct TemporaryFile
+{
+    std::string m_Path;
+    int m_Fd;
+
+    TemporaryFile()
+    {
+        char Path[] = "/tmp/ccctl_snapshot_XXXXXX";
+        m_Fd = ::mkstemp(Path);
+        m_Path = Path;
+    }
+
+    ~TemporaryFile()
+    {
+        ::close(m_Fd);
+        ::unlink(m_Path.c_str());
+    }
+
+    void rewind()
+    {
+        ::lseek(m_Fd, 0, SEEK_SET);
+    }
+};
+
+typedef ccc::PodVector<tPOD, uint32_t, 100> VectorOfPODs;
+typedef ccc::PodDeque<int, uint16_t, 20> DequeOfInts;
+typedef ccc::PodList<int, uint64_t, 50> ListOfInts;
+
+TEST(Snapshot, SaveAndLoadPodVector)
+{
+    TemporaryFile File;
+    ASSERT_LE(0, File.m_Fd);
+    VectorOfPODs Source = VectorOfPODs();
+    for (int i = 0; i < 70; ++i)
+    {
+        tPOD Value = { i, 0.5 * i };
+        Source.push_back(Value);
+    }
+    ccc::save_snapshot(File.m_Fd, Source);
+    File.rewind();
+    VectorOfPODs Destination = VectorOfPODs();
+    ccc::load_snapshot(File.m_Fd, Destination);
+    ASSERT_EQ(Source.size(), Destination.size());
+    EXPECT_TRUE(std::equal(Source.begin(), Source.end(), Destination.begin()));
+}
+
+TEST(Snapshot, MapDequeAndList)
+{
+    TemporaryFile DequeFile;
+    TemporaryFile ListFile;
+    DequeOfInts Deque = DequeOfInts();
+    ListOfInts List = ListOfInts();
+    for (int i = 0; i < 35; ++i)
+    {
+        // wrap the ring buffer of the deque and reuse freed list nodes
+        if (Deque.size() == Deque.max_size())
+        {
+            Deque.pop_front();
+        }
+        Deque.push_back(i);
+        List.push_front(i);
+        if (i % 3 == 0)
+        {
+            List.pop_back();
+        }
+    }
+    ccc::save_snapshot(DequeFile.m_Fd, Deque);
+    ccc::save_snapshot(ListFile.m_Fd, List);
+
+    ccc::MappedSnapshot<DequeOfInts> MappedDeque(DequeFile.m_Path);
+    ccc::MappedSnapshot<ListOfInts> MappedList(ListFile.m_Path);
+    ASSERT_EQ(Deque.size(), MappedDeque->size());
+    EXPECT_TRUE(std::equal(Deque.begin(), Deque.end(), MappedDeque->begin()));
+    ASSERT_EQ(List.size(), MappedList->size());
+    EXPECT_TRUE(std::equal(List.begin(), List.end(), MappedList->begin()));
+    EXPECT_EQ(20, MappedDeque.header().m_Capacity);
+}
+
+TEST(Snapshot, RejectsMismatchingLayout)
+{
+    TemporaryFile File;
+    VectorOfPODs Source = VectorOfPODs();
+    ccc::save_snapshot(File.m_Fd, Source);
+
+    typedef ccc::PodVector<tPOD, uint64_t, 100> WiderSizeType;
+    typedef ccc::PodVector<tPOD, uint32_t, 99> OtherCapacity;
+    EXPECT_THROW(ccc::MappedSnapshot<WiderSizeType> Mapped(File.m_Path), std::runtime_error);
+    EXPECT_THROW(ccc::MappedSnapshot<OtherCapacity> Mapped(File.m_Path), std::runtime_error);
+    EXPECT_THROW(ccc::MappedSnapshot<DequeOfInts> Mapped(File.m_Path), std::runtime_error);
+    File.rewind();
+    OtherCapacity Destination = OtherCapacity();
+    EXPECT_THROW(ccc::load_snapshot(File.m_Fd, Destination), std::runtime_error);
+    EXPECT_THROW(ccc::MappedSnapshot<VectorOfPODs> Mapped("/nonexistent/ccctl_snapshot"), std::runtime_error);
+}
+
+TEST(Snapshot, FixedContainers)
+{
+    TemporaryFile File;
+    ccc::FixedVector<int, unsigned int> Vector(40);
+    ccc::FixedDeque<double, unsigned int> Deque(30);
+    ccc::FixedList<tPOD, unsigned int> List(20);
+    for (int i = 0; i < 40; ++i)
+    {
+        Vector.push_back(i);
+        if (Deque.size() == Deque.max_size())
+        {
+            Deque.pop_front();
+        }
+        Deque.push_back(i * 0.25);
+        tPOD Value = { i, 1.0 * i };
+        if (List.size() == List.max_size())
+        {
+            List.pop_back();
+        }
+        List.push_front(Value);
+    }
+    ccc::save_snapshot(File.m_Fd, Vector);
+    ccc::save_snapshot(File.m_Fd, Deque);
+    ccc::save_snapshot(File.m_Fd, List);
+    File.rewind();
+
+    ccc::FixedVector<int, unsigned int> LoadedVector(40);
+    ccc::FixedDeque<double, unsigned int> LoadedDeque(30);
+    ccc::FixedList<tPOD, unsigned int> LoadedList(20);
+    ccc::load_snapshot(File.m_Fd, LoadedVector);
+    ccc::load_snapshot(File.m_Fd, LoadedDeque);
+    ccc::load_snapshot(File.m_Fd, LoadedList);
+    ASSERT_EQ(Vector.size(), LoadedVector.size());
+    EXPECT_TRUE(std::equal(Vector.begin(), Vector.end(), LoadedVector.begin()));
+    ASSERT_EQ(Deque.size(), LoadedDeque.size());
+    EXPECT_TRUE(std::equal(Deque.begin(), Deque.end(), LoadedDeque.begin()));
+    ASSERT_EQ(List.size(), LoadedList.size());
+    EXPECT_TRUE(std::equal(List.begin(), List.end(), LoadedList.begin()));
+    // the restored list keeps working
+    LoadedList.pop_back();
+    tPOD Value = { -1, -1.0 };
+    LoadedList.push_back(Value);
+    EXPECT_EQ(-1, LoadedList.back().x);
+
+    File.rewind();
+    ccc::FixedVector<int, unsigned int> SmallerVector(39);
+    EXPECT_THROW(ccc::load_snapshot(File.m_Fd, SmallerVector), std::runtime_error);
+}
+
+TEST(Snapshot, OnlyContainersWithStaticStorageAreAccepted)
+{
+    // the raw bytes of these containers are the whole container
+    EXPECT_TRUE(+ccc::layout_traits<VectorOfPODs>::static_storage);
+    EXPECT_TRUE(+ccc::layout_traits<DequeOfInts>::static_storage);
+    EXPECT_TRUE(+ccc::layout_traits<ListOfInts>::static_storage);
+    EXPECT_TRUE((+ccc::layout_traits<ccc::StaticVector<int, uint32_t, 10> >::static_storage));
+    EXPECT_TRUE((+ccc::layout_traits<ccc::PODArray<int, uint32_t, 10> >::static_storage));
+
+    // these allocate their storage, so save_snapshot, load_snapshot and MappedSnapshot do not compile for them
+    EXPECT_FALSE((+ccc::layout_traits<ccc::PODArray<int, uint32_t, 10, 8, false, false> >::static_storage));
+    EXPECT_FALSE((+ccc::layout_traits<ccc::PodVector<int, uint32_t, 0, 8, false, false, true> >::static_storage));
+    EXPECT_FALSE((+ccc::layout_traits<ccc::FixedVector<int> >::static_storage));
+    EXPECT_FALSE((+ccc::layout_traits<ccc::FixedFlatMap<int, int> >::static_storage));
+    EXPECT_FALSE((+ccc::layout_traits<ccc::FixedHashMap<int, int> >::static_storage));
+    EXPECT_FALSE((+ccc::layout_traits<ccc::FixedSlotMap<int> >::static_storage));
+    EXPECT_FALSE((+ccc::layout_traits<ccc::FixedTimingWheel<int> >::static_storage));
+    EXPECT_FALSE((+ccc::layout_traits<ccc::FixedObjectPool<int> >::static_storage));
+    EXPECT_FALSE((+ccc::layout_traits<ccc::SmallVector<int, 4> >::static_storage));
+    EXPECT_FALSE((+ccc::layout_traits<ccc::FixedArray<int> >::static_storage));
+    EXPECT_FALSE((+ccc::layout_traits<ccc::DynamicArray<int> >::static_storage));
+}
+
+#endif
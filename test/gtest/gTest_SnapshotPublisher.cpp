@@ -0,0 +1,216 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include <pthread.h>
+
+#include <ccc/pod_vector.h>
+#include <ccc/snapshot_publisher.h>
+#include <ccc/static_vector.h>
+
+#include "gTest_Container.h"
+
+namespace
+{
+
+typedef ccc::StaticVector<int, uint32_t, 1000> Table;
+
+/**
+ * Keeps the invariant that element i holds Generation + i.
+ */
+struct Regenerate
+{
+    int m_Generation;
+    uint32_t m_Size;
+
+    Regenerate(int Generation, uint32_t Size)
+            : m_Generation(Generation), m_Size(Size)
+    {
+    }
+
+    void operator()(Table& Values) const
+    {
+        Values.clear();
+        for (uint32_t i = 0; i < m_Size; ++i)
+        {
+            Values.push_back(m_Generation + static_cast<int>(i));
+        }
+    }
+};
+
+struct Insert
+{
+    int m_Value;
+
+    explicit Insert(int Value)
+            : m_Value(Value)
+    {
+    }
+
+    void operator()(Table& Values) const
+    {
+        Values.insert(Values.begin(), m_Value);
+    }
+};
+
+struct Collect
+{
+    std::vector<int>* m_Out;
+
+    void operator()(const Table& Values) const
+    {
+        m_Out->assign(Values.begin(), Values.end());
+    }
+};
+
+}
+
+TEST(SnapshotPublisher, WritesAreAppliedToBothCopies)
+{
+    ccc::SnapshotPublisher<Table> Publisher;
+    EXPECT_EQ(0, Publisher.epoch());
+    EXPECT_EQ(1, Publisher.write(Insert(1)));
+    EXPECT_EQ(2, Publisher.write(Insert(2)));
+    EXPECT_EQ(3, Publisher.write(Insert(3)));
+    EXPECT_EQ(3, Publisher.epoch());
+
+    std::vector<int> Values;
+    Collect Reader = { &Values };
+    Publisher.read(Reader);
+    ASSERT_EQ(3, Values.size());
+    EXPECT_EQ(3, Values[0]);
+    EXPECT_EQ(1, Values[2]);
+
+    ccc::SnapshotPublisher<Table>::ReadView View(Publisher);
+    EXPECT_EQ(3, View->size());
+    EXPECT_EQ(3, View.epoch());
+}
+
+namespace
+{
+
+typedef ccc::PodVector<int, uint32_t, 16> PodTable;
+
+struct AppendSize
+{
+    void operator()(PodTable& Values) const
+    {
+        Values.push_back(static_cast<int>(Values.size()));
+    }
+};
+
+}
+
+TEST(SnapshotPublisher, CopiesOfAPodVectorStartEmpty)
+{
+    typedef ccc::SnapshotPublisher<PodTable> Publisher;
+    union
+    {
+        uint64_t m_Align;
+        char m_Bytes[sizeof(Publisher)];
+    } Memory;
+    std::memset(Memory.m_Bytes, 0x5a, sizeof(Memory.m_Bytes));
+    Publisher* Tables = new (Memory.m_Bytes) Publisher();
+    {
+        Publisher::ReadView View(*Tables);
+        EXPECT_TRUE(View->empty());
+    }
+
+    // each write publishes the other copy, so two writes show both to the reader
+    Tables->write(AppendSize());
+    {
+        Publisher::ReadView View(*Tables);
+        ASSERT_EQ(1, View->size());
+        EXPECT_EQ(0, (*View)[0]);
+    }
+    Tables->write(AppendSize());
+    {
+        Publisher::ReadView View(*Tables);
+        ASSERT_EQ(2, View->size());
+        EXPECT_EQ(0, (*View)[0]);
+        EXPECT_EQ(1, (*View)[1]);
+    }
+    Tables->~Publisher();
+}
+
+namespace
+{
+
+struct SharedState
+{
+    ccc::SnapshotPublisher<Table> m_Publisher;
+    volatile int m_Stop;
+    volatile int m_Violations;
+    volatile int m_Reads;
+};
+
+static void* ReadContinuously(void* Argument)
+{
+    SharedState& State = *static_cast<SharedState*>(Argument);
+    while (0 == ccc::atomic_load(State.m_Stop))
+    {
+        ccc::SnapshotPublisher<Table>::ReadView View(State.m_Publisher);
+        const Table& Values = *View;
+        for (uint32_t i = 1; i < Values.size(); ++i)
+        {
+            if (Values[i] != Values[0] + static_cast<int>(i))
+            {
+                ccc::atomic_fetch_add(State.m_Violations, 1);
+                break;
+            }
+        }
+        ccc::atomic_fetch_add(State.m_Reads, 1);
+    }
+    return 0;
+}
+
+}
+
+TEST(SnapshotPublisher, ReadersNeverSeePartialWrites)
+{
+    SharedState* State = new SharedState();
+    State->m_Stop = 0;
+    State->m_Violations = 0;
+    State->m_Reads = 0;
+    State->m_Publisher.write(Regenerate(0, 500));
+
+    pthread_t Readers[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(0, pthread_create(&Readers[i], 0, ReadContinuously, State));
+    }
+    for (int Generation = 1; Generation <= 300; ++Generation)
+    {
+        State->m_Publisher.write(Regenerate(Generation * 7, 100 + static_cast<uint32_t>(Generation % 900)));
+    }
+    for (unsigned int Iteration = 0; ccc::atomic_load(State->m_Reads) < 100; ++Iteration)
+    {
+        ccc::spin_wait(Iteration);
+    }
+    ccc::atomic_store(State->m_Stop, 1);
+    for (int i = 0; i < 3; ++i)
+    {
+        pthread_join(Readers[i], 0);
+    }
+    EXPECT_EQ(0, State->m_Violations);
+    EXPECT_EQ(301, State->m_Publisher.epoch());
+    delete State;
+}
+
+#endif
@@ -0,0 +1,194 @@
+/**
+ *
+ * @file
+ *
+ * @author Frank Dierkes
+ *
+ * $LastChangedBy$
+ * $Date$
+ * $Revision$
+ *
+ * @remarks
+ *
+ */
+
+#include <vector>
+
+#include <ccc/wire_format.h>
+#include <ccc/static_vector.h>
+#include <ccc/static_deque.h>
+#include <ccc/static_list.h>
+#include <ccc/fixed_vector.h>
+#include <ccc/fixed_deque.h>
+#include <ccc/fixed_list.h>
+#include <ccc/fixed_flat_map.h>
+
+#include "gTest_Container.h"
+
+namespace ccc
+{
+
+/**
+ * tPOD is padded in memory, so it takes the element-wise path.
+ */
+template <>
+struct wire_traits<tPOD>
+{
+    static const std::size_t size = 12;
+    static const bool is_raw = false;
+
+    static void encode(const tPOD& Value, unsigned char* Out)
+    {
+        wire_traits<int>::encode(Value.x, Out);
+        wire_traits<double>::encode(Value.y, Out + 4);
+    }
+
+    static void decode(const unsigned char* In, tPOD& Value)
+    {
+        wire_traits<int>::decode(In, Value.x);
+        wire_traits<double>::decode(In + 4, Value.y);
+    }
+};
+
+}
+
+template <class Container>
+std::vector<char> SerializePortable(const Container& C)
+{
+    std::vector<char> Buffer(ccc::portable_serialized_size(C));
+    EXPECT_EQ(&Buffer[0] + Buffer.size(), ccc::serialize_portable(C, &Buffer[0]));
+    return Buffer;
+}
+
+template <class Container>
+const char* DeserializePortable(Container& C, const std::vector<char>& Buffer)
+{
+    return ccc::deserialize_portable(C, &Buffer[0], &Buffer[0] + Buffer.size());
+}
+
+TEST(WireFormat, EncodingIsLittleEndianWithFixedWidths)
+{
+    ccc::StaticVector<long, uint8_t, 4> Vector;
+    Vector.push_back(0x0102030405060708L);
+    Vector.push_back(-2);
+    std::vector<char> Buffer = SerializePortable(Vector);
+
+    const unsigned char Expected[] = { 2, 0, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, // count, value size
+            8, 7, 6, 5, 4, 3, 2, 1, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+    ASSERT_EQ(sizeof(Expected), Buffer.size());
+    EXPECT_EQ(0, std::memcmp(Expected, &Buffer[0], sizeof(Expected)));
+}
+
+TEST(WireFormat, SequencesRoundTripAcrossSizeTypes)
+{
+    ccc::StaticVector<int, uint8_t, 200> Vector;
+    for (int i = 0; i < 150; ++i)
+    {
+        Vector.push_back(i - 75);
+    }
+    ccc::FixedVector<int, uint64_t, 16> WideVector(150);
+    DeserializePortable(WideVector, SerializePortable(Vector));
+    EXPECT_EQ(std::vector<int>(Vector.begin(), Vector.end()), std::vector<int>(WideVector.begin(), WideVector.end()));
+
+    ccc::StaticDeque<tPOD, uint16_t, 8> Deque;
+    for (int i = 0; i < 14; ++i)
+    {
+        if (Deque.size() == Deque.max_size())
+        {
+            Deque.pop_front();
+        }
+        tPOD Value = { i, -i * 0.25 };
+        Deque.push_back(Value);
+    }
+    std::vector<char> Buffer = SerializePortable(Deque);
+    EXPECT_EQ(ccc::portable_header_size + 8 * 12, Buffer.size());
+    ccc::FixedDeque<tPOD, unsigned long> OtherDeque(10);
+    DeserializePortable(OtherDeque, Buffer);
+    ASSERT_EQ(8, OtherDeque.size());
+    for (unsigned int i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(Deque[i].x, OtherDeque[i].x);
+        EXPECT_EQ(Deque[i].y, OtherDeque[i].y);
+    }
+
+    ccc::StaticList<double, uint64_t, 10> List;
+    for (int i = 0; i < 6; ++i)
+    {
+        List.push_front(i * 1.5);
+    }
+    List.pop_back();
+    ccc::FixedList<double, uint16_t> OtherList(5);
+    DeserializePortable(OtherList, SerializePortable(List));
+    EXPECT_EQ(std::vector<double>(List.begin(), List.end()), std::vector<double>(OtherList.begin(), OtherList.end()));
+}
+
+TEST(WireFormat, ArrayRoundTrip)
+{
+    ccc::PODArray<short, uint32_t, 5> Array;
+    for (unsigned int i = 0; i < Array.size(); ++i)
+    {
+        Array[i] = static_cast<short>(-100 * i);
+    }
+    ccc::PODArray<short, uint8_t, 5, 16> OtherArray;
+    std::vector<char> Buffer = SerializePortable(Array);
+    DeserializePortable(OtherArray, Buffer);
+    for (unsigned int i = 0; i < Array.size(); ++i)
+    {
+        EXPECT_EQ(Array[i], OtherArray[i]);
+    }
+    ccc::PODArray<short, uint32_t, 6> LargerArray;
+    EXPECT_THROW(DeserializePortable(LargerArray, Buffer), std::runtime_error);
+}
+
+TEST(WireFormat, MapsRoundTripAndRebuildTheirLayout)
+{
+    typedef ccc::PodFlatMap<int, tPOD, uint16_t, 50> Map;
+    typedef ccc::FixedFlatMap<int, tPOD, uint64_t, std::less<int>, 8, true> EytzingerMap;
+    Map Source;
+    Source.clear();
+    for (int i = 0; i < 40; ++i)
+    {
+        tPOD Value = { i, i * 2.0 };
+        Map::value_type Element = { i * 7 % 41, Value };
+        Source.insert(Element);
+    }
+    std::vector<char> Buffer = SerializePortable(Source);
+    EXPECT_EQ(ccc::portable_header_size + 40 * (4 + 12), Buffer.size());
+
+    EytzingerMap Target(64);
+    DeserializePortable(Target, Buffer);
+    ASSERT_EQ(40, Target.size());
+    for (int i = 0; i < 40; ++i)
+    {
+        ASSERT_TRUE(Target.find(i * 7 % 41) != Target.end());
+        EXPECT_EQ(i, Target.find(i * 7 % 41)->second.x);
+    }
+
+    ccc::PodFlatSet<unsigned int, uint8_t, 10> Set;
+    Set.clear();
+    Set.insert(3);
+    Set.insert(1);
+    Buffer = SerializePortable(Set);
+    std::swap(Buffer[ccc::portable_header_size], Buffer[ccc::portable_header_size + 4]); // 3, 1
+    ccc::PodFlatSet<unsigned int, uint32_t, 10> OtherSet;
+    OtherSet.clear();
+    EXPECT_THROW(DeserializePortable(OtherSet, Buffer), std::runtime_error);
+    EXPECT_TRUE(OtherSet.empty());
+}
+
+TEST(WireFormat, RejectsInvalidInput)
+{
+    ccc::StaticVector<unsigned char, uint32_t, 10> Bytes;
+    Bytes.push_back(1);
+    Bytes.push_back(2);
+    std::vector<char> Buffer = SerializePortable(Bytes);
+
+    ccc::StaticVector<bool, uint32_t, 10> Flags;
+    EXPECT_THROW(DeserializePortable(Flags, Buffer), std::runtime_error); // 2 is not a bool
+    ccc::StaticVector<unsigned char, uint32_t, 1> Small;
+    EXPECT_THROW(DeserializePortable(Small, Buffer), std::bad_alloc);
+    ccc::StaticVector<short, uint32_t, 10> Shorts;
+    EXPECT_THROW(DeserializePortable(Shorts, Buffer), std::runtime_error);
+    Buffer.pop_back();
+    EXPECT_THROW(DeserializePortable(Bytes, Buffer), std::runtime_error);
+}
@@ -0,0 +1,136 @@
+/*
+ * allocation_hooks.h
+ *
+ *  Replaces the global operator new and delete by versions that report to the counters of
+ *  ccc/stats.h. Replacement functions must be defined exactly once per program, so include this
+ *  header from exactly one translation unit of each test or benchmark executable.
+ *
+ *  Each block carries its size in a header of 16 bytes in front of it, so that the unsized operator
+ *  delete can report the freed bytes. The over-aligned variants of C++17 are not replaced; they keep
+ *  allocating uncounted.
+ */
+
+#ifndef CCC_TEST_ALLOCATION_HOOKS_H_
+#define CCC_TEST_ALLOCATION_HOOKS_H_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include <ccc/stats.h>
+
+namespace ccc_test
+{
+
+static const std::size_t AllocationHeaderSize = 16;
+
+inline void* CountedAllocate(std::size_t Size)
+{
+    void* Block = std::malloc(Size + AllocationHeaderSize);
+    if (0 == Block)
+    {
+        return 0;
+    }
+    *static_cast<std::size_t*>(Block) = Size;
+    ccc::stats::record_allocation(Size);
+    return static_cast<char*>(Block) + AllocationHeaderSize;
+}
+
+inline void CountedDeallocate(void* Pointer)
+{
+    if (0 == Pointer)
+    {
+        return;
+    }
+    void* Block = static_cast<char*>(Pointer) - AllocationHeaderSize;
+    ccc::stats::record_deallocation(*static_cast<std::size_t*>(Block));
+    std::free(Block);
+}
+
+inline void* CountedAllocateOrThrow(std::size_t Size)
+{
+    void* Pointer = CountedAllocate(Size);
+    if (0 == Pointer)
+    {
+        throw std::bad_alloc();
+    }
+    return Pointer;
+}
+
+struct AllocationHooksInstaller
+{
+    AllocationHooksInstaller()
+    {
+        ccc::stats::allocation_counters().m_HooksInstalled = 1;
+    }
+};
+
+static AllocationHooksInstaller InstallAllocationHooks;
+
+}
+
+// the exception specifications have to match the declarations of <new>
+#if __cplusplus >= 201103L
+#define CCC_TEST_THROWS_BAD_ALLOC
+#define CCC_TEST_NOTHROW noexcept
+#else
+#define CCC_TEST_THROWS_BAD_ALLOC throw(std::bad_alloc)
+#define CCC_TEST_NOTHROW throw()
+#endif
+
+void* operator new(std::size_t Size) CCC_TEST_THROWS_BAD_ALLOC
+{
+    return ccc_test::CountedAllocateOrThrow(Size);
+}
+
+void* operator new[](std::size_t Size) CCC_TEST_THROWS_BAD_ALLOC
+{
+    return ccc_test::CountedAllocateOrThrow(Size);
+}
+
+void* operator new(std::size_t Size, const std::nothrow_t&) CCC_TEST_NOTHROW
+{
+    return ccc_test::CountedAllocate(Size);
+}
+
+void* operator new[](std::size_t Size, const std::nothrow_t&) CCC_TEST_NOTHROW
+{
+    return ccc_test::CountedAllocate(Size);
+}
+
+void operator delete(void* Pointer) CCC_TEST_NOTHROW
+{
+    ccc_test::CountedDeallocate(Pointer);
+}
+
+void operator delete[](void* Pointer) CCC_TEST_NOTHROW
+{
+    ccc_test::CountedDeallocate(Pointer);
+}
+
+void operator delete(void* Pointer, const std::nothrow_t&) CCC_TEST_NOTHROW
+{
+    ccc_test::CountedDeallocate(Pointer);
+}
+
+void operator delete[](void* Pointer, const std::nothrow_t&) CCC_TEST_NOTHROW
+{
+    ccc_test::CountedDeallocate(Pointer);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* Pointer, std::size_t) CCC_TEST_NOTHROW
+{
+    ccc_test::CountedDeallocate(Pointer);
+}
+
+void operator delete[](void* Pointer, std::size_t) CCC_TEST_NOTHROW
+{
+    ccc_test::CountedDeallocate(Pointer);
+}
+#endif
+
+#undef CCC_TEST_THROWS_BAD_ALLOC
+#undef CCC_TEST_NOTHROW
+
+#endif /* CCC_TEST_ALLOCATION_HOOKS_H_ */
@@ -0,0 +1,373 @@
+/*
+ * container_benchmarks.h
+ *
+ *  Benchmark templates shared by the per-family container benchmarks in test/gbenchmark, on top of
+ *  the element types and factories of container_factories.h. Each benchmark fills a container with state.range(0) elements and reports
+ *  items per second, so that containers of different families can be compared directly.
+ *
+ *  The benchmarks also report the allocations and allocated bytes per iteration of their measured
+ *  loop and, if CCC_BENCHMARK_PERF_COUNTERS is set, the hardware events per item (see
+ *  perf_counters.h). This header installs the counting operator new and delete of
+ *  allocation_hooks.h, so it must be included by exactly one translation unit of a benchmark
+ *  executable.
+ */
+
+#ifndef CCC_TEST_CONTAINER_BENCHMARKS_H_
+#define CCC_TEST_CONTAINER_BENCHMARKS_H_
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include <ccc/iterator.h>
+#include <ccc/stats.h>
+#include <ccc/test/allocation_hooks.h>
+#include <ccc/test/container_factories.h>
+#include <ccc/test/latency_histogram.h>
+#include <ccc/test/perf_counters.h>
+
+namespace ccc_test
+{
+
+/**
+ * Upper bound of the memory of a single container, so that the largest element counts are only
+ * registered for small elements.
+ */
+static const std::size_t MaxBenchmarkBytes = std::size_t(64) << 20;
+
+/**
+ * Registers the element counts 16, 256, 4096, 65536 and 2^20 that fit into MaxBenchmarkBytes.
+ */
+template <unsigned int Bytes>
+void ElementCounts(benchmark::internal::Benchmark* Benchmark)
+{
+    for (std::size_t Count = 16; Count <= (std::size_t(1) << 20); Count *= 16)
+    {
+        if (Count * Bytes <= MaxBenchmarkBytes)
+        {
+            Benchmark->Arg(static_cast<int>(Count));
+        }
+    }
+}
+
+/**
+ * Registers a single element count, for containers whose capacity is a template argument.
+ */
+template <std::size_t Count>
+void ElementCount(benchmark::internal::Benchmark* Benchmark)
+{
+    Benchmark->Arg(static_cast<int>(Count));
+}
+
+/**
+ * Sets the counters allocs/iter and bytes/iter to the given totals, averaged over the iterations.
+ */
+inline void ReportAllocations(benchmark::State& state, double Allocations, double Bytes)
+{
+    state.counters["allocs/iter"] = benchmark::Counter(Allocations, benchmark::Counter::kAvgIterations);
+    state.counters["bytes/iter"] = benchmark::Counter(Bytes, benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * Sets a counter <event>/item for each hardware event that was counted.
+ */
+inline void ReportPerfCounters(benchmark::State& state, const PerfCounters& Counters, double Items)
+{
+    for (int i = 0; i < PerfEventCount; ++i)
+    {
+        const PerfEvent Event = static_cast<PerfEvent>(i);
+        if (Counters.valid(Event) and (Items > 0))
+        {
+            state.counters[std::string(perf_event_name(Event)) + "/item"] = static_cast<double>(Counters.count(Event)) / Items;
+        }
+    }
+}
+
+/**
+ * Sets the counters p50_ns, p99_ns, p999_ns and max_ns to the percentiles of Histogram (in ticks of
+ * CycleClock) and timer_ns to the overhead of a timestamp pair, which every sample includes.
+ */
+inline void ReportLatencies(benchmark::State& state, const LatencyHistogram& Histogram)
+{
+    const double NanosecondsPerTick = CycleClock::nanoseconds_per_tick();
+    state.counters["p50_ns"] = NanosecondsPerTick * Histogram.percentile(50.0);
+    state.counters["p99_ns"] = NanosecondsPerTick * Histogram.percentile(99.0);
+    state.counters["p999_ns"] = NanosecondsPerTick * Histogram.percentile(99.9);
+    state.counters["max_ns"] = NanosecondsPerTick * Histogram.max();
+    state.counters["timer_ns"] = NanosecondsPerTick * CycleClock::timer_overhead();
+}
+
+/**
+ * @brief Allocations and hardware events of a benchmark loop, from construction to report().
+ *
+ * Construct it right before the loop; the events then include the loop overhead of gbenchmark, which
+ * is small compared to the items of an iteration. Sections excluded from the timing with
+ * PauseTiming() and ResumeTiming() are excluded from the counts with pause() and resume().
+ */
+class LoopCounters
+{
+public:
+    LoopCounters()
+            : m_PausedAllocations(0),
+              m_PausedBytes(0),
+              m_PauseAllocations(0),
+              m_PauseBytes(0)
+    {
+        m_Events.start();
+    }
+
+    void pause()
+    {
+        m_Events.pause();
+        const ccc::stats::AllocationCounters& Counters = ccc::stats::allocation_counters();
+        m_PauseAllocations = Counters.m_Allocations;
+        m_PauseBytes = Counters.m_AllocatedBytes;
+    }
+
+    void resume()
+    {
+        const ccc::stats::AllocationCounters& Counters = ccc::stats::allocation_counters();
+        m_PausedAllocations += Counters.m_Allocations - m_PauseAllocations;
+        m_PausedBytes += Counters.m_AllocatedBytes - m_PauseBytes;
+        m_Events.resume();
+    }
+
+    /**
+     * Stops counting and reports the counts, the hardware events divided by Items.
+     */
+    void report(benchmark::State& state, double Items)
+    {
+        m_Events.stop();
+        // read both before the counters map allocates its nodes
+        const double Allocations = static_cast<double>(m_Allocations.allocations() - m_PausedAllocations);
+        const double Bytes = static_cast<double>(m_Allocations.allocated_bytes() - m_PausedBytes);
+        ReportAllocations(state, Allocations, Bytes);
+        ReportPerfCounters(state, m_Events, Items);
+    }
+
+private:
+    ccc::stats::AllocationScope m_Allocations;
+    uint64_t m_PausedAllocations;
+    uint64_t m_PausedBytes;
+    uint64_t m_PauseAllocations;
+    uint64_t m_PauseBytes;
+    PerfCounters m_Events;
+};
+
+// Sequence containers:
+
+template <class Container>
+void BM_PushBackPopBack(benchmark::State& state)
+{
+    typedef typename Container::value_type value_type;
+    const std::size_t Count = state.range(0);
+    Container* c = Factory<Container>::Create(Count);
+    const value_type Value = MakeValue<value_type>(1);
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            c->push_back(Value);
+        }
+        benchmark::DoNotOptimize(c->back());
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            c->pop_back();
+        }
+    }
+    Counters.report(state, state.iterations() * Count);
+    state.SetItemsProcessed(state.iterations() * Count);
+    delete c;
+}
+
+template <class Container>
+void BM_PushFrontPopFront(benchmark::State& state)
+{
+    typedef typename Container::value_type value_type;
+    const std::size_t Count = state.range(0);
+    Container* c = Factory<Container>::Create(Count);
+    const value_type Value = MakeValue<value_type>(1);
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            c->push_front(Value);
+        }
+        benchmark::DoNotOptimize(c->front());
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            c->pop_front();
+        }
+    }
+    Counters.report(state, state.iterations() * Count);
+    state.SetItemsProcessed(state.iterations() * Count);
+    delete c;
+}
+
+/**
+ * Inserts a single element at Numerator / 2 of the size and erases it again, so the size stays
+ * state.range(0) - 1. Finding the position is part of the measurement (linear for lists).
+ */
+template <class Container, int Numerator>
+void BM_InsertErase(benchmark::State& state)
+{
+    typedef typename Container::value_type value_type;
+    const std::size_t Count = state.range(0);
+    Container* c = CreateFilled<Container>(Count, Count - 1);
+    const std::ptrdiff_t Offset = static_cast<std::ptrdiff_t>((Count - 1) * Numerator / 2);
+    const value_type Value = MakeValue<value_type>(1);
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        typename Container::iterator Position = c->insert(ccc::next(c->begin(), Offset), Value);
+        benchmark::DoNotOptimize(*Position);
+        c->erase(Position);
+    }
+    Counters.report(state, state.iterations());
+    state.SetItemsProcessed(state.iterations());
+    delete c;
+}
+
+template <class Container>
+void BM_InsertEraseFront(benchmark::State& state)
+{
+    BM_InsertErase<Container, 0>(state);
+}
+
+template <class Container>
+void BM_InsertEraseMiddle(benchmark::State& state)
+{
+    BM_InsertErase<Container, 1>(state);
+}
+
+template <class Container>
+void BM_InsertEraseBack(benchmark::State& state)
+{
+    BM_InsertErase<Container, 2>(state);
+}
+
+template <class Container>
+void BM_Iterate(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Container* c = CreateFilled<Container>(Count, Count);
+    const Container& Values = *c;
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        uint32_t Sum = 0;
+        for (typename Container::const_iterator it = Values.begin(); it != Values.end(); ++it)
+        {
+            Sum += it->m_Key;
+        }
+        benchmark::DoNotOptimize(Sum);
+    }
+    Counters.report(state, state.iterations() * Count);
+    state.SetItemsProcessed(state.iterations() * Count);
+    delete c;
+}
+
+template <class Container>
+void BM_RandomAccess(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Container* c = CreateFilled<Container>(Count, Count);
+    std::vector<uint32_t> Indices(1024);
+    uint32_t Random = 42;
+    for (std::size_t i = 0; i < Indices.size(); ++i)
+    {
+        Random = Random * 1664525u + 1013904223u;
+        Indices[i] = (Random >> 8) % Count;
+    }
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        uint32_t Sum = 0;
+        for (std::size_t i = 0; i < Indices.size(); ++i)
+        {
+            Sum += (*c)[Indices[i]].m_Key;
+        }
+        benchmark::DoNotOptimize(Sum);
+    }
+    Counters.report(state, state.iterations() * Indices.size());
+    state.SetItemsProcessed(state.iterations() * Indices.size());
+    delete c;
+}
+
+/**
+ * Copy assignment to a container of the same capacity. Note that containers with static storage may
+ * copy their whole capacity.
+ */
+template <class Container>
+void BM_Copy(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Container* Source = CreateFilled<Container>(Count, Count);
+    Container* Destination = Factory<Container>::Create(Count);
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        *Destination = *Source;
+        benchmark::DoNotOptimize(Destination->back());
+    }
+    Counters.report(state, state.iterations() * Count);
+    state.SetItemsProcessed(state.iterations() * Count);
+    delete Destination;
+    delete Source;
+}
+
+template <class Container>
+void BM_Swap(benchmark::State& state)
+{
+    const std::size_t Count = state.range(0);
+    Container* a = CreateFilled<Container>(Count, Count);
+    Container* b = CreateFilled<Container>(Count, Count / 2);
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        a->swap(*b);
+        benchmark::DoNotOptimize(a->back());
+    }
+    Counters.report(state, state.iterations());
+    state.SetItemsProcessed(state.iterations());
+    delete b;
+    delete a;
+}
+
+/**
+ * Only clear() is timed and counted; refilling is not (pausing the timer costs far more than
+ * clearing short containers, so small counts are dominated by that overhead).
+ */
+template <class Container>
+void BM_Clear(benchmark::State& state)
+{
+    typedef typename Container::value_type value_type;
+    const std::size_t Count = state.range(0);
+    Container* c = Factory<Container>::Create(Count);
+    LoopCounters Counters;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        Counters.pause();
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            c->push_back(MakeValue<value_type>(static_cast<uint32_t>(i)));
+        }
+        Counters.resume();
+        state.ResumeTiming();
+        c->clear();
+        benchmark::DoNotOptimize(c->size());
+    }
+    Counters.report(state, state.iterations() * Count);
+    state.SetItemsProcessed(state.iterations() * Count);
+    delete c;
+}
+
+}
+
+#endif /* CCC_TEST_CONTAINER_BENCHMARKS_H_ */
@@ -0,0 +1,185 @@
+/*
+ * container_factories.h
+ *
+ *  Element types of configurable size and factories creating containers of a given capacity, shared
+ *  by the container benchmarks of all frameworks.
+ */
+
+#ifndef CCC_TEST_CONTAINER_FACTORIES_H_
+#define CCC_TEST_CONTAINER_FACTORIES_H_
+
+#include <cstddef>
+#include <cstring>
+#include <map>
+#if __cplusplus >= 201103L
+#include <unordered_map>
+#endif
+#include <vector>
+#include <stdint.h>
+
+#include <ccc/fixed_vector.h>
+#include <ccc/fixed_deque.h>
+#include <ccc/fixed_list.h>
+#include <ccc/fixed_flat_map.h>
+#include <ccc/fixed_hash_map.h>
+
+namespace ccc_test
+{
+
+/**
+ * Element of Bytes bytes, of which the first four hold a key.
+ */
+template <unsigned int Bytes>
+struct Payload
+{
+    uint32_t m_Key;
+    char m_Data[Bytes - sizeof(uint32_t)];
+};
+
+template <>
+struct Payload<4>
+{
+    uint32_t m_Key;
+};
+
+template <class T>
+T MakeValue(uint32_t Key)
+{
+    T Value;
+    std::memset(&Value, 0, sizeof(Value));
+    Value.m_Key = Key;
+    return Value;
+}
+
+/**
+ * Creates an empty container on the heap with room for at least Capacity elements. Containers with
+ * static storage ignore Capacity.
+ */
+template <class Container>
+struct Factory
+{
+    static Container* Create(std::size_t)
+    {
+        return new Container();
+    }
+};
+
+template <class T>
+struct Factory<std::vector<T> >
+{
+    static std::vector<T>* Create(std::size_t Capacity)
+    {
+        std::vector<T>* Result = new std::vector<T>();
+        Result->reserve(Capacity);
+        return Result;
+    }
+};
+
+template <class T, class SizeType, unsigned int Alignment, bool UseRawMemOps>
+struct Factory<ccc::FixedVector<T, SizeType, Alignment, UseRawMemOps> >
+{
+    static ccc::FixedVector<T, SizeType, Alignment, UseRawMemOps>* Create(std::size_t Capacity)
+    {
+        return new ccc::FixedVector<T, SizeType, Alignment, UseRawMemOps>(static_cast<SizeType>(Capacity));
+    }
+};
+
+template <class T, class SizeType, unsigned int Alignment, bool UseRawMemOps>
+struct Factory<ccc::FixedDeque<T, SizeType, Alignment, UseRawMemOps> >
+{
+    static ccc::FixedDeque<T, SizeType, Alignment, UseRawMemOps>* Create(std::size_t Capacity)
+    {
+        return new ccc::FixedDeque<T, SizeType, Alignment, UseRawMemOps>(static_cast<SizeType>(Capacity));
+    }
+};
+
+template <class T, class SizeType, unsigned int Alignment>
+struct Factory<ccc::FixedList<T, SizeType, Alignment> >
+{
+    static ccc::FixedList<T, SizeType, Alignment>* Create(std::size_t Capacity)
+    {
+        return new ccc::FixedList<T, SizeType, Alignment>(static_cast<SizeType>(Capacity));
+    }
+};
+
+template <class Container>
+Container* CreateFilled(std::size_t Capacity, std::size_t Count)
+{
+    typedef typename Container::value_type value_type;
+    Container* Result = Factory<Container>::Create(Capacity);
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        Result->push_back(MakeValue<value_type>(static_cast<uint32_t>(i)));
+    }
+    return Result;
+}
+
+// entries of the ccc maps are aggregates
+template <class Map>
+struct PodEntry
+{
+    static typename Map::value_type MakeEntry(uint32_t Key)
+    {
+        typename Map::value_type Entry;
+        Entry.first = Key;
+        Entry.second = MakeValue<typename Map::mapped_type>(Key);
+        return Entry;
+    }
+};
+
+/**
+ * Creates an empty map on the heap with room for at least Count elements and creates its entries.
+ */
+template <class Map>
+struct MapTraits : public PodEntry<Map>
+{
+    static Map* Create(std::size_t Count)
+    {
+        return new Map(static_cast<typename Map::size_type>(Count));
+    }
+};
+
+template <class K, class T, class Compare>
+struct MapTraits<std::map<K, T, Compare> >
+{
+    static std::map<K, T, Compare>* Create(std::size_t)
+    {
+        return new std::map<K, T, Compare>();
+    }
+
+    static typename std::map<K, T, Compare>::value_type MakeEntry(uint32_t Key)
+    {
+        return typename std::map<K, T, Compare>::value_type(Key, MakeValue<T>(Key));
+    }
+};
+
+#if __cplusplus >= 201103L
+template <class K, class T>
+struct MapTraits<std::unordered_map<K, T> >
+{
+    static std::unordered_map<K, T>* Create(std::size_t Count)
+    {
+        std::unordered_map<K, T>* Result = new std::unordered_map<K, T>();
+        Result->reserve(Count);
+        return Result;
+    }
+
+    static typename std::unordered_map<K, T>::value_type MakeEntry(uint32_t Key)
+    {
+        return typename std::unordered_map<K, T>::value_type(Key, MakeValue<T>(Key));
+    }
+};
+#endif
+
+template <class K, class T, class SizeType>
+struct MapTraits<ccc::FixedHashMap<K, T, SizeType> > : public PodEntry<ccc::FixedHashMap<K, T, SizeType> >
+{
+    static ccc::FixedHashMap<K, T, SizeType>* Create(std::size_t Count)
+    {
+        return new ccc::FixedHashMap<K, T, SizeType>(static_cast<SizeType>(Count + Count / 2));
+    }
+};
+
+}
+
+#endif /* CCC_TEST_CONTAINER_FACTORIES_H_ */
@@ -0,0 +1,264 @@
+/*
+ * perf_counters.h
+ *
+ *  Hardware performance counters of the calling thread for the benchmarks in test/gbenchmark, read
+ *  with perf_event_open on Linux. Counting is off unless the environment variable
+ *  CCC_BENCHMARK_PERF_COUNTERS is set to a value other than 0, and events the kernel or the
+ *  processor does not support (perf_event_paranoid > 2, virtual machines without a PMU, other
+ *  operating systems) are left out of the report, so the benchmarks run the same either way.
+ *
+ *  Only user space is counted, which perf_event_paranoid = 2 (the default of most distributions)
+ *  still permits.
+ */
+
+#ifndef CCC_TEST_PERF_COUNTERS_H_
+#define CCC_TEST_PERF_COUNTERS_H_
+
+#include <ciso646>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ccc_test
+{
+
+enum PerfEvent
+{
+    PerfCycles,
+    PerfInstructions,
+    PerfL1DMisses, // L1 data cache read misses
+    PerfLLCMisses, // last level cache misses
+    PerfBranchMisses,
+    PerfEventCount
+};
+
+/**
+ * Names of the events, used as gbenchmark counter names.
+ */
+inline const char* perf_event_name(PerfEvent Event)
+{
+    static const char* const Names[PerfEventCount] = { "cycles", "instructions", "L1D-misses", "LLC-misses", "branch-misses" };
+    return Names[Event];
+}
+
+inline bool perf_counters_requested()
+{
+    const char* Value = std::getenv("CCC_BENCHMARK_PERF_COUNTERS");
+    return (0 != Value) and (0 != std::strcmp(Value, "")) and (0 != std::strcmp(Value, "0"));
+}
+
+/**
+ * @brief The events of PerfEvent, counted between start() and stop().
+ *
+ * Each event is opened on its own rather than as a group, so that a processor lacking one event
+ * still reports the others. The counts are scaled by time_enabled / time_running in case the kernel
+ * had to multiplex the counters.
+ */
+class PerfCounters
+{
+public:
+    PerfCounters()
+    {
+        for (int i = 0; i < PerfEventCount; ++i)
+        {
+            m_Descriptors[i] = -1;
+            m_Counts[i] = 0;
+        }
+        if (perf_counters_requested())
+        {
+            for (int i = 0; i < PerfEventCount; ++i)
+            {
+                m_Descriptors[i] = Open(static_cast<PerfEvent>(i));
+            }
+            if (not available())
+            {
+                WarnOnce();
+            }
+        }
+    }
+
+    ~PerfCounters()
+    {
+#if defined(__linux__)
+        for (int i = 0; i < PerfEventCount; ++i)
+        {
+            if (m_Descriptors[i] >= 0)
+            {
+                close(m_Descriptors[i]);
+            }
+        }
+#endif
+    }
+
+    /**
+     * True if at least one event is counted.
+     */
+    bool available() const
+    {
+        for (int i = 0; i < PerfEventCount; ++i)
+        {
+            if (valid(static_cast<PerfEvent>(i)))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool valid(PerfEvent Event) const
+    {
+        return m_Descriptors[Event] >= 0;
+    }
+
+    void start()
+    {
+#if defined(__linux__)
+        for (int i = 0; i < PerfEventCount; ++i)
+        {
+            if (m_Descriptors[i] >= 0)
+            {
+                ioctl(m_Descriptors[i], PERF_EVENT_IOC_RESET, 0);
+                ioctl(m_Descriptors[i], PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    /**
+     * Suspends counting until resume(); the counts of stop() exclude the paused sections.
+     */
+    void pause()
+    {
+#if defined(__linux__)
+        for (int i = 0; i < PerfEventCount; ++i)
+        {
+            if (m_Descriptors[i] >= 0)
+            {
+                ioctl(m_Descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+#endif
+    }
+
+    void resume()
+    {
+#if defined(__linux__)
+        for (int i = 0; i < PerfEventCount; ++i)
+        {
+            if (m_Descriptors[i] >= 0)
+            {
+                ioctl(m_Descriptors[i], PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    void stop()
+    {
+#if defined(__linux__)
+        for (int i = 0; i < PerfEventCount; ++i)
+        {
+            if (m_Descriptors[i] >= 0)
+            {
+                ioctl(m_Descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        for (int i = 0; i < PerfEventCount; ++i)
+        {
+            if (m_Descriptors[i] >= 0)
+            {
+                uint64_t Values[3] = { 0, 0, 0 }; // value, time enabled, time running
+                if (read(m_Descriptors[i], Values, sizeof(Values)) != static_cast<ssize_t>(sizeof(Values)))
+                {
+                    m_Counts[i] = 0;
+                }
+                else if ((0 != Values[2]) and (Values[2] < Values[1]))
+                {
+                    m_Counts[i] = static_cast<uint64_t>(static_cast<double>(Values[0]) * Values[1] / Values[2]);
+                }
+                else
+                {
+                    m_Counts[i] = Values[0];
+                }
+            }
+        }
+#endif
+    }
+
+    uint64_t count(PerfEvent Event) const
+    {
+        return m_Counts[Event];
+    }
+
+private:
+    PerfCounters(PerfCounters const&);
+    void operator=(PerfCounters const&);
+
+    static int Open(PerfEvent Event)
+    {
+#if defined(__linux__)
+        perf_event_attr Attributes;
+        std::memset(&Attributes, 0, sizeof(Attributes));
+        Attributes.size = sizeof(Attributes);
+        Attributes.disabled = 1;
+        Attributes.exclude_kernel = 1;
+        Attributes.exclude_hv = 1;
+        Attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        switch (Event)
+        {
+        case PerfCycles:
+            Attributes.type = PERF_TYPE_HARDWARE;
+            Attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfInstructions:
+            Attributes.type = PERF_TYPE_HARDWARE;
+            Attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfL1DMisses:
+            Attributes.type = PERF_TYPE_HW_CACHE;
+            Attributes.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case PerfLLCMisses:
+            Attributes.type = PERF_TYPE_HARDWARE;
+            Attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case PerfBranchMisses:
+            Attributes.type = PERF_TYPE_HARDWARE;
+            Attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        default:
+            return -1;
+        }
+        // this thread, any CPU
+        return static_cast<int>(syscall(__NR_perf_event_open, &Attributes, 0, -1, -1, 0));
+#else
+        (void)Event;
+        return -1;
+#endif
+    }
+
+    static void WarnOnce()
+    {
+        static bool Warned = false;
+        if (not Warned)
+        {
+            Warned = true;
+            std::fprintf(stderr, "CCC_BENCHMARK_PERF_COUNTERS: perf_event_open failed, no hardware counters are reported\n");
+        }
+    }
+
+    int m_Descriptors[PerfEventCount];
+    uint64_t m_Counts[PerfEventCount];
+};
+
+}
+
+#endif /* CCC_TEST_PERF_COUNTERS_H_ */
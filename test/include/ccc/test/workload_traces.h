@@ -0,0 +1,423 @@
+/*
+ * workload_traces.h
+ *
+ *  Synthetic operation traces for the workload benchmarks: a limit order book (add, cancel,
+ *  execute), a timer service (schedule, cancel, expire) and a packet queue between a bursty producer
+ *  and a consumer. The traces are generated before the measurement from a seed and the parameters
+ *  of a configuration, so every implementation replays exactly the same operations.
+ *
+ *  Each trace comes with presets that the benchmarks select by index. The seed of all presets can
+ *  be overridden with the environment variable CCC_WORKLOAD_SEED.
+ */
+
+#ifndef CCC_TEST_WORKLOAD_TRACES_H_
+#define CCC_TEST_WORKLOAD_TRACES_H_
+
+#include <ciso646>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+namespace ccc_test
+{
+
+/**
+ * @brief xorshift64* generator with the draws the traces need.
+ */
+class WorkloadRandom
+{
+public:
+    explicit WorkloadRandom(uint64_t Seed)
+            : m_State((0 == Seed) ? 0x9E3779B97F4A7C15ull : Seed)
+    {
+    }
+
+    uint64_t next()
+    {
+        m_State ^= m_State >> 12;
+        m_State ^= m_State << 25;
+        m_State ^= m_State >> 27;
+        return m_State * 0x2545F4914F6CDD1Dull;
+    }
+
+    /**
+     * Uniform in [0, 1).
+     */
+    double uniform()
+    {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * Uniform in [0, Count).
+     */
+    uint32_t below(uint32_t Count)
+    {
+        return static_cast<uint32_t>((next() >> 32) * Count >> 32);
+    }
+
+    bool bernoulli(double Probability)
+    {
+        return uniform() < Probability;
+    }
+
+    /**
+     * Exponential distribution with the given mean.
+     */
+    double exponential(double Mean)
+    {
+        return -Mean * std::log(1.0 - uniform());
+    }
+
+    /**
+     * Number of failures before the first success, with the given mean (>= 0).
+     */
+    uint32_t geometric(double Mean)
+    {
+        if (Mean <= 0.0)
+        {
+            return 0;
+        }
+        const double Value = std::floor(std::log(1.0 - uniform()) / std::log(Mean / (1.0 + Mean)));
+        return (Value < 4294967295.0) ? static_cast<uint32_t>(Value) : 4294967295u;
+    }
+
+private:
+    uint64_t m_State;
+};
+
+/**
+ * Seed of the presets: CCC_WORKLOAD_SEED if set, otherwise 42.
+ */
+inline uint64_t workload_seed()
+{
+    const char* Value = std::getenv("CCC_WORKLOAD_SEED");
+    return ((0 != Value) and ('\0' != *Value)) ? std::strtoull(Value, 0, 0) : 42u;
+}
+
+/**
+ * @brief Set of live ids with removal and uniform selection in constant time.
+ */
+class LiveIds
+{
+public:
+    explicit LiveIds(uint32_t MaxId)
+            : m_Positions(MaxId, ~uint32_t(0))
+    {
+    }
+
+    uint32_t size() const
+    {
+        return static_cast<uint32_t>(m_Ids.size());
+    }
+
+    void insert(uint32_t Id)
+    {
+        m_Positions[Id] = size();
+        m_Ids.push_back(Id);
+    }
+
+    void erase(uint32_t Id)
+    {
+        const uint32_t Position = m_Positions[Id];
+        m_Ids[Position] = m_Ids.back();
+        m_Positions[m_Ids[Position]] = Position;
+        m_Ids.pop_back();
+        m_Positions[Id] = ~uint32_t(0);
+    }
+
+    uint32_t pick(WorkloadRandom& Random) const
+    {
+        return m_Ids[Random.below(size())];
+    }
+
+private:
+    std::vector<uint32_t> m_Ids;
+    std::vector<uint32_t> m_Positions;
+};
+
+// Limit order book:
+
+/**
+ * The mid price follows a random walk. New orders rest at a geometrically distributed distance from
+ * the touch, cancels pick a random order of the book, and executions are market orders against the
+ * best prices. At MaxOrders resting orders an add turns into a cancel, which keeps the book in a
+ * steady state.
+ */
+struct OrderBookConfig
+{
+    const char* m_Name;
+    uint64_t m_Seed;
+    uint32_t m_Operations;
+    uint32_t m_MaxOrders;
+    double m_AddShare;
+    double m_CancelShare; // the remainder executes
+    double m_DepthMean; // ticks between the touch and a new order
+    double m_ExecuteQuantityMean;
+    uint32_t m_MaxQuantity;
+    double m_MidMoveProbability; // per operation, by one tick up or down
+};
+
+enum OrderBookOperationType
+{
+    OrderAdd,
+    OrderCancel,
+    OrderExecute
+};
+
+enum OrderSide
+{
+    OrderBid,
+    OrderAsk
+};
+
+struct OrderBookOperation
+{
+    uint8_t m_Type;
+    uint8_t m_Side;
+    uint32_t m_Id; // add, cancel
+    int32_t m_Price; // add
+    uint32_t m_Quantity; // add, execute
+};
+
+inline OrderBookConfig order_book_preset(int Index)
+{
+    // name, seed, operations, max. orders, add, cancel, depth, execute quantity, max. quantity, mid move
+    static const OrderBookConfig Presets[] = {
+        { "liquid", 0, 200000, 2000, 0.50, 0.42, 2.0, 150.0, 100, 0.05 },
+        { "deep", 0, 200000, 50000, 0.50, 0.45, 50.0, 50.0, 100, 0.01 },
+    };
+    OrderBookConfig Config = Presets[Index];
+    Config.m_Seed = workload_seed();
+    return Config;
+}
+
+/**
+ * Ids of added orders are consecutive from 0. The generator does not match orders, so some cancels
+ * refer to orders that have been executed in the meantime and miss, as they do in practice.
+ */
+inline std::vector<OrderBookOperation> generate_order_book_trace(const OrderBookConfig& Config)
+{
+    WorkloadRandom Random(Config.m_Seed);
+    std::vector<OrderBookOperation> Trace(Config.m_Operations);
+    LiveIds Live(Config.m_Operations);
+    int32_t Mid = 1000000;
+    uint32_t NextId = 0;
+    for (uint32_t i = 0; i < Config.m_Operations; ++i)
+    {
+        if (Random.bernoulli(Config.m_MidMoveProbability))
+        {
+            Mid += Random.bernoulli(0.5) ? 1 : -1;
+        }
+        OrderBookOperation& Operation = Trace[i];
+        Operation.m_Side = Random.bernoulli(0.5) ? OrderBid : OrderAsk;
+        Operation.m_Id = 0;
+        Operation.m_Price = 0;
+        Operation.m_Quantity = 0;
+        const double Draw = Random.uniform();
+        if ((Draw < Config.m_AddShare) and (Live.size() < Config.m_MaxOrders))
+        {
+            const int32_t Distance = 1 + static_cast<int32_t>(Random.geometric(Config.m_DepthMean));
+            Operation.m_Type = OrderAdd;
+            Operation.m_Id = NextId++;
+            Operation.m_Price = (OrderBid == Operation.m_Side) ? Mid - Distance : Mid + Distance;
+            Operation.m_Quantity = 1 + Random.below(Config.m_MaxQuantity);
+            Live.insert(Operation.m_Id);
+        }
+        else if ((Draw < Config.m_AddShare + Config.m_CancelShare) or (Live.size() >= Config.m_MaxOrders))
+        {
+            if (0 == Live.size())
+            {
+                Operation.m_Type = OrderExecute;
+                Operation.m_Quantity = 1;
+                continue;
+            }
+            Operation.m_Type = OrderCancel;
+            Operation.m_Id = Live.pick(Random);
+            Live.erase(Operation.m_Id);
+        }
+        else
+        {
+            Operation.m_Type = OrderExecute;
+            Operation.m_Quantity = 1 + Random.geometric(Config.m_ExecuteQuantityMean);
+        }
+    }
+    return Trace;
+}
+
+// Timers:
+
+/**
+ * Most timers are short (exponential delays, e.g. request timeouts), a few long (e.g. session
+ * expiry), and a share of them is cancelled before it expires. Time advances by a geometrically
+ * distributed number of ticks. At MaxTimers pending timers a schedule turns into a cancel.
+ */
+struct TimerConfig
+{
+    const char* m_Name;
+    uint64_t m_Seed;
+    uint32_t m_Operations;
+    uint32_t m_MaxTimers;
+    double m_ScheduleShare;
+    double m_CancelShare; // the remainder advances
+    double m_ShortDelayMean;
+    double m_LongDelayShare;
+    uint32_t m_LongDelayMax;
+    double m_AdvanceMean;
+};
+
+enum TimerOperationType
+{
+    TimerSchedule,
+    TimerCancel,
+    TimerAdvance
+};
+
+struct TimerOperation
+{
+    uint32_t m_Type;
+    uint32_t m_Id; // schedule, cancel
+    uint64_t m_Ticks; // schedule: deadline, advance: new time
+};
+
+inline TimerConfig timer_preset(int Index)
+{
+    // name, seed, operations, max. timers, schedule, cancel, short delay, long share, long max., advance
+    static const TimerConfig Presets[] = {
+        { "rpc", 0, 200000, 100000, 0.45, 0.40, 200.0, 0.02, 100000, 1.0 },
+        { "timeouts", 0, 200000, 100000, 0.50, 0.10, 5000.0, 0.20, 1000000, 4.0 },
+    };
+    TimerConfig Config = Presets[Index];
+    Config.m_Seed = workload_seed();
+    return Config;
+}
+
+/**
+ * Ids of scheduled timers are consecutive from 0, deadlines and advances are absolute ticks.
+ * Cancels only refer to pending timers, so an implementation has to expire timers at the deadline
+ * (deadline <= now) for the trace to stay consistent.
+ */
+inline std::vector<TimerOperation> generate_timer_trace(const TimerConfig& Config)
+{
+    WorkloadRandom Random(Config.m_Seed);
+    std::vector<TimerOperation> Trace(Config.m_Operations);
+    LiveIds Live(Config.m_Operations);
+    std::vector<bool> Pending(Config.m_Operations, false);
+    typedef std::pair<uint64_t, uint32_t> Deadline;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline> > Deadlines; // cancelled ones included
+    uint64_t Now = 0;
+    uint32_t NextId = 0;
+    for (uint32_t i = 0; i < Config.m_Operations; ++i)
+    {
+        TimerOperation& Operation = Trace[i];
+        Operation.m_Id = 0;
+        Operation.m_Ticks = 0;
+        const double Draw = Random.uniform();
+        if ((Draw < Config.m_ScheduleShare) and (Live.size() < Config.m_MaxTimers))
+        {
+            const uint64_t Delay = Random.bernoulli(Config.m_LongDelayShare)
+                    ? 1 + Random.below(Config.m_LongDelayMax)
+                    : 1 + static_cast<uint64_t>(Random.exponential(Config.m_ShortDelayMean));
+            Operation.m_Type = TimerSchedule;
+            Operation.m_Id = NextId++;
+            Operation.m_Ticks = Now + Delay;
+            Deadlines.push(Deadline(Operation.m_Ticks, Operation.m_Id));
+            Pending[Operation.m_Id] = true;
+            Live.insert(Operation.m_Id);
+        }
+        else if ((Draw < Config.m_ScheduleShare + Config.m_CancelShare) and (0 != Live.size()))
+        {
+            Operation.m_Type = TimerCancel;
+            Operation.m_Id = Live.pick(Random);
+            Live.erase(Operation.m_Id);
+            Pending[Operation.m_Id] = false;
+        }
+        else
+        {
+            Now += 1 + Random.geometric(Config.m_AdvanceMean - 1.0);
+            Operation.m_Type = TimerAdvance;
+            Operation.m_Ticks = Now;
+            while ((not Deadlines.empty()) and (Deadlines.top().first <= Now))
+            {
+                const uint32_t Id = Deadlines.top().second;
+                Deadlines.pop();
+                if (Pending[Id])
+                {
+                    Live.erase(Id);
+                    Pending[Id] = false;
+                }
+            }
+        }
+    }
+    return Trace;
+}
+
+// Packet queue:
+
+/**
+ * A producer writes bursts of packets of geometrically distributed length, a consumer drains
+ * batches of geometrically distributed length. A full queue drops the packets that do not fit.
+ */
+struct PacketQueueConfig
+{
+    const char* m_Name;
+    uint64_t m_Seed;
+    uint32_t m_Operations;
+    uint32_t m_Capacity;
+    double m_ProduceShare; // the remainder consumes
+    double m_BurstMean;
+    double m_BatchMean;
+};
+
+enum PacketOperationType
+{
+    PacketProduce,
+    PacketConsume
+};
+
+struct PacketOperation
+{
+    uint32_t m_Type;
+    uint32_t m_Count;
+};
+
+inline PacketQueueConfig packet_queue_preset(int Index)
+{
+    // name, seed, operations, capacity, produce, burst, batch
+    static const PacketQueueConfig Presets[] = {
+        { "steady", 0, 200000, 4096, 0.50, 8.0, 8.0 },
+        { "bursty", 0, 200000, 16384, 0.10, 200.0, 20.0 },
+    };
+    PacketQueueConfig Config = Presets[Index];
+    Config.m_Seed = workload_seed();
+    return Config;
+}
+
+inline std::vector<PacketOperation> generate_packet_queue_trace(const PacketQueueConfig& Config)
+{
+    WorkloadRandom Random(Config.m_Seed);
+    std::vector<PacketOperation> Trace(Config.m_Operations);
+    for (uint32_t i = 0; i < Config.m_Operations; ++i)
+    {
+        PacketOperation& Operation = Trace[i];
+        if (Random.bernoulli(Config.m_ProduceShare))
+        {
+            Operation.m_Type = PacketProduce;
+            Operation.m_Count = 1 + Random.geometric(Config.m_BurstMean - 1.0);
+        }
+        else
+        {
+            Operation.m_Type = PacketConsume;
+            Operation.m_Count = 1 + Random.geometric(Config.m_BatchMean - 1.0);
+        }
+    }
+    return Trace;
+}
+
+}
+
+#endif /* CCC_TEST_WORKLOAD_TRACES_H_ */